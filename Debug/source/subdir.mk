@@ -4,6 +4,7 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../source/ans.c \
 ../source/cbfifo.c \
 ../source/cbfifo_test.c \
 ../source/commands.c \
@@ -11,12 +12,15 @@ C_SRCS += \
 ../source/huffman_test.c \
 ../source/main.c \
 ../source/mtb.c \
+../source/range.c \
 ../source/semihost_hardfault.c \
 ../source/sysclock.c \
 ../source/systick.c \
+../source/tokens.c \
 ../source/uart.c 
 
 OBJS += \
+./source/ans.o \
 ./source/cbfifo.o \
 ./source/cbfifo_test.o \
 ./source/commands.o \
@@ -24,12 +28,15 @@ OBJS += \
 ./source/huffman_test.o \
 ./source/main.o \
 ./source/mtb.o \
+./source/range.o \
 ./source/semihost_hardfault.o \
 ./source/sysclock.o \
 ./source/systick.o \
+./source/tokens.o \
 ./source/uart.o 
 
 C_DEPS += \
+./source/ans.d \
 ./source/cbfifo.d \
 ./source/cbfifo_test.d \
 ./source/commands.d \
@@ -37,9 +44,11 @@ C_DEPS += \
 ./source/huffman_test.d \
 ./source/main.d \
 ./source/mtb.d \
+./source/range.d \
 ./source/semihost_hardfault.d \
 ./source/sysclock.d \
 ./source/systick.d \
+./source/tokens.d \
 ./source/uart.d 
 
 
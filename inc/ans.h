@@ -0,0 +1,101 @@
+/**
+ * @file    :   ans.h
+ * @brief   :   An abstraction for tANS encoding and decoding functions
+ *
+ *              This header file provides functions which code messages with
+ * 				a table based asymmetric numeral system instead of the huffman
+ * 				codes, with the same static tables. A huffman code spends a
+ * 				whole number of bits on every character, tANS spends fractions
+ * 				of a bit, so it gets closer to the entropy of the tables.
+ *
+ * 				The trainer normalizes the frequencies of every table to
+ * 				ANS_STATES and generates the coding tables into lookup_table.h,
+ * 				nothing is built at runtime. The coder keeps a state between
+ * 				ANS_STATES and 2 * ANS_STATES. Encoding a character sends the
+ * 				low bits of the state and moves to the next state, decoding
+ * 				reads them back in reverse order. So a message is encoded
+ * 				from its last character to its first, and is always encoded
+ * 				and decoded whole.
+ *
+ * 				The message starts with the state the encoder ended with, then
+ * 				the bits of every character but the last, which decodes from
+ * 				the state alone. A byte with no code in the table is sent as
+ * 				the escape followed by its 8 bits, as with huffman.
+ *
+ * @author  :   Sanish Kharade
+ * @date    :   December 10, 2021
+ * @version :   1.0
+ *
+ * @tools   :   MCUXpresso IDE
+ *
+ * @link    :   -
+*/
+
+#ifndef ANS_H_
+#define ANS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "huffman.h"
+
+/* The coder has 2^ANS_TABLE_LOG states, must match lookup_table.h */
+#define ANS_TABLE_LOG		(9)
+#define ANS_STATES			(1 << ANS_TABLE_LOG)
+
+/*********************************************************************************
+ * @brief   :  	Encodes characters with the tANS coder of a static table
+ *
+ * 				At most HUFFMAN_ENCODED_SIZE(length) bytes are written
+ *
+ * @param   :   table	- ID of the table, below HUFFMAN_STATIC_TABLES
+ * 				data	- characters to encode
+ * 				length	- number of characters in data
+ * 				buffer	- buffer to fill with the encoded characters
+ * 				nbytes	- size of the buffer
+ * 				bits	- set to the number of encoded bits
+ *
+ * @return  : 	size_t	- number of bytes written to buffer, 0 if they do not fit
+**********************************************************************************/
+size_t ans_encode_table(uint8_t table, const uint8_t *data, size_t length,
+							uint8_t *buffer, size_t nbytes, uint32_t *bits);
+
+/*********************************************************************************
+ * @brief   :  	Decodes characters encoded by ans_encode_table
+ *
+ * @param   :   table			- ID of the table the characters were encoded with
+ * 				encoded_buffer	- encoded characters
+ * 				encoded_bytes	- number of bytes in encoded_buffer
+ * 				decoded_bytes	- number of characters to decode
+ * 				decoded_buffer	- buffer to be filled with the decoded characters
+ *
+ * @return  : 	uint16_t		- number of characters decoded, less than
+ * 								  decoded_bytes if the input is too short
+**********************************************************************************/
+uint16_t ans_decode_table(uint8_t table, const uint8_t encoded_buffer[], size_t encoded_bytes,
+							uint16_t decoded_bytes, uint8_t decoded_buffer[]);
+
+/*********************************************************************************
+ * @brief   :  	Encodes the message with the tANS coder of table 0
+ *
+ * @param   :   message	- message to be encoded
+ * 				buffer	- buffer to fill with encoded message
+ * 				nbytes	- size of the buffer
+ *
+ * @return  : 	int		- number of encoded bits
+**********************************************************************************/
+int ans_encode(const char *message, uint8_t *buffer, size_t nbytes);
+
+/*********************************************************************************
+ * @brief   :  	Decodes a message encoded by ans_encode and prints the string
+ *
+ * @param   :   encoded_buffer	- encoded buffer
+ * 				encoded_bytes	- number of bytes in the encoded buffer
+ * 				decoded_bytes	- number of original bytes
+ * 				decoded_buffer	- buffer to be filled with the decoded string
+ *
+ * @return  : 	void
+**********************************************************************************/
+void ans_decode(const uint8_t encoded_buffer[], uint16_t encoded_bytes,
+					uint16_t decoded_bytes, uint8_t decoded_buffer[]);
+
+#endif /* ANS_H_ */
@@ -0,0 +1,203 @@
+/**
+ * @file    :   bit_reader.h
+ * @brief   :   An abstraction for reading a bitstream
+ *
+ *              This header file provides functions which are used to read
+ * 				the encoded data one code at a time. The encoded data is never
+ * 				written, so it can be decoded straight from a receive buffer
+ * 				or ring and decoded again later.
+ *
+ * 				The functions are defined here as static inline since the
+ * 				decoder calls them for every symbol.
+ *
+ * @author  :   Sanish Kharade
+ * @date    :   December 10, 2021
+ * @version :   1.0
+ *
+ * @tools   :   MCUXpresso IDE
+ *
+ * @link    :   -
+*/
+
+#ifndef BIT_READER_H_
+#define BIT_READER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Bits are loaded into a register as wide as the machine word */
+#if UINTPTR_MAX > 0xFFFFFFFFu
+typedef uint64_t bit_buffer_t;
+#else
+typedef uint32_t bit_buffer_t;
+#endif
+
+/* Number of bits in the bit buffer */
+#define BIT_BUFFER_BITS		(8 * sizeof(bit_buffer_t))
+
+/*
+ * Most bits that can be peeked at once. After a refill at least this many
+ * bits are loaded, real or past the end of the input
+ */
+#define BIT_READER_MAX_PEEK	(BIT_BUFFER_BITS - 7)
+
+/*
+ * 	bit_reader_t is the state of a reader over one or two spans of bytes
+ * 	data		- span being read
+ * 	length		- number of bytes in data
+ * 	next		- span read after data, for input which wraps around a ring
+ * 	next_length	- number of bytes in next
+ * 	position	- index of the next byte to load from data
+ * 	buffer		- loaded bits, aligned to the msb
+ * 	count		- number of bits in buffer
+ * 	padding		- number of bits in buffer which were loaded past the end
+*/
+typedef struct
+{
+	const uint8_t *data;
+	size_t length;
+	const uint8_t *next;
+	size_t next_length;
+	size_t position;
+	bit_buffer_t buffer;
+	uint8_t count;
+	uint8_t padding;
+} bit_reader_t;
+
+/*********************************************************************************
+ * @brief   :  	Starts reading bytes which may wrap around a ring
+ *
+ * @param   :   reader		- bit reader
+ * 				data		- first span of the input
+ * 				length		- number of bytes in data
+ * 				next		- second span of the input, NULL if none
+ * 				next_length	- number of bytes in next
+ *
+ * @return  : 	void
+**********************************************************************************/
+static inline void bit_reader_init_ring(bit_reader_t *reader, const uint8_t *data, size_t length,
+											const uint8_t *next, size_t next_length)
+{
+	reader->data = data;
+	reader->length = length;
+	reader->next = next;
+	reader->next_length = (next != NULL) ? next_length : 0;
+	reader->position = 0;
+	reader->buffer = 0;
+	reader->count = 0;
+	reader->padding = 0;
+}
+
+/*********************************************************************************
+ * @brief   :  	Starts reading a buffer
+ *
+ * @param   :   reader	- bit reader
+ * 				data	- encoded data
+ * 				length	- number of bytes in data
+ *
+ * @return  : 	void
+**********************************************************************************/
+static inline void bit_reader_init(bit_reader_t *reader, const uint8_t *data, size_t length)
+{
+	bit_reader_init_ring(reader, data, length, NULL, 0);
+}
+
+/*********************************************************************************
+ * @brief   :  	Loads whole bytes until the bit buffer is full
+ *
+ * 				Bits past the end of the input read as 0
+ *
+ * @param   :   reader	- bit reader
+ *
+ * @return  : 	void
+**********************************************************************************/
+static inline void bit_reader_refill(bit_reader_t *reader)
+{
+	/* Padding which was already consumed is no longer in the buffer */
+	if (reader->padding > reader->count)
+		reader->padding = reader->count;
+
+	while (reader->count <= BIT_BUFFER_BITS - 8)
+	{
+		uint8_t byte = 0;
+
+		/* Move on to the second span once the first one is used up */
+		if (reader->position == reader->length && reader->next_length > 0)
+		{
+			reader->data = reader->next;
+			reader->length = reader->next_length;
+			reader->next = NULL;
+			reader->next_length = 0;
+			reader->position = 0;
+		}
+
+		if (reader->position < reader->length)
+			byte = reader->data[reader->position++];
+		else
+			reader->padding += 8;
+
+		reader->buffer |= (bit_buffer_t)byte << (BIT_BUFFER_BITS - 8 - reader->count);
+		reader->count += 8;
+	}
+}
+
+/*********************************************************************************
+ * @brief   :  	Returns the next bits without consuming them
+ *
+ * @param   :   reader	- bit reader, refilled since the last consume
+ * 				bits	- number of bits, 1 to BIT_READER_MAX_PEEK
+ *
+ * @return  : 	uint32_t	- the bits, aligned to the lsb
+**********************************************************************************/
+static inline uint32_t bit_reader_peek(const bit_reader_t *reader, uint8_t bits)
+{
+	return (uint32_t)(reader->buffer >> (BIT_BUFFER_BITS - bits));
+}
+
+/*********************************************************************************
+ * @brief   :  	Consumes bits which were peeked
+ *
+ * @param   :   reader	- bit reader
+ * 				bits	- number of bits, at most the number of loaded bits
+ *
+ * @return  : 	void
+**********************************************************************************/
+static inline void bit_reader_consume(bit_reader_t *reader, uint8_t bits)
+{
+	reader->buffer <<= bits;
+	reader->count -= bits;
+}
+
+/*********************************************************************************
+ * @brief   :  	Reads and consumes the next bits
+ *
+ * @param   :   reader	- bit reader
+ * 				bits	- number of bits, 1 to BIT_READER_MAX_PEEK
+ *
+ * @return  : 	uint32_t	- the bits, aligned to the lsb
+**********************************************************************************/
+static inline uint32_t bit_reader_read(bit_reader_t *reader, uint8_t bits)
+{
+	bit_reader_refill(reader);
+	uint32_t value = bit_reader_peek(reader, bits);
+	bit_reader_consume(reader, bits);
+	return value;
+}
+
+/*********************************************************************************
+ * @brief   :  	Returns the number of bits of the input not consumed yet
+ *
+ * @param   :   reader	- bit reader
+ *
+ * @return  : 	size_t	- number of bits, negative results are clamped to 0
+**********************************************************************************/
+static inline size_t bit_reader_bits_left(const bit_reader_t *reader)
+{
+	size_t bytes = (reader->length - reader->position) + reader->next_length;
+
+	if (reader->count < reader->padding)
+		return 0;
+	return 8 * bytes + reader->count - reader->padding;
+}
+
+#endif /* BIT_READER_H_ */
@@ -100,4 +100,32 @@ size_t cbfifo_length(cbfifo_handle_t cbf_handle);
 *********************************************************************************/
 size_t cbfifo_capacity(cbfifo_handle_t cbf_handle);
 
+/*********************************************************************************
+ * @brief   :   Returns the bytes at the front of the FIFO which are next
+ *              to each other in memory
+ *
+ *              The bytes stay on the FIFO until cbfifo_release removes them,
+ *              so a DMA channel can send them from where they are. The span
+ *              ends where the FIFO wraps around, the bytes after the wrap
+ *              are the next span.
+ *
+ * @param   :   cbf_handle 	handle of cbfifo
+ * 				span	- set to the first byte of the span
+ *
+ * @return  :   size_t  - number of bytes in the span, 0 if the FIFO is empty
+ *
+*********************************************************************************/
+size_t cbfifo_span(cbfifo_handle_t cbf_handle, const void **span);
+
+/*********************************************************************************
+ * @brief   :   Removes bytes from the front of the FIFO without copying them
+ *
+ * @param   :   cbf_handle 	handle of cbfifo
+ *              nbyte   - number of bytes to remove, at most the length
+ *
+ * @return  :   size_t  - number of bytes removed
+ *
+*********************************************************************************/
+size_t cbfifo_release(cbfifo_handle_t cbf_handle, size_t nbyte);
+
 #endif // _CBFIFO_H_
@@ -17,6 +17,9 @@
 #ifndef COMMANDS_H_
 #define COMMANDS_H_
 
+/* Sent by the PC at a new baud rate to check the link, 0x55 alternates its bits */
+#define BAUD_CHECK_CHAR		('U')
+
 /*********************************************************************************
  * @brief   :   Function to process user input
  *
@@ -69,6 +72,54 @@ void handle_reset(int argc, char *argv[]);
 *********************************************************************************/
 void handle_stats(int argc, char *argv[]);
 
+/*********************************************************************************
+ * @brief   :   Function to handle the mode command
+ *
+ * @param   :   argc  	- Number of arguments
+ * 				argv	- Array of arguments
+ *
+ * @return  :   void
+*********************************************************************************/
+void handle_mode(int argc, char *argv[]);
+
+/*********************************************************************************
+ * @brief   :   Function to handle the bench command
+ *
+ * @param   :   argc  	- Number of arguments
+ * 				argv	- Array of arguments
+ *
+ * @return  :   void
+*********************************************************************************/
+void handle_bench(int argc, char *argv[]);
+
+/*********************************************************************************
+ * @brief   :   Function to handle the batch command
+ *
+ * 				Sets how many bytes of writes are gathered into one message
+ * 				and how long the first of them may wait
+ *
+ * @param   :   argc  	- Number of arguments
+ * 				argv	- Array of arguments
+ *
+ * @return  :   void
+*********************************************************************************/
+void handle_batch(int argc, char *argv[]);
+
+/*********************************************************************************
+ * @brief   :   Function to handle the baud command
+ *
+ * 				Acknowledges the rate at the old one and switches to it. The
+ * 				PC switches once it reads the acknowledgement and sends
+ * 				BAUD_CHECK_CHAR, which is answered at the new rate. If it
+ * 				does not come the old rate is set back
+ *
+ * @param   :   argc  	- Number of arguments
+ * 				argv	- Array of arguments
+ *
+ * @return  :   void
+*********************************************************************************/
+void handle_baud(int argc, char *argv[]);
+
 /*********************************************************************************
  * @brief   :   Function to process the command received from the user
  *
@@ -0,0 +1,60 @@
+#ifndef FLASH_STRINGS_H_
+#define FLASH_STRINGS_H_
+
+#include <stdint.h>
+#include "lookup_table.h"
+
+/* The strings are encoded with the tables of this lookup_table.h */
+#if HUFFMAN_TABLES_HASH != 0xF841BF93UL
+#error "flash_strings.h was encoded with other tables, regenerate it"
+#endif
+
+/* ID of every string */
+#define FLASH_STRING_HELP (0)
+#define FLASH_STRING_COUNT (1)
+
+#ifdef FLASH_STRINGS_DATA
+
+/* Frames of every string, as they are sent */
+static const uint8_t flash_string_messages[] = {
+/* HELP */
+0xA5, 0x5A, 0x15, 0x00, 0x55, 0x8C, 0x03, 0xE3, 0xE5, 0xCC, 0x7D, 0x23,
+0x32, 0xC4, 0x71, 0xAD, 0x3F, 0x06, 0xE5, 0x62, 0xCD, 0x61, 0x4A, 0xB5,
+0x96, 0x71, 0xAC, 0x66, 0xA1, 0x60, 0x60, 0xB3, 0x58, 0x52, 0xA2, 0x97,
+0x85, 0x84, 0x50, 0x3A, 0x8F, 0x36, 0x81, 0xE3, 0x93, 0x59, 0x67, 0x1A,
+0xC6, 0x6A, 0x16, 0x11, 0x41, 0x03, 0xC7, 0x21, 0x20, 0x95, 0x36,
+0xA5, 0x5A, 0x15, 0x00, 0x55, 0xD1, 0x02, 0x34, 0x42, 0xC0, 0xD9, 0x14,
+0x95, 0x1A, 0xCB, 0x38, 0xD6, 0x33, 0x50, 0xB0, 0x30, 0x8A, 0x5B, 0x26,
+0xCE, 0x46, 0xA9, 0xA1, 0xAB, 0x59, 0x67, 0x23, 0x43, 0x50, 0xB0, 0x31,
+0xB4, 0xB5, 0x05, 0x37, 0x8B, 0xB4, 0x53, 0x08, 0xA4, 0xA8, 0xD2, 0xA3,
+0xCC, 0x00, 0x02, 0xA7,
+0xA5, 0x5A, 0x15, 0x00, 0x55, 0xA3, 0x03, 0xF8, 0xA2, 0x96, 0xCE, 0xFD,
+0x13, 0xCB, 0x2D, 0xBD, 0x0F, 0xF5, 0x52, 0x9E, 0x07, 0xFA, 0xBB, 0x1A,
+0x3B, 0xF6, 0xD7, 0xFA, 0x45, 0xA9, 0x94, 0xBE, 0x4D, 0x65, 0x9C, 0xCF,
+0x13, 0x72, 0x85, 0x81, 0x87, 0x51, 0xFA, 0xB5, 0xC7, 0x37, 0x41, 0xAC,
+0xB3, 0xEE, 0x64, 0x99, 0xD4, 0xC2, 0xC0, 0xC3, 0xB4, 0x76, 0x26, 0x80,
+0x90, 0x69,
+0xA5, 0x5A, 0x15, 0x00, 0x55, 0x89, 0x03, 0x19, 0x6A, 0x2E, 0xD1, 0x4C,
+0x52, 0xF0, 0xB0, 0x30, 0xEA, 0x3F, 0x54, 0x6B, 0x89, 0x5D, 0x01, 0xF1,
+0xBB, 0x45, 0x34, 0xF9, 0x0F, 0x8C, 0x93, 0xE4, 0xD6, 0x59, 0xFB, 0x47,
+0x25, 0x86, 0xA1, 0x60, 0x62, 0x99, 0xAE, 0x59, 0xA8, 0x8C, 0xD6, 0x82,
+0x46, 0x88, 0x58, 0x1A, 0x0A, 0x5E, 0x33, 0xC8, 0x00, 0xE5, 0x3C,
+0xA5, 0x5A, 0x15, 0x00, 0x55, 0xFF, 0x02, 0x5A, 0x0E, 0x1B, 0xC5, 0xDA,
+0x29, 0xA3, 0x5C, 0x59, 0xBC, 0x7C, 0x6A, 0x4A, 0x7F, 0x26, 0xB2, 0xCE,
+0x7F, 0xB7, 0x78, 0xAB, 0xA0, 0x16, 0x06, 0x13, 0x58, 0x96, 0x23, 0x2A,
+0x55, 0x42, 0xD0, 0x14, 0xE8, 0xB0, 0xD4, 0x5C, 0x59, 0xBC, 0x54, 0x94,
+0xD9, 0xBC, 0xA6, 0xBA, 0x82, 0x9E, 0x8A, 0xF5, 0x50,
+0xA5, 0x5A, 0x15, 0x00, 0x3A, 0x81, 0x02, 0x84, 0x67, 0x80, 0x3C, 0x50,
+0xC5, 0xF4, 0xA8, 0x39, 0xBA, 0x8F, 0x8C, 0xF0, 0x05, 0x37, 0x87, 0x9B,
+0xA8, 0xF8, 0xCF, 0x01, 0x4F, 0x4D, 0x42, 0xC0, 0xC2, 0x6B, 0x12, 0xC4,
+0x65, 0x4A, 0xAB, 0x00, 0x60, 0x82,
+};
+
+/* Offset of the first message of every string, then the end of the last one */
+static const uint16_t flash_string_offsets[FLASH_STRING_COUNT + 1] = {
+0, 331,
+};
+
+#endif /* FLASH_STRINGS_DATA */
+
+#endif
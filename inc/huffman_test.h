@@ -17,17 +17,20 @@
 #ifndef HUFFMAN_TEST_H_
 #define HUFFMAN_TEST_H_
 
+#include "huffman.h"
+
 /*********************************************************************************
  * @brief   :   Tests the huffman algorithm functionality
  *
  *              This function tests the algorithm functionality by encoding and
  *              decoding multiple strings
  *
- * @param   :   None
+ * @param   :   model	- adaptive tree the tests may use, left in any state
+ * 				history	- LZ history the tests may use, left in any state
  *
  * @return  :   void
 *********************************************************************************/
-void test_huffman(void);
+void test_huffman(huffman_adaptive_t *model, huffman_lz_t *history);
 
 
 #endif /* CBFIFO_TEST_H_ */
@@ -0,0 +1,67 @@
+/**
+ * @file    :   tokens.h
+ * @brief   :   An abstraction for printing with format string tokens
+ *
+ *              This header file provides functions which pack the ID of a
+ * 				format string of format_strings.h and its arguments into a few
+ * 				bytes, and render the text again from them. The KL25Z sends
+ * 				the packed bytes instead of the text, which saves formatting
+ * 				the text on the device and most of the bytes on the wire.
+ *
+ * 				The ID and the numbers are sent as varints, 7 bits to a byte
+ * 				starting with the lowest and the top bit set in every byte
+ * 				but the last. Signed numbers are zigzag coded first so small
+ * 				negative numbers stay short. A string is sent as its length
+ * 				and its bytes, a character as one byte. Numbers are 32 bits.
+ *
+ * @author  :   Sanish Kharade
+ * @date    :   December 10, 2021
+ * @version :   1.0
+ *
+ * @tools   :   MCUXpresso IDE
+ *
+ * @link    :   -
+*/
+
+#ifndef TOKENS_H_
+#define TOKENS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include "format_strings.h"
+
+/* Most bytes of a varint of 32 bits */
+#define TOKENS_VARINT_BYTES		(5)
+
+/* Format string of every ID */
+extern const char *const format_strings[FORMAT_COUNT];
+
+/*********************************************************************************
+ * @brief   :  	Packs the ID of a format string and its arguments
+ *
+ * @param   :   buffer	- buffer to fill with the packed bytes
+ * 				nbytes	- size of the buffer
+ * 				format	- ID of the format string
+ * 				args	- arguments of the format string
+ *
+ * @return  : 	size_t	- number of bytes written to buffer, 0 if they do not
+ * 						  fit or the format string has a conversion which
+ * 						  cannot be packed
+**********************************************************************************/
+size_t tokens_pack(uint8_t *buffer, size_t nbytes, format_id_t format, va_list args);
+
+/*********************************************************************************
+ * @brief   :  	Renders the text of a format string packed by tokens_pack
+ *
+ * @param   :   data	- packed bytes
+ * 				length	- number of bytes in data
+ * 				text	- buffer to fill with the text, terminated by a '\0'
+ * 				nbytes	- size of the buffer
+ *
+ * @return  : 	int		- number of characters of the text, -1 if the packed
+ * 						  bytes are corrupt or the text does not fit
+**********************************************************************************/
+int tokens_render(const uint8_t *data, size_t length, char *text, size_t nbytes);
+
+#endif /* TOKENS_H_ */
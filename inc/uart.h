@@ -21,6 +21,10 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <MKL25Z4.H>
+#include "format_strings.h"
+
+/* Largest batch of writes, a batch is sent as one message */
+#define TX_BATCH_MAX		(85)
 
 /*********************************************************************************
  * @brief   :   Resets the data and time stats to zero
@@ -40,6 +44,183 @@ void reset_stats(void);
 *********************************************************************************/
 void print_stats(void);
 
+/*********************************************************************************
+ * @brief   :   Measures the speed and compression of the huffman coders
+ *
+ *              Prints the cycles per byte and the bits per character of the
+ *              static table, the order-1 coder, the repeats, the adaptive tree
+ *              and the range coder, and of the tANS coder when it is built with
+ *              HUFFMAN_ANS
+ *
+ * @param   :   none
+ *
+ * @return  :   void
+*********************************************************************************/
+void print_benchmark(void);
+
+/*********************************************************************************
+ * @brief   :   Runs the huffman tests with the adaptive tree of the UART
+ *
+ *              The tree is emptied again afterwards, the receiver is told to
+ *              empty its tree as well
+ *
+ * @param   :   none
+ *
+ * @return  :   void
+*********************************************************************************/
+void test_tx_coders(void);
+
+/*********************************************************************************
+ * @brief   :   Prints a format string of format_strings.h as a token
+ *
+ *              Sends the ID of the format string and its packed arguments,
+ *              the receiver renders the text
+ *
+ * @param   :   format	- ID of the format string
+ * 				...		- arguments of the format string
+ *
+ * @return  :   int	- 0 on success
+ * 				-1	- error
+*********************************************************************************/
+int print_token(format_id_t format, ...);
+
+/*********************************************************************************
+ * @brief   :   Prints a constant string of flash_strings.h
+ *
+ *              The string is sent as it was encoded when the firmware was
+ *              built, without encoding anything
+ *
+ * @param   :   id	- ID of the string, FLASH_STRING_<NAME>
+ *
+ * @return  :   int	- 0 on success
+ * 				-1	- error
+*********************************************************************************/
+int print_flash_string(uint8_t id);
+
+/*********************************************************************************
+ * @brief   :   Selects the huffman coder for the next messages
+ *
+ * @param   :   adaptive	- true for the adaptive coder, false for the static table
+ *
+ * @return  :   void
+*********************************************************************************/
+void set_adaptive_mode(bool adaptive);
+
+/*********************************************************************************
+ * @brief   :   Selects the range coder for the next messages in static mode
+ *
+ * @param   :   range	- true to try the range coder on every message
+ *
+ * @return  :   void
+*********************************************************************************/
+void set_range_mode(bool range);
+
+/*********************************************************************************
+ * @brief   :   Selects block tables for long writes in static mode
+ *
+ * @param   :   block	- true to try a block table on every long write
+ *
+ * @return  :   void
+*********************************************************************************/
+void set_block_mode(bool block);
+
+/*********************************************************************************
+ * @brief   :   Selects the bit stream for static messages
+ *
+ * @param   :   stream	- true to continue the stream with every static message
+ *
+ * @return  :   void
+*********************************************************************************/
+void set_stream_mode(bool stream);
+
+/*********************************************************************************
+ * @brief   :   Sets the size and latency of a batch of writes
+ *
+ *              The batch held so far is sent first. A size of 0 or a latency
+ *              of 0 sends every write as it comes
+ *
+ * @param   :   bytes	- most bytes in a batch, at most TX_BATCH_MAX
+ * 				latency	- most ms the first byte of a batch waits
+ *
+ * @return  :   bool	- false if bytes is too large, nothing is changed
+*********************************************************************************/
+bool set_batch(int bytes, uint32_t latency);
+
+/*********************************************************************************
+ * @brief   :   Finds the baud rate UART0 can run at closest to a rate
+ *
+ * @param   :   rate	- baud rate asked for
+ *
+ * @return  :   uint32_t	- baud rate the divisors of the UART clock make,
+ * 							  0 if it is too far from rate
+*********************************************************************************/
+uint32_t check_baud_rate(uint32_t rate);
+
+/*********************************************************************************
+ * @brief   :   Returns the baud rate of the link
+ *
+ * @param   :   none
+ *
+ * @return  :   uint32_t	- baud rate last set
+*********************************************************************************/
+uint32_t get_baud_rate(void);
+
+/*********************************************************************************
+ * @brief   :   Switches UART0 to another baud rate
+ *
+ *              Everything held back is sent and the last byte leaves the
+ *              shift register at the old rate first. The bytes received
+ *              so far are dropped, they may be garbled by the switch
+ *
+ * @param   :   rate	- baud rate, check_baud_rate must accept it
+ *
+ * @return  :   void
+*********************************************************************************/
+void set_baud_rate(uint32_t rate);
+
+/*********************************************************************************
+ * @brief   :   Waits for a character, dropping anything else received
+ *
+ * @param   :   c		- character to wait for
+ * 				timeout	- most ms to wait
+ *
+ * @return  :   bool	- true if c was received in time
+*********************************************************************************/
+bool wait_for_char(uint8_t c, uint32_t timeout);
+
+/*********************************************************************************
+ * @brief   :   Prints the baud rate of the link and the bytes it carries a second
+ *
+ * @param   :   none
+ *
+ * @return  :   void
+*********************************************************************************/
+void print_baud_rate(void);
+
+/*********************************************************************************
+ * @brief   :   Sends everything held back, the batch and the repeats
+ *
+ *              Stands in for fflush(stdout), which does not reach the UART
+ *              as Redlib does not buffer stdout
+ *
+ * @param   :   none
+ *
+ * @return  :   int	- 0 on success
+ * 				-1	- error
+*********************************************************************************/
+int flush_tx(void);
+
+/*********************************************************************************
+ * @brief   :   Empties the history of the LZ messages
+ *
+ *              The next message tells the receiver to empty its history as well
+ *
+ * @param   :   none
+ *
+ * @return  :   void
+*********************************************************************************/
+void reset_tx_history(void);
+
 /*********************************************************************************
  * @brief   :   Sets the custom string member of the stats structure to true
  *
@@ -52,7 +233,7 @@ void set_custom_string_true(void);
 /*********************************************************************************
  * @brief   :   Initializes the UART
  *
- * @param   :   baud_rate - baud rate for the UART
+ * @param   :   none
  *
  * @return  :   void
 *********************************************************************************/
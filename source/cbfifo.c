@@ -260,3 +260,79 @@ size_t cbfifo_capacity(cbfifo_handle_t cbf_handle)
 	return CBFIFO_CAPACITY;
 }
 
+/*********************************************************************************
+ * @brief   :   Returns the bytes at the front of the FIFO which are next
+ *              to each other in memory
+ *
+ *              The bytes stay on the FIFO until cbfifo_release removes them,
+ *              so a DMA channel can send them from where they are. The span
+ *              ends where the FIFO wraps around, the bytes after the wrap
+ *              are the next span.
+ *
+ * @param   :   cbf_handle 	handle of cbfifo
+ * 				span	- set to the first byte of the span
+ *
+ * @return  :   size_t  - number of bytes in the span, 0 if the FIFO is empty
+ *
+*********************************************************************************/
+size_t cbfifo_span(cbfifo_handle_t cbf_handle, const void **span)
+{
+	/* Disable the interrupts */
+	uint32_t masking_state;
+	masking_state = __get_PRIMASK();
+	__disable_irq();
+
+	size_t read = gfifos[cbf_handle].read;
+	size_t nbyte = gfifos[cbf_handle].length;
+
+	/* The span stops at the end of the array */
+	if(nbyte > cbfifo_capacity(cbf_handle) - read)
+	{
+		nbyte = cbfifo_capacity(cbf_handle) - read;
+	}
+	*span = &gfifos[cbf_handle].cbfifo_array[read];
+
+	/* Enable the interrupts */
+	__set_PRIMASK(masking_state);
+
+	return nbyte;
+}
+
+/*********************************************************************************
+ * @brief   :   Removes bytes from the front of the FIFO without copying them
+ *
+ * @param   :   cbf_handle 	handle of cbfifo
+ *              nbyte   - number of bytes to remove, at most the length
+ *
+ * @return  :   size_t  - number of bytes removed
+ *
+*********************************************************************************/
+size_t cbfifo_release(cbfifo_handle_t cbf_handle, size_t nbyte)
+{
+	/* Disable the interrupts */
+	uint32_t masking_state;
+	masking_state = __get_PRIMASK();
+	__disable_irq();
+
+	if(nbyte > gfifos[cbf_handle].length)
+	{
+		nbyte = gfifos[cbf_handle].length;
+	}
+
+	/* Update read location, length and state of cbfifo */
+	gfifos[cbf_handle].read = (gfifos[cbf_handle].read + nbyte) & (cbfifo_capacity(cbf_handle) - 1);
+	gfifos[cbf_handle].length -= nbyte;
+	if(gfifos[cbf_handle].length == 0)
+	{
+		gfifos[cbf_handle].state = EMPTY;
+	}
+	else if(nbyte > 0)
+	{
+		gfifos[cbf_handle].state = PARTIALLY_FILLED;
+	}
+
+	/* Enable the interrupts */
+	__set_PRIMASK(masking_state);
+
+	return nbyte;
+}
@@ -445,6 +445,36 @@ void test_cbfifo()
 	assert(cbfifo_length(kRx_FIFO) == 0);
 	assert(strncmp(bufRx, str+rposRx, capRx) == 0);
 
+	// a span stops where the fifo wraps, the bytes after it are the next span
+	const void *span;
+	assert(cbfifo_enqueue(kTx_FIFO, str, capTx) == capTx);
+	size_t first = cbfifo_span(kTx_FIFO, &span);
+	assert(first > 0 && first <= capTx);
+	assert(strncmp(span, str, first) == 0);
+	assert(cbfifo_release(kTx_FIFO, capTx) == capTx);
+
+	// the first span ended at the end of the array, move the read index to its start
+	assert(cbfifo_enqueue(kTx_FIFO, str, first) == first);
+	assert(cbfifo_dequeue(kTx_FIFO, bufTx, first) == first);
+	assert(cbfifo_enqueue(kTx_FIFO, str, capTx) == capTx);
+	assert(cbfifo_span(kTx_FIFO, &span) == capTx);
+	assert(cbfifo_release(kTx_FIFO, capTx) == capTx);
+
+	// with the read index in the middle, a full fifo is two spans
+	assert(cbfifo_enqueue(kTx_FIFO, str, capTx/2) == capTx/2);
+	assert(cbfifo_dequeue(kTx_FIFO, bufTx, capTx/2) == capTx/2);
+	assert(cbfifo_enqueue(kTx_FIFO, str, capTx) == capTx);
+	first = cbfifo_span(kTx_FIFO, &span);
+	assert(first == capTx - capTx/2);
+	assert(strncmp(span, str, first) == 0);
+	assert(cbfifo_release(kTx_FIFO, first) == first);
+	assert(cbfifo_length(kTx_FIFO) == capTx/2);
+	assert(cbfifo_span(kTx_FIFO, &span) == capTx/2);
+	assert(strncmp(span, str+first, capTx/2) == 0);
+	assert(cbfifo_release(kTx_FIFO, capTx) == capTx/2);
+	assert(cbfifo_length(kTx_FIFO) == 0);
+	assert(cbfifo_span(kTx_FIFO, &span) == 0);
+
 
 	//printf("%s: passed all test cases\n\r", __FUNCTION__);
 }
@@ -15,6 +15,7 @@
 */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
 #include <stdint.h>
@@ -22,27 +23,35 @@
 #include "commands.h"
 #include "huffman.h"
 #include "uart.h"
+#include "flash_strings.h"
 
 
+/* Most ms the new baud rate waits for the link check of the PC */
+#define BAUD_CHECK_TIMEOUT	(1000)
+
 /* Function Pointer */
 typedef void (*command_handler_t)(int, char *argv[]);
 typedef struct
 {
     const char *name;
     command_handler_t handler;
-    const char *help_string;
 } command_table_t;
 
 /* Command Table
- * This table is an array of structures which consists of the function name,
- * function handle and a help string for each command
+ * This table is an array of structures which consists of the function name
+ * and function handle for each command. The help text of the commands is the
+ * HELP string of windows_files/flash_strings.txt
  * */
 static const command_table_t commands[] = {
 
-		{"author", handle_author, "\n\r\t\tPrint the author of this code\n\r"},
-		{"help", handle_help, "\n\r\t\tPrint this help message\n\r"},
-		{"stats", handle_stats, "\n\r\t\tPrint the statistics\n\r"},
-		{"reset", handle_reset, "\n\r\t\tReset the timer and byte stats\n\r"}
+		{"author", handle_author},
+		{"help", handle_help},
+		{"stats", handle_stats},
+		{"reset", handle_reset},
+		{"mode", handle_mode},
+		{"bench", handle_bench},
+		{"batch", handle_batch},
+		{"baud", handle_baud}
 };
 
 /* Statically defined length of command table */
@@ -113,7 +122,7 @@ static bool checkHex(char *ch, int len)
             (ch[i] < 'a' || ch[i] > 'f') &&
 			(ch[i] != 'x' && ch[i] != 'X'))
         {
-        	printf("Invalid argument\n\r");
+        	print_token(FORMAT_INVALID_ARGUMENT);
         	return false;
         }
 	}
@@ -133,10 +142,10 @@ void handle_author(int argc, char *argv[])
 	/* Check valid number of arguments */
 	if(argc > 1)
 	{
-		printf("Too many arguments for the author command\n\rEnter help command for syntax of all commands\n\r");
+		print_token(FORMAT_TOO_MANY_ARGUMENTS, "author");
 		return;
 	}
-	printf("Sanish Kharade\n\r");
+	print_token(FORMAT_AUTHOR);
 }
 
 
@@ -153,24 +162,12 @@ void handle_help(int argc, char *argv[])
 	/* Check valid number of arguments */
 	if(argc > 1)
 	{
-		printf("Too many arguments for the help command\n\rEnter help command for syntax of all commands\n\r");
+		print_token(FORMAT_TOO_MANY_ARGUMENTS, "help");
 		return;
 	}
-	uint8_t buff[100]={0};
-	uint8_t buff2[300]={0};
-
-	strcat(buff2, "PES Final Project\n\r");
-	for(int i = 0; i < num_commands; i++)
-	{
-		sprintf(buff, "%s%s", commands[i].name, commands[i].help_string);
-		strcat(buff2, buff);
-
-		memset(buff, 0, sizeof(buff));
-	}
-
-	strcat(buff2, "\n\rEnter anything else for encoding and decoding over the serial port\n\r");
 
-	printf("%s", buff2);
+	/* The help text was encoded when the firmware was built */
+	print_flash_string(FLASH_STRING_HELP);
 }
 /*********************************************************************************
  * @brief   :   Function to handle the reset command
@@ -185,11 +182,11 @@ void handle_reset(int argc, char *argv[])
 	/* Check valid number of arguments */
 	if(argc > 1)
 	{
-		printf("Too many arguments for the reset command\n\rEnter help command for syntax of all commands\n\r");
+		print_token(FORMAT_TOO_MANY_ARGUMENTS, "reset");
 		return;
 	}
 
-	printf("Timer and Bytes Reset\n\r");
+	print_token(FORMAT_RESET);
 
 	reset_stats();
 
@@ -207,12 +204,172 @@ void handle_stats(int argc, char *argv[])
 
 	if(argc > 1)
 	{
-		printf("Too many arguments for the stats command\n\rEnter help command for syntax of all commands\n\r");
+		print_token(FORMAT_TOO_MANY_ARGUMENTS, "stats");
 		return;
 	}
 	print_stats();
 
 }
+/*********************************************************************************
+ * @brief   :   Function to handle the mode command
+ *
+ * @param   :   argc  	- Number of arguments
+ * 				argv	- Array of arguments
+ *
+ * @return  :   void
+*********************************************************************************/
+void handle_mode(int argc, char *argv[])
+{
+	if(argc != 2)
+	{
+		print_token(FORMAT_MODE_USAGE);
+		return;
+	}
+
+	if(strcasecmp(argv[1], "static") == 0)
+	{
+		set_adaptive_mode(false);
+		set_range_mode(false);
+		set_block_mode(false);
+		set_stream_mode(false);
+		print_token(FORMAT_MODE_STATIC);
+	}
+	else if(strcasecmp(argv[1], "adaptive") == 0)
+	{
+		set_adaptive_mode(true);
+		set_range_mode(false);
+		set_block_mode(false);
+		set_stream_mode(false);
+		print_token(FORMAT_MODE_ADAPTIVE);
+	}
+	else if(strcasecmp(argv[1], "range") == 0)
+	{
+		set_adaptive_mode(false);
+		set_range_mode(true);
+		set_block_mode(false);
+		set_stream_mode(false);
+		print_token(FORMAT_MODE_RANGE);
+	}
+	else if(strcasecmp(argv[1], "block") == 0)
+	{
+		set_adaptive_mode(false);
+		set_range_mode(false);
+		set_block_mode(true);
+		set_stream_mode(false);
+		print_token(FORMAT_MODE_BLOCK);
+	}
+	else if(strcasecmp(argv[1], "stream") == 0)
+	{
+		set_adaptive_mode(false);
+		set_range_mode(false);
+		set_block_mode(false);
+		set_stream_mode(true);
+		print_token(FORMAT_MODE_STREAM);
+	}
+	else
+	{
+		print_token(FORMAT_INVALID_ARGUMENT);
+	}
+}
+/*********************************************************************************
+ * @brief   :   Function to handle the bench command
+ *
+ * @param   :   argc  	- Number of arguments
+ * 				argv	- Array of arguments
+ *
+ * @return  :   void
+*********************************************************************************/
+void handle_bench(int argc, char *argv[])
+{
+	if(argc > 1)
+	{
+		print_token(FORMAT_TOO_MANY_ARGUMENTS, "bench");
+		return;
+	}
+	print_benchmark();
+}
+/*********************************************************************************
+ * @brief   :   Function to handle the batch command
+ *
+ * 				Sets how many bytes of writes are gathered into one message
+ * 				and how long the first of them may wait
+ *
+ * @param   :   argc  	- Number of arguments
+ * 				argv	- Array of arguments
+ *
+ * @return  :   void
+*********************************************************************************/
+void handle_batch(int argc, char *argv[])
+{
+	char *bytes_end, *latency_end;
+
+	if(argc != 3)
+	{
+		print_token(FORMAT_BATCH_USAGE, TX_BATCH_MAX);
+		return;
+	}
+
+	unsigned long bytes = strtoul(argv[1], &bytes_end, 10);
+	unsigned long latency = strtoul(argv[2], &latency_end, 10);
+
+	if(*bytes_end != '\0' || *latency_end != '\0' || bytes > TX_BATCH_MAX || !set_batch(bytes, latency))
+	{
+		print_token(FORMAT_INVALID_ARGUMENT);
+		return;
+	}
+	print_token(FORMAT_BATCH, (int)bytes, latency);
+}
+
+/*********************************************************************************
+ * @brief   :   Function to handle the baud command
+ *
+ * 				Acknowledges the rate at the old one and switches to it. The
+ * 				PC switches once it reads the acknowledgement and sends
+ * 				BAUD_CHECK_CHAR, which is answered at the new rate. If it
+ * 				does not come the old rate is set back
+ *
+ * @param   :   argc  	- Number of arguments
+ * 				argv	- Array of arguments
+ *
+ * @return  :   void
+*********************************************************************************/
+void handle_baud(int argc, char *argv[])
+{
+	char *rate_end;
+
+	if(argc != 2)
+	{
+		print_token(FORMAT_BAUD_USAGE);
+		return;
+	}
+
+	unsigned long rate = strtoul(argv[1], &rate_end, 10);
+
+	if(*rate_end != '\0')
+	{
+		print_token(FORMAT_INVALID_ARGUMENT);
+		return;
+	}
+	if(check_baud_rate(rate) == 0)
+	{
+		print_token(FORMAT_BAUD_RANGE, rate);
+		return;
+	}
+
+	unsigned long old_rate = get_baud_rate();
+
+	print_token(FORMAT_BAUD_SWITCH, rate);
+	set_baud_rate(rate);
+
+	if(!wait_for_char(BAUD_CHECK_CHAR, BAUD_CHECK_TIMEOUT))
+	{
+		set_baud_rate(old_rate);
+		print_token(FORMAT_BAUD_FAILED, old_rate);
+		return;
+	}
+	print_baud_rate();
+}
+
 /*********************************************************************************
  * @brief   :   Function to process the command received from the user
  *
@@ -271,9 +428,10 @@ void process_command(char *input)
         }
     }
 
-    /* No command */
+    /* No command, an empty line empties the history and the next message tells the host to do the same */
     if (argc == 0)
     {
+    	reset_tx_history();
     	return;
     }
 
@@ -18,6 +18,8 @@
 #include <assert.h>
 #include <inc/huffman.h>
 #include <inc/huffman_test.h>
+#include <inc/ans.h>
+#include <inc/range.h>
 #include <string.h>
 
 /*********************************************************************************
@@ -26,24 +28,26 @@
  *              This function tests the algorithm functionality by encoding and
  *              decoding multiple strings
  *
- * @param   :   None
+ * @param   :   model	- adaptive tree the tests may use, left in any state
+ * 				history	- LZ history the tests may use, left in any state
  *
  * @return  :   void
 *********************************************************************************/
-void test_huffman(void)
+void test_huffman(huffman_adaptive_t *model, huffman_lz_t *history)
 {
-
-	char str[][150] =
+	static const char *const str[] =
 	{
-			{"University of Colorado Boulder\n\r"},
-			{"My name is Sanish\n\r"
-			"I am a graduate student\n\r"},
-			{"This is a Principles of Embedded Software Course\n\r"
-			"This application is the Final Project for this course"},
-			{"testing all lowercase case characters here"},
-			{"TESTING ALL CAPITAL LETTERS HERE"},
-			{"Special Characters ()+-./][ "},
-			{"Numbers 1234567890"}
+			"University of Colorado Boulder\n\r",
+			"My name is Sanish\n\r"
+			"I am a graduate student\n\r",
+			"This is a Principles of Embedded Software Course\n\r"
+			"This application is the Final Project for this course",
+			"testing all lowercase case characters here",
+			"TESTING ALL CAPITAL LETTERS HERE",
+			"Special Characters ()+-./][ ",
+			"Numbers 1234567890",
+			"Tokens 12/10/2020 10:18:52 Device 1 turned on\n\r",
+			"Bytes without a code !\"#YZ \xc3\xa9\xe2\x82\xac \x01\x7f\xff"
 
 	};
 
@@ -66,15 +70,356 @@ void test_huffman(void)
 		{
 			encoded_bytes /= 8;
 		}
-		huffman_decode(encoded_buffer, strlen(str[i]), decoded_string);
+		huffman_decode(encoded_buffer, encoded_bytes, strlen(str[i]), decoded_string);
+
+		assert(strncmp(str[i], (char *)decoded_string, strlen(str[i])) == 0);
+
+		/* The decoder leaves the encoded buffer intact, so it decodes again */
+		memset(decoded_string, 0, sizeof(decoded_string));
+		bit_reader_t reader;
+		bit_reader_init(&reader, encoded_buffer, encoded_bytes);
+		assert(huffman_decode_reader(&reader, strlen(str[i]), decoded_string) == strlen(str[i]));
+		assert(strncmp(str[i], (char *)decoded_string, strlen(str[i])) == 0);
+
+		/* Encode and decode again in chunks which split the codes at odd places */
+		huffman_encoder_t encoder;
+		huffman_decoder_t decoder;
+		size_t length = strlen(str[i]), ebuf_id = 0, dbuf_id = 0;
+
+		memset(encoded_buffer, 0, sizeof(encoded_buffer));
+		memset(decoded_string, 0, sizeof(decoded_string));
+
+		huffman_encoder_init(&encoder);
+		for (size_t pos = 0; pos < length; pos += 5)
+		{
+			size_t chunk = (length - pos < 5) ? (length - pos) : 5;
+			ebuf_id += huffman_encoder_feed(&encoder, (uint8_t *)str[i] + pos, chunk,
+												encoded_buffer + ebuf_id, sizeof(encoded_buffer) - ebuf_id);
+		}
+		ebuf_id += huffman_encoder_flush(&encoder, encoded_buffer + ebuf_id, sizeof(encoded_buffer) - ebuf_id);
+		assert(ebuf_id == encoded_bytes);
+
+		huffman_decoder_init(&decoder, length);
+		for (size_t pos = 0; pos < ebuf_id; pos += 3)
+		{
+			size_t chunk = (ebuf_id - pos < 3) ? (ebuf_id - pos) : 3;
+			dbuf_id += huffman_decoder_feed(&decoder, encoded_buffer + pos, chunk,
+												decoded_string + dbuf_id, sizeof(decoded_string) - dbuf_id);
+		}
+		assert(dbuf_id == length && !decoder.corrupt);
+		assert(strncmp(str[i], (char *)decoded_string, length) == 0);
+
+		/* Encode and decode once more with the adaptive tree */
+		memset(encoded_buffer, 0, sizeof(encoded_buffer));
+		memset(decoded_string, 0, sizeof(decoded_string));
+		ebuf_id = 0;
+		dbuf_id = 0;
+
+		huffman_adaptive_reset(model);
+		huffman_encoder_init_adaptive(&encoder, model);
+		for (size_t pos = 0; pos < length; pos += 5)
+		{
+			size_t chunk = (length - pos < 5) ? (length - pos) : 5;
+			ebuf_id += huffman_encoder_feed(&encoder, (uint8_t *)str[i] + pos, chunk,
+												encoded_buffer + ebuf_id, sizeof(encoded_buffer) - ebuf_id);
+		}
+		ebuf_id += huffman_encoder_flush(&encoder, encoded_buffer + ebuf_id, sizeof(encoded_buffer) - ebuf_id);
+		assert(ebuf_id == (encoder.total_bits + 7) / 8);
+
+		huffman_adaptive_reset(model);
+		huffman_decoder_init_adaptive(&decoder, length, model);
+		for (size_t pos = 0; pos < ebuf_id; pos += 3)
+		{
+			size_t chunk = (ebuf_id - pos < 3) ? (ebuf_id - pos) : 3;
+			dbuf_id += huffman_decoder_feed(&decoder, encoded_buffer + pos, chunk,
+												decoded_string + dbuf_id, sizeof(decoded_string) - dbuf_id);
+		}
+		assert(dbuf_id == length && !decoder.corrupt);
+		assert(strncmp(str[i], (char *)decoded_string, length) == 0);
 
-		assert(strncmp(str[i], decoded_string, strlen(str[i])) == 0);
+		/* A tree given the raw bytes of a stored message codes the next one as the decoder's tree does */
+		huffman_encoder_init_adaptive(&encoder, model);
+		ebuf_id = huffman_encoder_feed(&encoder, (uint8_t *)str[0], strlen(str[0]), encoded_buffer, sizeof(encoded_buffer));
+		huffman_adaptive_reset(model);
+		huffman_adaptive_add(model, (uint8_t *)str[i], length);
+		huffman_encoder_init_adaptive(&encoder, model);
+		assert(huffman_encoder_feed(&encoder, (uint8_t *)str[0], strlen(str[0]), decoded_string, sizeof(decoded_string)) == ebuf_id);
+		assert(memcmp(encoded_buffer, decoded_string, ebuf_id) == 0);
 
 		memset(encoded_buffer, 0, sizeof(encoded_buffer));
 		memset(decoded_string, 0, sizeof(decoded_string));
 		encoded_bytes = 0;
 	}
 
+	/* The table picked for a message encodes it to no more bits than any other */
+	uint32_t bits;
+	uint8_t best = huffman_select_table((uint8_t *)str[0], strlen(str[0]), HUFFMAN_STATIC_TABLES, &bits);
+
+	assert(best < HUFFMAN_STATIC_TABLES && bits == huffman_encoded_bits(best, (uint8_t *)str[0], strlen(str[0])));
+	for(int i = 0; i < HUFFMAN_STATIC_TABLES; i++)
+		assert(bits <= huffman_encoded_bits(i, (uint8_t *)str[0], strlen(str[0])));
+
+	/* A table announced by its code lengths decodes what the original encodes */
+	uint8_t table[HUFFMAN_TABLE_BYTES];
+	huffman_encoder_t encoder;
+	huffman_decoder_t decoder;
+	size_t length = strlen(str[0]), ebuf_id, dbuf_id;
+
+	/*
+	 * A full tree, halved several times, still decodes what it encodes.
+	 * The bytes it has no leaf for are sent after the NYT code
+	 */
+	for (int i = 0; i < 200; i++)
+		decoded_string[i] = i;
+	huffman_adaptive_reset(model);
+	for (int round = 0; round < 100; round++)
+		huffman_adaptive_add(model, decoded_string, 200);
+	huffman_encoder_init_adaptive(&encoder, model);
+	ebuf_id = huffman_encoder_feed(&encoder, (uint8_t *)str[8], strlen(str[8]), encoded_buffer, sizeof(encoded_buffer));
+	ebuf_id += huffman_encoder_flush(&encoder, encoded_buffer + ebuf_id, sizeof(encoded_buffer) - ebuf_id);
+
+	huffman_adaptive_reset(model);
+	for (int round = 0; round < 100; round++)
+		huffman_adaptive_add(model, decoded_string, 200);
+	memset(decoded_string, 0, sizeof(decoded_string));
+	huffman_decoder_init_adaptive(&decoder, strlen(str[8]), model);
+	assert(huffman_decoder_feed(&decoder, encoded_buffer, ebuf_id, decoded_string, sizeof(decoded_string)) == strlen(str[8]));
+	assert(!decoder.corrupt && strcmp(str[8], (char *)decoded_string) == 0);
+	memset(encoded_buffer, 0, sizeof(encoded_buffer));
+	memset(decoded_string, 0, sizeof(decoded_string));
+
+	size_t table_bytes = huffman_export_table(0, table, sizeof(table));
+	assert(table_bytes > 0 && table_bytes <= HUFFMAN_TABLE_BYTES);
+	assert(huffman_import_table(HUFFMAN_RUNTIME_TABLE, table, table_bytes));
+
+	/* Packed lengths cut short are refused */
+	assert(!huffman_import_table(HUFFMAN_RUNTIME_TABLE, table, table_bytes - 1));
+
+	huffman_encoder_init_table(&encoder, 0);
+	ebuf_id = huffman_encoder_feed(&encoder, (uint8_t *)str[0], length, encoded_buffer, sizeof(encoded_buffer));
+	ebuf_id += huffman_encoder_flush(&encoder, encoded_buffer + ebuf_id, sizeof(encoded_buffer) - ebuf_id);
+
+	huffman_decoder_init_table(&decoder, length, HUFFMAN_RUNTIME_TABLE);
+	dbuf_id = huffman_decoder_feed(&decoder, encoded_buffer, ebuf_id, decoded_string, sizeof(decoded_string));
+	assert(dbuf_id == length && !decoder.corrupt);
+	assert(strncmp(str[0], (char *)decoded_string, length) == 0);
+
+	/* A short message is not worth a block table, a block of bytes the tables code badly is */
+	uint8_t block[384];
+
+	assert(huffman_build_block_table((uint8_t *)str[0], strlen(str[0]), HUFFMAN_STATIC_TABLES, table, sizeof(table)) == 0);
+	for(length = 0; length + strlen(str[8]) < sizeof(block); length += strlen(str[8]))
+		memcpy(block + length, str[8], strlen(str[8]));
+
+	table_bytes = huffman_build_block_table((uint8_t *)block, length, HUFFMAN_STATIC_TABLES, table, sizeof(table));
+	assert(table_bytes > 0);
+
+	/* The new table has the other ID, the one it replaced is gone */
+	uint8_t block_table = huffman_runtime_table();
+	assert(block_table == HUFFMAN_RUNTIME_TABLE + 1 && !huffman_has_table(HUFFMAN_RUNTIME_TABLE));
+	assert(8 * (table_bytes + 4) + huffman_encoded_bits(block_table, (uint8_t *)block, length) <
+			huffman_encoded_bits(huffman_select_table((uint8_t *)block, length, HUFFMAN_STATIC_TABLES, NULL), (uint8_t *)block, length));
+	assert(huffman_import_table(block_table, table, table_bytes));
+
+	huffman_encoder_init_table(&encoder, block_table);
+	ebuf_id = huffman_encoder_feed(&encoder, (uint8_t *)block, strlen(str[8]), encoded_buffer, sizeof(encoded_buffer));
+	ebuf_id += huffman_encoder_flush(&encoder, encoded_buffer + ebuf_id, sizeof(encoded_buffer) - ebuf_id);
+
+	huffman_decoder_init_table(&decoder, strlen(str[8]), block_table);
+	dbuf_id = huffman_decoder_feed(&decoder, encoded_buffer, ebuf_id, decoded_string, sizeof(decoded_string));
+	assert(dbuf_id == strlen(str[8]) && !decoder.corrupt);
+	assert(strncmp(str[8], (char *)decoded_string, dbuf_id) == 0);
+
+	/* Every string round trips through the order-1 coder, its bits counted exactly */
+	for(int i = 0; i < num_strings; i++)
+	{
+		length = strlen(str[i]);
+		memset(decoded_string, 0, sizeof(decoded_string));
+
+		huffman_encoder_init_context(&encoder);
+		ebuf_id = huffman_encoder_feed(&encoder, (uint8_t *)str[i], length, encoded_buffer, sizeof(encoded_buffer));
+		ebuf_id += huffman_encoder_flush(&encoder, encoded_buffer + ebuf_id, sizeof(encoded_buffer) - ebuf_id);
+		assert(encoder.total_bits == huffman_context_bits((uint8_t *)str[i], length));
+
+		huffman_decoder_init_context(&decoder, length);
+		dbuf_id = huffman_decoder_feed(&decoder, encoded_buffer, ebuf_id, decoded_string, sizeof(decoded_string));
+		assert(dbuf_id == length && !decoder.corrupt);
+		assert(strncmp(str[i], (char *)decoded_string, length) == 0);
+	}
+
+	/*
+	 * Every string round trips through the LZ coder with the history kept
+	 * across strings, then once more as a repeat of the first pass. There
+	 * is one history, so all strings are encoded into block first and
+	 * decoded after the history is emptied again
+	 */
+	uint16_t ends[2 * sizeof(str) / sizeof(str[0])];
+
+	huffman_lz_reset(history);
+	ebuf_id = 0;
+	for(int i = 0; i < 2 * num_strings; i++)
+	{
+		const char *message = str[i % num_strings];
+
+		length = strlen(message);
+		huffman_encoder_init_lz(&encoder, 0, history);
+		ebuf_id += huffman_encoder_feed(&encoder, (uint8_t *)message, length, block + ebuf_id, sizeof(block) - ebuf_id);
+		ebuf_id += huffman_encoder_flush(&encoder, block + ebuf_id, sizeof(block) - ebuf_id);
+		assert(ebuf_id < sizeof(block));
+		ends[i] = ebuf_id;
+		if (i >= num_strings)
+			assert(encoder.total_bits < huffman_encoded_bits(0, (uint8_t *)message, length));
+	}
+
+	huffman_lz_reset(history);
+	for(int i = 0; i < 2 * num_strings; i++)
+	{
+		const char *message = str[i % num_strings];
+
+		length = strlen(message);
+		dbuf_id = 0;
+		memset(decoded_string, 0, sizeof(decoded_string));
+
+		huffman_decoder_init_lz(&decoder, length, 0, history);
+		for (size_t pos = (i > 0) ? ends[i - 1] : 0; pos < ends[i]; pos += 3)
+		{
+			size_t chunk = (ends[i] - pos < 3) ? (ends[i] - pos) : 3;
+			dbuf_id += huffman_decoder_feed(&decoder, block + pos, chunk,
+												decoded_string + dbuf_id, sizeof(decoded_string) - dbuf_id);
+		}
+		assert(dbuf_id == length && !decoder.corrupt);
+		assert(strncmp(message, (char *)decoded_string, length) == 0);
+	}
+
+	/* A run of a character is a repeat of it from 1 back, even with no history */
+	char run[61];
+	memset(run, '-', sizeof(run) - 1);
+	run[sizeof(run) - 1] = '\0';
+	huffman_lz_reset(history);
+	huffman_encoder_init_lz(&encoder, 0, history);
+	ebuf_id = huffman_encoder_feed(&encoder, (uint8_t *)run, sizeof(run) - 1, encoded_buffer, sizeof(encoded_buffer));
+	ebuf_id += huffman_encoder_flush(&encoder, encoded_buffer + ebuf_id, sizeof(encoded_buffer) - ebuf_id);
+	assert(encoder.total_bits < 40);
+
+	huffman_lz_reset(history);
+	huffman_decoder_init_lz(&decoder, sizeof(run) - 1, 0, history);
+	dbuf_id = huffman_decoder_feed(&decoder, encoded_buffer, ebuf_id, decoded_string, sizeof(decoded_string));
+	assert(dbuf_id == sizeof(run) - 1 && !decoder.corrupt);
+	assert(strncmp(run, (char *)decoded_string, dbuf_id) == 0);
+
+	/* Every string round trips through the range coder of every static table */
+	for(int i = 0; i < num_strings; i++)
+	{
+		for (uint8_t t = 0; t < HUFFMAN_STATIC_TABLES; t++)
+		{
+			uint32_t bits;
+
+			length = strlen(str[i]);
+			memset(decoded_string, 0, sizeof(decoded_string));
+
+			ebuf_id = range_encode_table(t, (uint8_t *)str[i], length, encoded_buffer, sizeof(encoded_buffer), &bits);
+			assert(ebuf_id > 0 && bits == 8 * ebuf_id);
+
+			dbuf_id = range_decode_table(t, encoded_buffer, ebuf_id, length, decoded_string);
+			assert(dbuf_id == length);
+			assert(strncmp(str[i], (char *)decoded_string, length) == 0);
+		}
+	}
+
+#if HUFFMAN_ANS
+	/* Every string round trips through the tANS coder of every static table */
+	for(int i = 0; i < num_strings; i++)
+	{
+		for (uint8_t t = 0; t < HUFFMAN_STATIC_TABLES; t++)
+		{
+			uint32_t bits;
+
+			length = strlen(str[i]);
+			memset(decoded_string, 0, sizeof(decoded_string));
+
+			ebuf_id = ans_encode_table(t, (uint8_t *)str[i], length, encoded_buffer, sizeof(encoded_buffer), &bits);
+			assert(ebuf_id == (bits + 7) / 8);
+
+			dbuf_id = ans_decode_table(t, encoded_buffer, ebuf_id, length, decoded_string);
+			assert(dbuf_id == length);
+			assert(strncmp(str[i], (char *)decoded_string, length) == 0);
+
+			/* Input cut short stops the decoder */
+			assert(ans_decode_table(t, encoded_buffer, ebuf_id / 2, length, decoded_string) < length);
+		}
+	}
+#endif
+
+	/*
+	 * The strings sent as one stream, each with the next table, take the
+	 * bits of their codes and one byte of padding at most. They decode frame
+	 * by frame, the characters left over from the last string with its table
+	 * first. The decoder has every character once the encoder has no bits left
+	 */
+	size_t stream_length = 0, stream_bytes = 0, offset = 0;
+	int string = 0;
+
+	dbuf_id = 0;
+	huffman_encoder_init_table(&encoder, 0);
+	huffman_decoder_init_table(&decoder, 0, 0);
+	for(int i = 0; i <= num_strings; i++)
+	{
+		uint8_t t = i % HUFFMAN_STATIC_TABLES;
+		size_t used = 0, decoded = 0;
+
+		length = (i < num_strings) ? strlen(str[i]) : 0;
+		stream_length += length;
+
+		huffman_encoder_next_message(&encoder, t);
+		ebuf_id = huffman_encoder_feed(&encoder, (uint8_t *)str[i % num_strings], length, encoded_buffer, sizeof(encoded_buffer));
+		ebuf_id += huffman_encoder_end_message(&encoder, encoded_buffer + ebuf_id, sizeof(encoded_buffer) - ebuf_id);
+		if(i == num_strings)
+			ebuf_id += huffman_encoder_pad(&encoder, encoded_buffer + ebuf_id, sizeof(encoded_buffer) - ebuf_id);
+		stream_bytes += ebuf_id;
+
+		if(decoder.remaining > 0)
+		{
+			decoded = huffman_decoder_feed(&decoder, encoded_buffer, ebuf_id, decoded_string, sizeof(decoded_string));
+			used = decoder.reader.position;
+		}
+		assert(decoder.remaining == 0);
+		huffman_decoder_next_message(&decoder, length, t);
+		decoded += huffman_decoder_feed(&decoder, encoded_buffer + used, ebuf_id - used,
+											decoded_string + decoded, sizeof(decoded_string) - decoded);
+
+		assert(!decoder.corrupt && (decoder.remaining == 0) == (encoder.bit_count == 0));
+
+		/* The characters carry on the strings where the last ones stopped */
+		for (size_t k = 0; k < decoded; k++)
+		{
+			if (offset == strlen(str[string]))
+			{
+				string++;
+				offset = 0;
+			}
+			assert(decoded_string[k] == (uint8_t)str[string][offset++]);
+		}
+		dbuf_id += decoded;
+	}
+	assert(dbuf_id == stream_length && stream_bytes == (encoder.total_bits + 7) / 8);
+
+	/* Lengths with codes which are not in the code of the lengths are refused */
+	memset(table, 0xFF, sizeof(table));
+	assert(!huffman_import_table(HUFFMAN_RUNTIME_TABLE, table, sizeof(table)));
+
+	/* The CRC has the check value of CRC-16/CCITT-FALSE */
+	assert(huffman_frame_crc(HUFFMAN_FRAME_CRC_INIT, (uint8_t *)"123456789", 9) == 0x29B1);
+
+	/* A header with sizes above 255 reads back, and is not found one byte late */
+	uint8_t type, sequence;
+	uint32_t frame_size, frame_bits;
+	size_t header = huffman_frame_header(HUFFMAN_FRAME_STATIC, 200, 300, 70000, encoded_buffer);
+	assert(header == HUFFMAN_FRAME_BYTES(300, 70000) - (70000 + 7) / 8 - HUFFMAN_FRAME_CRC_BYTES);
+	assert(huffman_frame_parse(encoded_buffer, header - 1, &type, &sequence, &frame_size, &frame_bits) == 0);
+	assert(huffman_frame_parse(encoded_buffer, header, &type, &sequence, &frame_size, &frame_bits) == (int)header);
+	assert(type == HUFFMAN_FRAME_STATIC && sequence == 200 && frame_size == 300 && frame_bits == 70000);
+	assert(huffman_frame_parse(encoded_buffer + 1, header - 1, &type, &sequence, &frame_size, &frame_bits) < 0);
+
 
 
 
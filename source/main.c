@@ -20,6 +20,7 @@
 
 #include "cbfifo_test.h"
 #include "huffman_test.h"
+#include "huffman.h"
 #include "commands.h"
 #include "sysclock.h"
 #include "uart.h"
@@ -42,10 +43,13 @@ int main(void)
 	/* Initialize the UART */
     Init_UART0();
 
+    /* Build the huffman decode tables */
+    huffman_init();
+
     /* Test the cbfifo if in DEBUG mode */
 #ifdef DEBUG
     test_cbfifo();
-    test_huffman();
+    test_tx_coders();
 #endif
 
 
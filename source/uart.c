@@ -19,9 +19,17 @@
 #include "cbfifo.h"
 #include "uart.h"
 #include "huffman.h"
+#include "huffman_test.h"
+#include "ans.h"
+#include "range.h"
+#include "tokens.h"
+
+/* The messages of the constant strings are defined here */
+#define FLASH_STRINGS_DATA
+#include "flash_strings.h"
 #include "systick.h"
+#include "sysclock.h"
 
-#define UART_OVERSAMPLE_RATE 	(16)
 #define BUS_CLOCK 				(24e6)
 #define SYS_CLOCK				(24e6)
 
@@ -30,6 +38,65 @@
 #define UART_PARITY				(0)
 #define UART_STOP_BITS			(2)
 
+/* Bits on the line for every byte, the start bit, the data and the stop bits */
+#define UART_FRAME_BITS			(1 + UART_DATA_SIZE + UART_PARITY + UART_STOP_BITS)
+
+/* Oversampling ratios of UART0, both edges are sampled below 8 */
+#define UART_OSR_MIN			(4)
+#define UART_OSR_MAX			(32)
+#define UART_OSR_BOTHEDGE		(8)
+
+/* Largest error of a baud rate the divisors make, in parts per thousand */
+#define UART_BAUD_TOLERANCE		(25)
+
+/* DMA channel which moves the Tx fifo to UART0, and its DMAMUX source UART0 transmit */
+#define TX_DMA_CHANNEL			(0)
+#define TX_DMA_SOURCE			(3)
+
+/*
+ * Most bytes of the Tx fifo handed to the DMA channel at a time. Their room
+ * on the fifo is only freed once all of them are sent
+ */
+#define TX_DMA_SPAN				(64)
+
+/* Number of characters encoded at a time by __sys_write */
+#define TX_CHUNK_SIZE			(16)
+
+/*
+ * Most characters sent in one message. An encoded message is queued whole on
+ * the Tx fifo, and 85 characters encode to at most 255 bytes even if all of
+ * them are escaped. The frame holds longer messages, the receiver takes them
+ */
+#define TX_FRAME_SIZE			(85)
+
+/*
+ * Default size and latency in ms of a batch of writes. Writes are gathered
+ * into one message until the batch is full or its first byte is this old
+ */
+#define TX_BATCH_BYTES			(TX_BATCH_MAX)
+#define TX_BATCH_LATENCY		(50)
+
+#if TX_BATCH_MAX > TX_FRAME_SIZE
+#error "A batch must fit in one message"
+#endif
+
+/* Number of times the benchmark encodes its text with each coder */
+#define BENCH_ROUNDS			(40)
+
+/* Coders measured by the benchmark */
+typedef enum
+{
+	BENCH_STATIC,
+	BENCH_CONTEXT,
+	BENCH_LZ,
+	BENCH_ADAPTIVE,
+	BENCH_RANGE,
+#if HUFFMAN_ANS
+	BENCH_ANS,
+#endif
+	BENCH_CODERS
+} bench_coder_t;
+
 
 /* Structure for the stats */
 struct
@@ -42,17 +109,181 @@ struct
 
 static uint32_t error_counter = 0;
 
+/* Baud rate of the link, changed by set_baud_rate */
+static uint32_t baud_rate = UART_BAUDRATE;
+
+/* Bytes of the Tx fifo the DMA channel is sending, 0 while it is idle */
+static volatile size_t tx_dma_bytes = 0;
+
+/* Adaptive tree of the transmitted messages, used when adaptive_mode is set */
+static huffman_adaptive_t tx_model;
+static bool adaptive_mode = false;
+
+/* Set to code the messages with the range coder when it beats the huffman coders */
+static bool range_mode = false;
+
+/* Set to send a long write as a block with a table of its own when that is smaller */
+static bool block_mode = false;
+
+/*
+ * Set while the messages of a block are sent, they are coded with the block
+ * table, which was built into the runtime table
+ */
+static bool block_table_active = false;
+
+/* Set to continue the bits of the last static message instead of padding them */
+static bool stream_mode = false;
+
+/*
+ * Encoder of the stream, the bits of the last partial byte of its last
+ * message stay in it until the next message or the end of the stream
+ */
+static huffman_encoder_t tx_stream;
+
+/* Set while flush_tx sends the batch, the message ends the stream */
+static bool stream_end = false;
+
+/* Set when tx_model was emptied, the receiver must empty its tree as well */
+static bool model_reset = false;
+
+/*
+ * Number of tables static messages pick from, each message uses the one it
+ * encodes smallest with. The runtime table is added once it is announced
+ */
+static uint8_t tx_tables = HUFFMAN_STATIC_TABLES;
+
+/*
+ * Text sent so far, which the repeats of LZ messages point into. Every
+ * message other than a table goes into it, on both sides of the link
+ */
+static huffman_lz_t tx_history;
+
+/* Set when tx_history was emptied, the next message empties the receiver's history */
+static bool history_reset = true;
+
+/*
+ * Last write sent as one message, 0 bytes when the last message was anything
+ * else. Writes of the same text after it are counted instead of sent
+ */
+static char last_write[TX_FRAME_SIZE];
+static int last_write_size = 0;
+
+/* Writes gathered into the next message, and the time its first byte came */
+static char tx_batch[TX_BATCH_MAX];
+static int tx_batch_size = 0;
+static ticktime_t tx_batch_start;
+
+/* Size and latency of a batch, set by set_batch */
+static int batch_bytes = TX_BATCH_BYTES;
+static ticktime_t batch_latency = TX_BATCH_LATENCY;
+
+/* CRC of the frame being queued */
+static uint16_t tx_crc;
+
+/* Sequence number of the next frame, the receiver finds lost frames by it */
+static uint8_t tx_sequence = 0;
+
+/*
+ * Set by the Rx interrupt when the receiver sent HUFFMAN_LINK_NAK, the coders
+ * start over with a resync frame before the next message
+ */
+static volatile bool resync_requested = false;
+
+/*
+ * Time the Tx fifo last started filling from empty. The time until it
+ * drains again is added to the stats, so idle time is not counted
+ */
+static volatile ticktime_t tx_busy_start;
+
+/* Number of times last_write was written again since it was sent */
+static uint8_t repeat_count = 0;
+
+/* Text encoded by the benchmark, made of the messages the application prints */
+static const char bench_text[] =
+		"Original Bytes = 120\n\rReduced bytes = 71\n\rPercent Reduction = 40 percent\n\r"
+		"Time = 96 ms\n\rTimer and Bytes Reset\n\rSanish Kharade\n\r"
+		"Too many arguments for the stats command\n\r"
+		"Enter help command for syntax of all commands\n\r";
+
+
+/*********************************************************************************
+ * @brief   :   Finds the divisors of the UART clock closest to a baud rate
+ *
+ *              Every oversampling ratio is tried with the SBR closest to
+ *              it, the pair giving the smallest error wins. The higher
+ *              ratio wins a tie, it samples every bit more often
+ *
+ * @param   :   rate	- baud rate
+ * 				sbr		- set to the baud rate modulo divisor
+ * 				osr		- set to the oversampling ratio
+ *
+ * @return  :   uint32_t	- baud rate the divisors make, 0 if none is within
+ * 							  UART_BAUD_TOLERANCE of rate
+*********************************************************************************/
+static uint32_t baud_divisors(uint32_t rate, uint16_t *sbr, uint8_t *osr)
+{
+	uint32_t clock = (uint32_t)SYS_CLOCK;
+	uint32_t best_rate = 0, best_error = UINT32_MAX;
+
+	if(rate == 0 || rate > clock / UART_OSR_MIN)
+		return 0;
+
+	for(uint8_t ratio = UART_OSR_MIN; ratio <= UART_OSR_MAX; ratio++)
+	{
+		uint32_t divisor = (clock + rate * ratio / 2) / (rate * ratio);
+		if(divisor == 0 || divisor > (UART0_BDH_SBR_MASK << 8 | UART0_BDL_SBR_MASK))
+			continue;
+
+		uint32_t actual = clock / (divisor * ratio);
+		uint32_t error = (actual > rate) ? actual - rate : rate - actual;
+		if(error <= best_error)
+		{
+			best_error = error;
+			best_rate = actual;
+			*sbr = divisor;
+			*osr = ratio;
+		}
+	}
+
+	if(best_rate == 0 || (uint64_t)best_error * 1000 > (uint64_t)rate * UART_BAUD_TOLERANCE)
+		return 0;
+	return best_rate;
+}
+
+/*********************************************************************************
+ * @brief   :   Loads the divisors of a baud rate into UART0
+ *
+ *              The transmitter and the receiver must be disabled
+ *
+ * @param   :   rate	- baud rate, which baud_divisors can make
+ *
+ * @return  :   void
+*********************************************************************************/
+static void load_baud_rate(uint32_t rate)
+{
+	uint16_t sbr;
+	uint8_t osr;
+
+	baud_divisors(rate, &sbr, &osr);
+
+	UART0->BDH = (UART0->BDH & ~UART0_BDH_SBR_MASK) | UART0_BDH_SBR(sbr >> 8);
+	UART0->BDL = UART0_BDL_SBR(sbr);
+	UART0->C4 = (UART0->C4 & ~UART0_C4_OSR_MASK) | UART0_C4_OSR(osr - 1);
+	if(osr < UART_OSR_BOTHEDGE)
+		UART0->C5 |= UART0_C5_BOTHEDGE_MASK;
+	else
+		UART0->C5 &= ~UART0_C5_BOTHEDGE_MASK;
+}
 
 /*********************************************************************************
  * @brief   :   Initializes the UART
  *
- * @param   :   baud_rate - baud rate for the UART
+ * @param   :   none
  *
  * @return  :   void
 *********************************************************************************/
 void Init_UART0(void)
 {
-	uint16_t sbr;
 	uint8_t temp;
 
 	// Enable clock gating for UART0 and Port A
@@ -71,11 +302,7 @@ void Init_UART0(void)
 	PORTA->PCR[2] = PORT_PCR_ISF_MASK | PORT_PCR_MUX(2); // Tx
 
 	// Set baud rate and oversampling ratio
-	sbr = (uint16_t)((SYS_CLOCK)/(UART_BAUDRATE * UART_OVERSAMPLE_RATE));
-	UART0->BDH &= ~UART0_BDH_SBR_MASK;
-	UART0->BDH |= UART0_BDH_SBR(sbr>>8);
-	UART0->BDL = UART0_BDL_SBR(sbr);
-	UART0->C4 |= UART0_C4_OSR(UART_OVERSAMPLE_RATE-1);
+	load_baud_rate(baud_rate);
 
 	// Disable interrupts for RX active edge and LIN break detect, select two stop bit
 	UART0->BDH |= UART0_BDH_RXEDGIE(0) | UART0_BDH_SBNS(1) | UART0_BDH_LBKDIE(0);
@@ -96,13 +323,33 @@ void Init_UART0(void)
 	// Send LSB first, do not invert received data
 	UART0->S2 = UART0_S2_MSBF(0) | UART0_S2_RXINV(0);
 
+	/*
+	 * The DMA channel moves a byte to the data register whenever TDRE is set,
+	 * for as long as it has a span of the Tx fifo to send. Byte by byte, one
+	 * transfer per request, and an interrupt once the span is sent
+	 */
+	SIM->SCGC6 |= SIM_SCGC6_DMAMUX_MASK;
+	SIM->SCGC7 |= SIM_SCGC7_DMA_MASK;
+	DMAMUX0->CHCFG[TX_DMA_CHANNEL] = 0;
+	DMA0->DMA[TX_DMA_CHANNEL].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+	DMA0->DMA[TX_DMA_CHANNEL].DAR = (uint32_t)&UART0->D;
+	DMA0->DMA[TX_DMA_CHANNEL].DCR = DMA_DCR_EINT_MASK | DMA_DCR_CS_MASK | DMA_DCR_SINC_MASK |
+									DMA_DCR_SSIZE(1) | DMA_DCR_DSIZE(1) | DMA_DCR_D_REQ_MASK;
+	DMAMUX0->CHCFG[TX_DMA_CHANNEL] = DMAMUX_CHCFG_SOURCE(TX_DMA_SOURCE) | DMAMUX_CHCFG_ENBL_MASK;
+
 	/* Enable interrupts */
 	NVIC_SetPriority(UART0_IRQn, 2); // 0, 1, 2, or 3
 	NVIC_ClearPendingIRQ(UART0_IRQn);
 	NVIC_EnableIRQ(UART0_IRQn);
 
-	// Enable receive interrupts but not transmit interrupts yet
+	NVIC_SetPriority(DMA0_IRQn, 2);
+	NVIC_ClearPendingIRQ(DMA0_IRQn);
+	NVIC_EnableIRQ(DMA0_IRQn);
+
+	// Enable receive interrupts, TDRE requests DMA transfers instead of interrupts
 	UART0->C2 |= UART_C2_RIE(1);
+	UART0->C5 |= UART0_C5_TDMAE(1);
+	UART0->C2 |= UART0_C2_TIE(1);
 
 
 	// Enable UART receiver and transmitter
@@ -141,168 +388,1283 @@ void UART0_IRQHandler(void)
 		// received a character
 		ch = UART0->D;
 
-		if(cbfifo_enqueue(kRx_FIFO, &ch, 1) != 1)
+		/* The receiver lost frames, it is not a character for the application */
+		if(ch == HUFFMAN_LINK_NAK)
 		{
-			/* For bytes that were silently ignored */
-			error_counter++;
+			resync_requested = true;
 		}
-	}
-	/* Transmit Interrupt */
-	if ( (UART0->C2 & UART0_C2_TIE_MASK) && // transmitter interrupt enabled
-			(UART0->S1 & UART0_S1_TDRE_MASK) )
-	{
-
-		if(cbfifo_dequeue(kTx_FIFO, &ch, 1) == 1)//return 0 or 1
-			UART0->D = ch;
-		else
+		else if(cbfifo_enqueue(kRx_FIFO, &ch, 1) != 1)
 		{
-			UART0->C2 &= ~UART0_C2_TIE_MASK;
-			stats.timer += get_timer();
+			/* For bytes that were silently ignored */
+			error_counter++;
 		}
 	}
 }
 
 /*********************************************************************************
- * @brief   :   Function to read data from UART
+ * @brief   :   Hands the next span of the Tx fifo to the DMA channel
  *
- *              This is a predefined function which is being overwritten here.
- *              getchar() will call this function to get data from the UART
+ *              The span is at most TX_DMA_SPAN bytes and stops where the fifo
+ *              wraps around, the bytes after it go in the next span. Nothing
+ *              is done while a span is being sent or the fifo is empty. Must
+ *              be called with the DMA interrupt masked
  *
  * @param   :   none
  *
- * @return  :   int	- character read from user
- * 				-1	- error
+ * @return  :   void
 *********************************************************************************/
-int __sys_readc(void)
+static void start_tx_dma(void)
 {
-	int c;
+	const void *span;
+	size_t nbytes;
 
-	/* Wait until a character is received */
-	while(cbfifo_length(kRx_FIFO) == 0);
+	if(tx_dma_bytes > 0)
+		return;
 
-	if(cbfifo_dequeue(kRx_FIFO, &c, 1))
-		return c;
-	else
-		return -1;
+	nbytes = cbfifo_span(kTx_FIFO, &span);
+	if(nbytes == 0)
+		return;
+	if(nbytes > TX_DMA_SPAN)
+		nbytes = TX_DMA_SPAN;
 
+	tx_dma_bytes = nbytes;
+	DMA0->DMA[TX_DMA_CHANNEL].SAR = (uint32_t)span;
+	DMA0->DMA[TX_DMA_CHANNEL].DSR_BCR = DMA_DSR_BCR_BCR(nbytes);
+	DMA0->DMA[TX_DMA_CHANNEL].DCR |= DMA_DCR_ERQ_MASK;
 }
 
-
 /*********************************************************************************
- * @brief   :   Function to write data onto UART
+ * @brief   :   Interrupt Handler for DMA channel 0, once a span of the Tx
+ *              fifo is sent
  *
- *              This is a predefined function which is being overwritten here.
- *              putchar() and printf() will call this function to print data on the UART
+ *              The span is removed from the fifo and the next one started,
+ *              so the transmitter takes one interrupt per span, not per byte
  *
- * @param   :   handle	- where the data is to be printed
- * 				buf		- character array containing the data
- * 				size	- number of bytes to be printed
+ * @param   :   none
  *
- * @return  :   int	- character read from user
- * 				-1	- error
+ * @return  :   void
 *********************************************************************************/
-int __sys_write(int handle, char *buf, int size)
+void DMA0_IRQHandler(void)
 {
-	//static uint16_t bytes = 0, reduced_bytes = 0;
+	uint32_t status = DMA0->DMA[TX_DMA_CHANNEL].DSR_BCR;
 
-//	if(stats.custom_string == true)
-//	{
-//		stats.bytes += size;
-//	}
-	stats.bytes += size;
-	uint8_t buffer[300]={0};
-	uint32_t bits=0;
-	//size += cbfifo_length(kTx_FIFO);
-	if(cbfifo_enqueue(kTx_FIFO, &size, 1) != 1)
-	{
-		return -1;
-	}
-	size = huffman_encode(buf, buffer, sizeof(buffer));
-	if(cbfifo_enqueue(kTx_FIFO, &size, 1) != 1)
-	{
-		return -1;
-	}
-	if(size % 8 != 0)
+	/* Clear the done and error flags, the request was disabled at the end of the span */
+	DMA0->DMA[TX_DMA_CHANNEL].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+
+	/* A span cut short by a bus error is dropped, the receiver finds the next frame */
+	if(status & (DMA_DSR_BCR_CE_MASK | DMA_DSR_BCR_BES_MASK | DMA_DSR_BCR_BED_MASK))
 	{
-		size = (size/8) + 1;
+		error_counter++;
 	}
+
+	cbfifo_release(kTx_FIFO, tx_dma_bytes);
+	tx_dma_bytes = 0;
+
+	if(cbfifo_length(kTx_FIFO) == 0)
+		stats.timer += now() - tx_busy_start;
 	else
-	{
-		size /= 8;
-	}
-	if(cbfifo_enqueue(kTx_FIFO, &size, 1) != 1)
+		start_tx_dma();
+}
+
+/*********************************************************************************
+ * @brief   :   Enqueues bytes on the Tx fifo and starts the transmitter
+ *
+ *              Waits until there is enough room on the Tx fifo
+ *
+ * @param   :   data	- bytes to be sent
+ * 				nbytes	- number of bytes
+ *
+ * @return  :   int	- 0 on success
+ * 				-1	- error
+*********************************************************************************/
+static int enqueue_tx(void *data, size_t nbytes)
+{
+	size_t enqueued;
+
+	/* Wait until there is enough room on the Tx fifo */
+	while(nbytes > cbfifo_capacity(kTx_FIFO) - cbfifo_length(kTx_FIFO));
+
+	/* The DMA interrupt may not drain the fifo between the check and the enqueue */
+	uint32_t masking_state = __get_PRIMASK();
+	__disable_irq();
+	if(cbfifo_length(kTx_FIFO) == 0)
+		tx_busy_start = now();
+	enqueued = cbfifo_enqueue(kTx_FIFO, data, nbytes);
+
+	/* Tx cbfifo is not empty, start the DMA channel unless it is sending already */
+	start_tx_dma();
+	__set_PRIMASK(masking_state);
+
+	if(enqueued != nbytes)
 	{
 		return -1;
 	}
-//	if(stats.custom_string == true)
-//	{
-//		stats.reduced_bytes += size;
-//		stats.custom_string = false;
-//	}
-	stats.reduced_bytes += size;
-	//stats.custom_string = false;
-	/* Wait until there is enough room on the Tx fifo */
-	while(size >= cbfifo_capacity(kTx_FIFO) - cbfifo_length(kTx_FIFO));
+	return 0;
+}
+
+/*********************************************************************************
+ * @brief   :   Queues the header of a frame and starts its CRC
+ *
+ * @param   :   type	- type byte of the frame
+ * 				size	- original size of the message
+ * 				bits	- number of encoded bits, ceil(bits / 8) bytes follow
+ *
+ * @return  :   int	- 0 on success
+ * 				-1	- error
+*********************************************************************************/
+static int enqueue_frame_header(uint8_t type, uint32_t size, uint32_t bits)
+{
+	uint8_t header[HUFFMAN_FRAME_HEADER_MAX];
+	size_t nbytes = huffman_frame_header(type, tx_sequence++, size, bits, header);
+
+	/* The sync bytes are not part of the CRC */
+	tx_crc = huffman_frame_crc(HUFFMAN_FRAME_CRC_INIT, header + 2, nbytes - 2);
+	return enqueue_tx(header, nbytes);
+}
+
+/*********************************************************************************
+ * @brief   :   Queues bytes of the message of a frame and adds them to its CRC
+ *
+ * @param   :   data	- bytes to queue
+ * 				nbytes	- number of bytes
+ *
+ * @return  :   int	- 0 on success
+ * 				-1	- error
+*********************************************************************************/
+static int enqueue_frame_data(const void *data, size_t nbytes)
+{
+	/* A repeat has no message, and the fifo takes no NULL buffer */
+	if(nbytes == 0)
+		return 0;
+
+	tx_crc = huffman_frame_crc(tx_crc, data, nbytes);
+	return enqueue_tx((void *)data, nbytes);
+}
+
+/*********************************************************************************
+ * @brief   :   Queues the CRC which ends a frame
+ *
+ * @param   :   none
+ *
+ * @return  :   int	- 0 on success
+ * 				-1	- error
+*********************************************************************************/
+static int enqueue_frame_crc(void)
+{
+	uint8_t crc[HUFFMAN_FRAME_CRC_BYTES] = { tx_crc >> 8, tx_crc & 0xFF };
+
+	return enqueue_tx(crc, sizeof(crc));
+}
 
-	if(cbfifo_enqueue(kTx_FIFO, buffer, size) != size)
+/*********************************************************************************
+ * @brief   :   Queues a whole frame
+ *
+ * @param   :   type	- type byte of the frame
+ * 				size	- original size of the message
+ * 				bits	- number of encoded bits
+ * 				data	- the ceil(bits / 8) bytes of the message
+ *
+ * @return  :   int	- 0 on success
+ * 				-1	- error
+*********************************************************************************/
+static int enqueue_frame(uint8_t type, uint32_t size, uint32_t bits, const void *data)
+{
+	if(enqueue_frame_header(type, size, bits) != 0 || enqueue_frame_data(data, (bits + 7) / 8) != 0)
 	{
 		return -1;
 	}
+	return enqueue_frame_crc();
+}
+
+/*********************************************************************************
+ * @brief   :   Ends the stream, the bits left over from its last message
+ *              are sent padded in a frame of their own
+ *
+ *              Every other frame is sent after the end of the stream, so the
+ *              receiver has decoded every character before it
+ *
+ * @param   :   none
+ *
+ * @return  :   int	- 0 on success
+ * 				-1	- error
+*********************************************************************************/
+static int end_stream(void)
+{
+	uint8_t last;
+	uint8_t bits = tx_stream.bit_count;
+
+	if(huffman_encoder_pad(&tx_stream, &last, sizeof(last)) == 0)
+		return 0;
+
+	/* Frame - stream type, no new characters, the bits left over */
+	stats.reduced_bytes += sizeof(last);
+	return enqueue_frame(HUFFMAN_FRAME_STREAM | HUFFMAN_FRAME_TYPE(0, tx_stream.table), 0, bits, &last);
+}
+
+/*********************************************************************************
+ * @brief   :   Does one step of the rebuild of the runtime code table
+ *
+ *              Once the table is rebuilt its code lengths are queued as a
+ *              table message, and the next static messages may use it. The
+ *              receiver has the table before any message encoded with it.
+ *              Nothing is done while the Tx fifo has no room for the table.
+ *
+ * @param   :   none
+ *
+ * @return  :   void
+*********************************************************************************/
+static void rebuild_table(void)
+{
+	uint8_t message[HUFFMAN_TABLE_BYTES];
 
+	if(cbfifo_capacity(kTx_FIFO) - cbfifo_length(kTx_FIFO) <
+			HUFFMAN_FRAME_BYTES(HUFFMAN_TABLE_BYTES, 8 * HUFFMAN_TABLE_BYTES))
+		return;
 
-//	if(cbfifo_enqueue(kTx_FIFO, buf, size) != size)
-//	{
-//		return -1;
-//	}
+	if(!huffman_rebuild_step(tx_tables))
+		return;
 
-	/* If Tx cbfifo is not empty, enable the transmit interrupt */
-	if (cbfifo_length(kTx_FIFO))
+	/* Frame - table type with the new ID, table size, 8 bits for every byte of the table */
+	uint8_t table = huffman_runtime_table();
+	size_t nbytes = huffman_export_table(table, message, sizeof(message));
+	if(enqueue_frame(HUFFMAN_FRAME_TYPE(HUFFMAN_FRAME_TABLE, table), nbytes, 8 * nbytes, message) != 0)
 	{
-		UART0->C2 |= UART0_C2_TIE(1);
-		reset_timer();
-		return 0;
+		/* The receiver does not have the table the runtime table was replaced with */
+		tx_tables = HUFFMAN_STATIC_TABLES;
+		return;
 	}
-	else
+	tx_tables = HUFFMAN_STATIC_TABLES + 1;
+}
+
+/*********************************************************************************
+ * @brief   :   Builds and announces a table for a block of messages
+ *
+ *              The block is counted whole and its table built before any of
+ *              its messages is encoded. The table is only announced when the
+ *              block and the table together are smaller than the block with
+ *              the tables in use, otherwise the block is sent as usual. The
+ *              block table is built into the runtime table, which stays in
+ *              use after the block until the next rebuild replaces it.
+ *
+ * @param   :   buf		- character array containing the block
+ * 				size	- number of bytes in the block
+ *
+ * @return  :   bool	- true if the messages of the block are to be
+ * 						  coded with the block table
+*********************************************************************************/
+static bool send_block_table(char *buf, int size)
+{
+	uint8_t message[HUFFMAN_TABLE_BYTES];
+	size_t nbytes;
+
+	/* The stream has to end with the table it started with */
+	if(tx_stream.table >= HUFFMAN_STATIC_TABLES && end_stream() != 0)
+		return false;
+
+	nbytes = huffman_build_block_table((uint8_t *)buf, size, tx_tables, message, sizeof(message));
+	if(nbytes == 0)
+		return false;
+
+	/* Frame - table type, table size, 8 bits for every byte of the table */
+	if(end_stream() != 0 ||
+			enqueue_frame(HUFFMAN_FRAME_TYPE(HUFFMAN_FRAME_TABLE, huffman_runtime_table()), nbytes, 8 * nbytes, message) != 0)
 	{
-		// queue is empty so disable transmitter interrupt
-		UART0->C2 &= ~UART0_C2_TIE_MASK;
-		return 0;
+		/* The receiver does not have the table the runtime table was replaced with */
+		tx_tables = HUFFMAN_STATIC_TABLES;
+		return false;
 	}
+	tx_tables = HUFFMAN_STATIC_TABLES + 1;
+
+	/* The table is part of what the block costs */
+	stats.reduced_bytes += nbytes;
+	return true;
 }
-/*
- * Stat functions are included in the UART file because
- * all of them are stats related to the UART
- *
- * */
 
 /*********************************************************************************
- * @brief   :   Resets the data and time stats to zero
+ * @brief   :   Sends the repeats of the last write counted so far
+ *
+ *              The receiver prints the message it decoded last as many
+ *              more times. It is called before anything else is sent, so
+ *              the repeats come out in their place
  *
  * @param   :   none
  *
- * @return  :   void
+ * @return  :   int	- 0 on success
+ * 				-1	- error
 *********************************************************************************/
-void reset_stats(void)
+static int flush_repeats(void)
 {
-	stats.bytes = 0;
-	stats.reduced_bytes = 0;
-	stats.timer = 0;
+	if(repeat_count == 0)
+		return 0;
+
+	/* Frame - repeat type, number of repeats, no bits */
+	uint8_t count = repeat_count;
+
+	repeat_count = 0;
+	if(end_stream() != 0)
+		return -1;
+	stats.reduced_bytes += HUFFMAN_FRAME_BYTES(count, 0);
+	return enqueue_frame(HUFFMAN_FRAME_REPEAT, count, 0, NULL);
 }
+
 /*********************************************************************************
- * @brief   :   Prints the data and time stats to zero
+ * @brief   :   Starts every stateful coder over after the receiver lost frames
+ *
+ *              The adaptive tree, the LZ history, the stream and the runtime
+ *              table the receiver holds may not match ours any more. All of
+ *              them are dropped, and a resync frame tells the receiver to do
+ *              the same. The runtime table is used again once the next
+ *              rebuild announces it. The bits left in the stream and the
+ *              repeats counted so far are lost, as the frames before them were
  *
  * @param   :   none
  *
- * @return  :   void
+ * @return  :   int	- 0 on success
+ * 				-1	- error
 *********************************************************************************/
-void print_stats(void)
+static int resync_tx(void)
 {
-	uint8_t buff[200]={0};
-	uint8_t reduction = ((stats.bytes - stats.reduced_bytes)*100)/ stats.bytes;
-	sprintf(buff, "Original Bytes = %d\n\rReduced bytes = %d\n\rPercent Reduction = %d percent\n\rTime = %d ms\n\r",stats.bytes, stats.reduced_bytes, reduction, stats.timer);
+	resync_requested = false;
+
+	huffman_encoder_init_table(&tx_stream, 0);
+	repeat_count = 0;
+	last_write_size = 0;
+	huffman_adaptive_reset(&tx_model);
+	model_reset = true;
+	huffman_lz_reset(&tx_history);
+	history_reset = true;
+	tx_tables = HUFFMAN_STATIC_TABLES;
+	block_table_active = false;
 
-	printf("%s", buff);
+	/* Frame - resync type, no message */
+	if(enqueue_frame(HUFFMAN_FRAME_RESYNC, 0, 0, NULL) != 0)
+	{
+		resync_requested = true;
+		return -1;
+	}
+	return 0;
 }
+
+/*********************************************************************************
+ * @brief   :   Function to read data from UART
+ *
+ *              This is a predefined function which is being overwritten here.
+ *              getchar() will call this function to get data from the UART
+ *
+ * @param   :   none
+ *
+ * @return  :   int	- character read from user
+ * 				-1	- error
+*********************************************************************************/
+int __sys_readc(void)
+{
+	int c;
+
+	/* Nothing is held back while waiting for input */
+	flush_tx();
+
+	/* Wait until a character is received, rebuilding the code table meanwhile */
+	while(cbfifo_length(kRx_FIFO) == 0)
+	{
+		if(resync_requested)
+			resync_tx();
+		rebuild_table();
+	}
+
+	if(cbfifo_dequeue(kRx_FIFO, &c, 1))
+		return c;
+	else
+		return -1;
+
+}
+
+
+/*********************************************************************************
+ * @brief   :   Encodes one message of the stream and queues it with its header
+ *
+ *              The message continues the bits the last one left in the
+ *              encoder, and only its whole bytes are sent. Its last partial
+ *              byte goes out with the next message, or padded in this frame
+ *              when flush_tx sends it
+ *
+ * @param   :   buf		- character array containing the data
+ * 				size	- number of bytes, at most TX_FRAME_SIZE
+ * 				table	- ID of the table
+ *
+ * @return  :   int	- 0 on success
+ * 				-1	- error
+*********************************************************************************/
+static int write_stream(char *buf, int size, uint8_t table)
+{
+	uint8_t buffer[HUFFMAN_ENCODED_SIZE(TX_FRAME_SIZE)];
+	size_t nbytes;
+	uint32_t bits;
+
+	if(tx_stream.bit_count == 0)
+		huffman_encoder_init_table(&tx_stream, table);
+	else
+		huffman_encoder_next_message(&tx_stream, table);
+
+	nbytes = huffman_encoder_feed(&tx_stream, (uint8_t *)buf, size, buffer, sizeof(buffer));
+	nbytes += huffman_encoder_end_message(&tx_stream, buffer + nbytes, sizeof(buffer) - nbytes);
+	bits = 8 * nbytes;
+
+	if(stream_end)
+	{
+		bits += tx_stream.bit_count;
+		nbytes += huffman_encoder_pad(&tx_stream, buffer + nbytes, sizeof(buffer) - nbytes);
+	}
+
+	/* The counts are used to rebuild the table while the device is idle */
+	huffman_count((uint8_t *)buf, size);
+
+	/* Frame - stream type, original size and the bits of the whole bytes */
+	if(enqueue_frame(HUFFMAN_FRAME_STREAM | HUFFMAN_FRAME_TYPE(0, tx_stream.table), size, bits, buffer) != 0)
+	{
+		return -1;
+	}
+
+	stats.bytes += size;
+	stats.reduced_bytes += nbytes;
+
+	return 0;
+}
+
+/*********************************************************************************
+ * @brief   :   Encodes one message and queues it with its header
+ *
+ *              The data is encoded in small chunks which are queued as soon as
+ *              they are encoded. In static mode the message is first encoded
+ *              whole with repeats of the earlier messages, and that is sent
+ *              when it beats the best table and the order-1 coder. With
+ *              HUFFMAN_ANS the best table also codes it whole with tANS,
+ *              which is sent when it beats the huffman code. In range mode
+ *              the same goes for the range coder. A message which would not
+ *              get smaller is sent as its raw bytes. In stream mode a static
+ *              message continues the stream instead.
+ *
+ * @param   :   buf		- character array containing the data
+ * 				size	- number of bytes, at most TX_FRAME_SIZE
+ * 				tokens	- true if buf holds a format string ID and its
+ * 						  arguments packed by tokens_pack
+ *
+ * @return  :   int	- 0 on success
+ * 				-1	- error
+*********************************************************************************/
+static int write_frame(char *buf, int size, bool tokens)
+{
+	huffman_encoder_t encoder;
+	uint8_t buffer[HUFFMAN_ENCODED_SIZE(TX_CHUNK_SIZE)];
+	uint8_t whole_buffer[HUFFMAN_ENCODED_SIZE(TX_FRAME_SIZE)];
+	uint8_t type = HUFFMAN_FRAME_STATIC;
+	uint32_t bits = 0;
+	uint32_t reduced_size = 0;
+	size_t nbytes, whole_bytes = 0;
+
+	if(resync_requested && resync_tx() != 0)
+	{
+		return -1;
+	}
+
+	/*
+	 * In stream mode a static message continues the stream unless it is
+	 * smaller stored, anything else ends the stream first. The receiver decodes the bits
+	 * left over from the last message with its table once the first byte of
+	 * this one comes, so a message too short to fill a byte keeps the table
+	 */
+	if(stream_mode && !adaptive_mode && !tokens && !block_table_active)
+	{
+		uint8_t table = huffman_select_table((uint8_t *)buf, size, tx_tables, &bits);
+
+		if(tx_stream.bit_count > 0 && table != tx_stream.table && tx_stream.bit_count + bits < 8)
+		{
+			table = tx_stream.table;
+			bits = huffman_encoded_bits(table, (uint8_t *)buf, size);
+		}
+
+		/* Sending the message stored costs the frame which ends the stream as well */
+		uint32_t stored_bits = 8 * size;
+		if(tx_stream.bit_count > 0)
+			stored_bits += 8 * HUFFMAN_FRAME_BYTES(0, tx_stream.bit_count);
+
+		if(bits < stored_bits)
+			return write_stream(buf, size, table);
+	}
+
+	if(end_stream() != 0)
+	{
+		return -1;
+	}
+
+	/*
+	 * The size of an adaptive message is only known once it is encoded,
+	 * so it is encoded whole before its header is sent
+	 */
+	if(adaptive_mode)
+	{
+		type = HUFFMAN_FRAME_ADAPTIVE;
+		if(model_reset)
+		{
+			type |= HUFFMAN_FRAME_RESET;
+			model_reset = false;
+		}
+		huffman_encoder_init_adaptive(&encoder, &tx_model);
+		whole_bytes = huffman_encoder_feed(&encoder, (uint8_t *)buf, size, whole_buffer, sizeof(whole_buffer));
+		whole_bytes += huffman_encoder_flush(&encoder, whole_buffer + whole_bytes, sizeof(whole_buffer) - whole_bytes);
+		bits = encoder.total_bits;
+
+		/* The receiver adds the decoded message to its history as well */
+		huffman_lz_append(&tx_history, (uint8_t *)buf, size);
+	}
+	else
+	{
+		uint8_t table = huffman_runtime_table();
+		uint32_t context_bits = huffman_context_bits((uint8_t *)buf, size);
+
+		/* The messages of a block use its table, which the receiver already has */
+		if(block_table_active)
+			bits = huffman_encoded_bits(table, (uint8_t *)buf, size);
+		else
+			table = huffman_select_table((uint8_t *)buf, size, tx_tables, &bits);
+
+		/* Encoding with repeats also adds the message to the history, whatever is sent */
+		if(history_reset)
+			huffman_lz_reset(&tx_history);
+		huffman_encoder_init_lz(&encoder, table, &tx_history);
+		whole_bytes = huffman_encoder_feed(&encoder, (uint8_t *)buf, size, whole_buffer, sizeof(whole_buffer));
+		whole_bytes += huffman_encoder_flush(&encoder, whole_buffer + whole_bytes, sizeof(whole_buffer) - whole_bytes);
+
+		/* The first message after a reset is always an LZ one, it carries the reset */
+		if(history_reset || (encoder.total_bits < bits && encoder.total_bits < context_bits))
+		{
+			bits = encoder.total_bits;
+			type = HUFFMAN_FRAME_TYPE(HUFFMAN_FRAME_LZ, table);
+			if(history_reset)
+			{
+				type |= HUFFMAN_FRAME_RESET;
+				history_reset = false;
+			}
+		}
+		/* The order-1 coder is used when it beats the best single table */
+		else if(context_bits < bits)
+		{
+			bits = context_bits;
+			type = HUFFMAN_FRAME_CONTEXT;
+			huffman_encoder_init_context(&encoder);
+		}
+		else
+		{
+			type = HUFFMAN_FRAME_TYPE(HUFFMAN_FRAME_STATIC, table);
+			huffman_encoder_init_table(&encoder, table);
+#if HUFFMAN_ANS
+			/* The repeats are not needed any more, the buffer takes the tANS message */
+			uint32_t ans_bits;
+			size_t ans_bytes = ans_encode_table(table, (uint8_t *)buf, size, whole_buffer, sizeof(whole_buffer), &ans_bits);
+
+			if(ans_bytes > 0 && ans_bits < bits)
+			{
+				bits = ans_bits;
+				whole_bytes = ans_bytes;
+				type = HUFFMAN_FRAME_TYPE(HUFFMAN_FRAME_ANS, table);
+			}
+#endif
+		}
+
+		/* In range mode a message without repeats is also coded whole with the range coder */
+		if(range_mode && HUFFMAN_FRAME_KIND(type) != HUFFMAN_FRAME_LZ && HUFFMAN_FRAME_KIND(type) != HUFFMAN_FRAME_ANS)
+		{
+			uint32_t range_bits;
+			size_t range_bytes = range_encode_table(table, (uint8_t *)buf, size, whole_buffer, sizeof(whole_buffer), &range_bits);
+
+			if(range_bytes > 0 && range_bits < bits)
+			{
+				bits = range_bits;
+				whole_bytes = range_bytes;
+				type = HUFFMAN_FRAME_TYPE(HUFFMAN_FRAME_RANGE, table);
+			}
+		}
+	}
+
+	/*
+	 * A message which does not get smaller is sent as it is. It keeps its
+	 * kind, as the receiver adds it to the adaptive tree or history the same
+	 */
+	reduced_size = (bits + 7) / 8;
+	if(reduced_size >= size)
+	{
+		type |= HUFFMAN_FRAME_TYPE(0, HUFFMAN_STORED_ID);
+		bits = 8 * size;
+		reduced_size = size;
+	}
+
+	if(tokens)
+		type |= HUFFMAN_FRAME_TOKENS;
+
+	/* The counts are used to rebuild the table while the device is idle */
+	huffman_count((uint8_t *)buf, size);
+
+	/* Header - message type, original size and encoded bits */
+	if(enqueue_frame_header(type, size, bits) != 0)
+	{
+		return -1;
+	}
+
+	if(HUFFMAN_FRAME_STORED(type))
+	{
+		if(enqueue_frame_data(buf, size) != 0)
+		{
+			return -1;
+		}
+	}
+	/* Adaptive, LZ, tANS and range coder messages are already encoded */
+	else if(HUFFMAN_FRAME_KIND(type) == HUFFMAN_FRAME_ADAPTIVE || HUFFMAN_FRAME_KIND(type) == HUFFMAN_FRAME_LZ ||
+			HUFFMAN_FRAME_KIND(type) == HUFFMAN_FRAME_ANS || HUFFMAN_FRAME_KIND(type) == HUFFMAN_FRAME_RANGE)
+	{
+		if(enqueue_frame_data(whole_buffer, whole_bytes) != 0)
+		{
+			return -1;
+		}
+	}
+	else
+	{
+		for(int i = 0; i < size; i += TX_CHUNK_SIZE)
+		{
+			int chunk = (size - i < TX_CHUNK_SIZE) ? (size - i) : TX_CHUNK_SIZE;
+
+			nbytes = huffman_encoder_feed(&encoder, (uint8_t *)buf + i, chunk, buffer, sizeof(buffer));
+			if(enqueue_frame_data(buffer, nbytes) != 0)
+			{
+				return -1;
+			}
+		}
+
+		nbytes = huffman_encoder_flush(&encoder, buffer, sizeof(buffer));
+		if(enqueue_frame_data(buffer, nbytes) != 0)
+		{
+			return -1;
+		}
+	}
+
+	if(enqueue_frame_crc() != 0)
+	{
+		return -1;
+	}
+
+	stats.bytes += size;
+	stats.reduced_bytes += reduced_size;
+
+	return 0;
+}
+
+/*********************************************************************************
+ * @brief   :   Sends data as messages, right away
+ *
+ *              Data longer than TX_FRAME_SIZE is sent as several messages,
+ *              so there is no limit on the size of the data. In block mode
+ *              they may all be coded with a table built for the data
+ *
+ *              A write of the same text as the last one is only counted,
+ *              up to 255 of them go out as a single repeat message. So an
+ *              error printed over and over in a loop takes 9 bytes for
+ *              every 255 lines. The repeats are sent before any other
+ *              message and when the application waits for input
+ *
+ * @param   :   buf		- character array containing the data
+ * 				size	- number of bytes to be sent
+ *
+ * @return  :   int	- 0 on success
+ * 				-1	- error
+*********************************************************************************/
+static int send_write(char *buf, int size)
+{
+	if(size > 0 && size == last_write_size && memcmp(buf, last_write, size) == 0)
+	{
+		stats.bytes += size;
+		if(++repeat_count == UINT8_MAX)
+			return flush_repeats();
+		return 0;
+	}
+
+	if(flush_repeats() != 0)
+		return -1;
+
+	/* Only a write sent as one message can be repeated */
+	last_write_size = 0;
+	if(size <= TX_FRAME_SIZE)
+	{
+		memcpy(last_write, buf, size);
+		last_write_size = size;
+	}
+
+	/* In block mode a write longer than a message may get a table of its own */
+	block_table_active = block_mode && !adaptive_mode && size > TX_FRAME_SIZE && send_block_table(buf, size);
+
+	for(int i = 0; i < size; i += TX_FRAME_SIZE)
+	{
+		int frame = (size - i < TX_FRAME_SIZE) ? (size - i) : TX_FRAME_SIZE;
+
+		if(write_frame(buf + i, frame, false) != 0)
+		{
+			block_table_active = false;
+			return -1;
+		}
+	}
+
+	block_table_active = false;
+	return 0;
+}
+
+/*********************************************************************************
+ * @brief   :   Sends the writes gathered in the batch as one message
+ *
+ * @param   :   none
+ *
+ * @return  :   int	- 0 on success
+ * 				-1	- error
+*********************************************************************************/
+static int flush_batch(void)
+{
+	int size = tx_batch_size;
+
+	if(size == 0)
+		return 0;
+
+	tx_batch_size = 0;
+	return send_write(tx_batch, size);
+}
+
+/*********************************************************************************
+ * @brief   :   Function to write data onto UART
+ *
+ *              This is a predefined function which is being overwritten here.
+ *              putchar() and printf() will call this function to print data on the UART
+ *
+ *              printf sends a line in several small writes, and every
+ *              message costs a frame and the padding of its last byte. So
+ *              the writes are gathered into a batch which is sent as one
+ *              message once it holds batch_bytes, once its first byte is
+ *              batch_latency ms old, checked against the SysTick ticks at
+ *              the next write, or when flush_tx is called. The application
+ *              waiting for input flushes it as well. A write which does not
+ *              fit the batch is sent after it, one as long as a batch on
+ *              its own.
+ *
+ * @param   :   handle	- where the data is to be printed
+ * 				buf		- character array containing the data
+ * 				size	- number of bytes to be printed
+ *
+ * @return  :   int	- 0 on success
+ * 				-1	- error
+*********************************************************************************/
+int __sys_write(int handle, char *buf, int size)
+{
+	if(tx_batch_size > 0 && now() - tx_batch_start >= batch_latency && flush_batch() != 0)
+		return -1;
+
+	if(tx_batch_size + size > batch_bytes)
+	{
+		if(flush_batch() != 0)
+			return -1;
+		if(size >= batch_bytes)
+			return send_write(buf, size);
+	}
+
+	if(tx_batch_size == 0)
+		tx_batch_start = now();
+	memcpy(tx_batch + tx_batch_size, buf, size);
+	tx_batch_size += size;
+
+	/* Without a latency nothing waits for the next write */
+	if(tx_batch_size >= batch_bytes || batch_latency == 0)
+		return flush_batch();
+	return 0;
+}
+
+/*********************************************************************************
+ * @brief   :   Sends everything held back, the batch and the repeats
+ *
+ *              Stands in for fflush(stdout), which does not reach the UART
+ *              as Redlib does not buffer stdout
+ *
+ * @param   :   none
+ *
+ * @return  :   int	- 0 on success
+ * 				-1	- error
+*********************************************************************************/
+int flush_tx(void)
+{
+	int result;
+
+	/* The batch is the last message for now, it ends the stream */
+	stream_end = true;
+	result = flush_batch();
+	stream_end = false;
+
+	if(result != 0 || flush_repeats() != 0)
+		return -1;
+	return end_stream();
+}
+
+/*********************************************************************************
+ * @brief   :   Sets the size and latency of a batch of writes
+ *
+ *              The batch held so far is sent first. A size of 0 or a latency
+ *              of 0 sends every write as it comes
+ *
+ * @param   :   bytes	- most bytes in a batch, at most TX_BATCH_MAX
+ * 				latency	- most ms the first byte of a batch waits
+ *
+ * @return  :   bool	- false if bytes is too large, nothing is changed
+*********************************************************************************/
+bool set_batch(int bytes, uint32_t latency)
+{
+	if(bytes < 0 || bytes > TX_BATCH_MAX)
+		return false;
+
+	flush_batch();
+	batch_bytes = bytes;
+	batch_latency = latency;
+	return true;
+}
+
+/*********************************************************************************
+ * @brief   :   Finds the baud rate UART0 can run at closest to a rate
+ *
+ * @param   :   rate	- baud rate asked for
+ *
+ * @return  :   uint32_t	- baud rate the divisors of the UART clock make,
+ * 							  0 if it is too far from rate
+*********************************************************************************/
+uint32_t check_baud_rate(uint32_t rate)
+{
+	uint16_t sbr;
+	uint8_t osr;
+
+	return baud_divisors(rate, &sbr, &osr);
+}
+
+/*********************************************************************************
+ * @brief   :   Returns the baud rate of the link
+ *
+ * @param   :   none
+ *
+ * @return  :   uint32_t	- baud rate last set
+*********************************************************************************/
+uint32_t get_baud_rate(void)
+{
+	return baud_rate;
+}
+
+/*********************************************************************************
+ * @brief   :   Switches UART0 to another baud rate
+ *
+ *              Everything held back is sent and the last byte leaves the
+ *              shift register at the old rate first. The bytes received
+ *              so far are dropped, they may be garbled by the switch
+ *
+ * @param   :   rate	- baud rate, check_baud_rate must accept it
+ *
+ * @return  :   void
+*********************************************************************************/
+void set_baud_rate(uint32_t rate)
+{
+	uint8_t ch;
+
+	flush_tx();
+	while(cbfifo_length(kTx_FIFO) > 0 || !(UART0->S1 & UART0_S1_TC_MASK))
+		;
+
+	UART0->C2 &= ~UART0_C2_TE_MASK & ~UART0_C2_RE_MASK;
+	load_baud_rate(rate);
+	baud_rate = rate;
+	UART0->C2 |= UART0_C2_RE(1) | UART0_C2_TE(1);
+
+	while(cbfifo_dequeue(kRx_FIFO, &ch, 1) == 1)
+		;
+}
+
+/*********************************************************************************
+ * @brief   :   Waits for a character, dropping anything else received
+ *
+ * @param   :   c		- character to wait for
+ * 				timeout	- most ms to wait
+ *
+ * @return  :   bool	- true if c was received in time
+*********************************************************************************/
+bool wait_for_char(uint8_t c, uint32_t timeout)
+{
+	ticktime_t start = now();
+	uint8_t ch;
+
+	while(now() - start < timeout)
+	{
+		if(cbfifo_dequeue(kRx_FIFO, &ch, 1) == 1 && ch == c)
+			return true;
+	}
+	return false;
+}
+
+/*********************************************************************************
+ * @brief   :   Prints the baud rate of the link and the bytes it could carry a
+ *              second at most, with no gap between the bytes
+ *
+ * @param   :   none
+ *
+ * @return  :   void
+*********************************************************************************/
+void print_baud_rate(void)
+{
+	uint32_t rate = check_baud_rate(baud_rate);
+
+	print_token(FORMAT_BAUD, (unsigned long)rate, (unsigned long)(rate / UART_FRAME_BITS));
+}
+
+/*********************************************************************************
+ * @brief   :   Prints a format string of format_strings.h as a token
+ *
+ *              The ID of the format string and its arguments are packed and
+ *              sent as one message, which the receiver renders from its copy
+ *              of format_strings.h. Arguments which do not fit in a message
+ *              are formatted and sent as text instead.
+ *
+ * @param   :   format	- ID of the format string
+ * 				...		- arguments of the format string
+ *
+ * @return  :   int	- 0 on success
+ * 				-1	- error
+*********************************************************************************/
+int print_token(format_id_t format, ...)
+{
+	uint8_t buffer[TX_FRAME_SIZE];
+	va_list args;
+
+	/* The receiver repeats what it decoded last, which is not the last write any more */
+	if(flush_tx() != 0)
+		return -1;
+	last_write_size = 0;
+
+	va_start(args, format);
+	size_t size = tokens_pack(buffer, sizeof(buffer), format, args);
+	va_end(args);
+
+	if(size == 0)
+	{
+		va_start(args, format);
+		vprintf(format_strings[format], args);
+		va_end(args);
+		return 0;
+	}
+
+	return write_frame((char *)buffer, size, true);
+}
+
+/*********************************************************************************
+ * @brief   :   Prints a constant string of flash_strings.h
+ *
+ *              The messages of the string were encoded when the firmware was
+ *              built, they are queued on the Tx fifo as they are. Only their
+ *              headers are made again, with the sequence numbers of the link
+ *              and the CRCs which go with them. They are not added to the LZ
+ *              history or counted for the rebuild.
+ *
+ * @param   :   id	- ID of the string
+ *
+ * @return  :   int	- 0 on success
+ * 				-1	- error
+*********************************************************************************/
+int print_flash_string(uint8_t id)
+{
+	if(id >= FLASH_STRING_COUNT || flush_tx() != 0)
+	{
+		return -1;
+	}
+	last_write_size = 0;
+
+	for(uint16_t i = flash_string_offsets[id]; i < flash_string_offsets[id + 1]; )
+	{
+		/* The frames are stored whole, with their headers and CRCs */
+		const uint8_t *message = &flash_string_messages[i];
+		uint8_t type, sequence;
+		uint32_t size, bits;
+		int header = huffman_frame_parse(message, flash_string_offsets[id + 1] - i, &type, &sequence, &size, &bits);
+
+		if(header <= 0)
+		{
+			return -1;
+		}
+
+		uint16_t nbytes = header + (bits + 7) / 8 + HUFFMAN_FRAME_CRC_BYTES;
+		if(enqueue_frame(type, size, bits, message + header) != 0)
+		{
+			return -1;
+		}
+
+		stats.bytes += size;
+		stats.reduced_bytes += (bits + 7) / 8;
+		i += nbytes;
+	}
+
+	return 0;
+}
+
+/*********************************************************************************
+ * @brief   :   Selects the huffman coder for the next messages
+ *
+ *              The adaptive tree starts empty whenever adaptive mode is
+ *              selected, and the next message tells the receiver to do the same
+ *
+ * @param   :   adaptive	- true for the adaptive coder, false for the static table
+ *
+ * @return  :   void
+*********************************************************************************/
+void set_adaptive_mode(bool adaptive)
+{
+	if(adaptive && !adaptive_mode)
+	{
+		huffman_adaptive_reset(&tx_model);
+		model_reset = true;
+	}
+	adaptive_mode = adaptive;
+}
+
+/*********************************************************************************
+ * @brief   :   Selects the range coder for the next messages in static mode
+ *
+ *              The range coder takes a few more cycles per character than
+ *              huffman for a few percent fewer bytes, which pays off on the
+ *              slow link. A message is still sent with a huffman coder when
+ *              that is smaller
+ *
+ * @param   :   range	- true to try the range coder on every message
+ *
+ * @return  :   void
+*********************************************************************************/
+void set_range_mode(bool range)
+{
+	range_mode = range;
+}
+
+/*********************************************************************************
+ * @brief   :   Selects block tables for long writes in static mode
+ *
+ *              A write longer than a message is counted whole and sent with
+ *              a table built from its counts, announced in front of it, when
+ *              the table saves more than it costs. Otherwise the write is
+ *              sent with the tables in use
+ *
+ * @param   :   block	- true to try a block table on every long write
+ *
+ * @return  :   void
+*********************************************************************************/
+void set_block_mode(bool block)
+{
+	block_mode = block;
+}
+
+/*********************************************************************************
+ * @brief   :   Selects the bit stream for static messages
+ *
+ *              The messages of a stream are not padded to a byte, the next
+ *              message continues their last bits. The stream ends with
+ *              padding when the application waits for input or anything
+ *              else is sent. Messages of the stream stay out of the history
+ *
+ * @param   :   stream	- true to continue the stream with every static message
+ *
+ * @return  :   void
+*********************************************************************************/
+void set_stream_mode(bool stream)
+{
+	if(!stream)
+		end_stream();
+	stream_mode = stream;
+}
+
+/*********************************************************************************
+ * @brief   :   Empties the history of the LZ messages
+ *
+ *              The next message tells the receiver to empty its history as well
+ *
+ * @param   :   none
+ *
+ * @return  :   void
+*********************************************************************************/
+void reset_tx_history(void)
+{
+	huffman_lz_reset(&tx_history);
+	history_reset = true;
+}
+
+/*
+ * Stat functions are included in the UART file because
+ * all of them are stats related to the UART
+ *
+ * */
+
+/*********************************************************************************
+ * @brief   :   Resets the data and time stats to zero
+ *
+ * @param   :   none
+ *
+ * @return  :   void
+*********************************************************************************/
+void reset_stats(void)
+{
+	stats.bytes = 0;
+	stats.reduced_bytes = 0;
+	stats.timer = 0;
+}
+/*********************************************************************************
+ * @brief   :   Prints the data and time stats to zero
+ *
+ * @param   :   none
+ *
+ * @return  :   void
+*********************************************************************************/
+void print_stats(void)
+{
+	uint8_t reduction = ((stats.bytes - stats.reduced_bytes)*100)/ stats.bytes;
+
+	/* Bytes the link carried a second while it was sending */
+	uint32_t throughput = stats.timer ? (uint32_t)stats.reduced_bytes * 1000 / stats.timer : 0;
+
+	print_token(FORMAT_STATS, stats.bytes, stats.reduced_bytes, reduction, stats.timer, (unsigned long)throughput);
+}
+/*********************************************************************************
+ * @brief   :   Measures the speed and compression of the huffman coders
+ *
+ *              Encodes the benchmark text BENCH_ROUNDS times with the best
+ *              static table, with the order-1 coder, with repeats and with the
+ *              adaptive tree, and prints the cycles spent per byte and the
+ *              encoded bits per character of each. The repeats are found in
+ *              messages of TX_FRAME_SIZE characters, each round starting from
+ *              an empty history. The range coder, and the tANS coder with
+ *              HUFFMAN_ANS, encode the same messages with the best static table. The runs use
+ *              tx_history and tx_model, which are emptied again afterwards.
+ *
+ * @param   :   none
+ *
+ * @return  :   void
+*********************************************************************************/
+void print_benchmark(void)
+{
+	huffman_encoder_t encoder;
+	uint8_t buffer[HUFFMAN_ENCODED_SIZE(TX_FRAME_SIZE)];
+	uint32_t length = sizeof(bench_text) - 1;
+	uint32_t bytes = BENCH_ROUNDS * length;
+	uint32_t ticks[BENCH_CODERS], bits[BENCH_CODERS];
+#if HUFFMAN_ANS
+	static const char *names[BENCH_CODERS] = { "Static", "Order-1", "LZ", "Adaptive", "Range", "tANS" };
+#else
+	static const char *names[BENCH_CODERS] = { "Static", "Order-1", "LZ", "Adaptive", "Range" };
+#endif
+	uint8_t table = huffman_select_table((const uint8_t *)bench_text, length, tx_tables, NULL);
+
+	for(int coder = 0; coder < BENCH_CODERS; coder++)
+	{
+		if(coder != BENCH_STATIC && coder != BENCH_CONTEXT && coder != BENCH_ADAPTIVE)
+		{
+			uint32_t frame_bits = 0;
+			ticktime_t start = now();
+
+			for(int round = 0; round < BENCH_ROUNDS; round++)
+			{
+				huffman_lz_reset(&tx_history);
+				for(uint32_t i = 0; i < length; i += TX_FRAME_SIZE)
+				{
+					uint32_t frame = (length - i < TX_FRAME_SIZE) ? (length - i) : TX_FRAME_SIZE;
+
+					if(coder == BENCH_RANGE)
+					{
+						uint32_t range_bits;
+
+						range_encode_table(table, (const uint8_t *)bench_text + i, frame, buffer, sizeof(buffer), &range_bits);
+						frame_bits += range_bits;
+						continue;
+					}
+#if HUFFMAN_ANS
+					if(coder == BENCH_ANS)
+					{
+						uint32_t ans_bits;
+
+						ans_encode_table(table, (const uint8_t *)bench_text + i, frame, buffer, sizeof(buffer), &ans_bits);
+						frame_bits += ans_bits;
+						continue;
+					}
+#endif
+					huffman_encoder_init_lz(&encoder, table, &tx_history);
+					huffman_encoder_feed(&encoder, (const uint8_t *)bench_text + i, frame, buffer, sizeof(buffer));
+					huffman_encoder_flush(&encoder, buffer, sizeof(buffer));
+					frame_bits += encoder.total_bits;
+				}
+			}
+
+			ticks[coder] = now() - start;
+			bits[coder] = frame_bits;
+			continue;
+		}
+
+		huffman_adaptive_reset(&tx_model);
+		if(coder == BENCH_ADAPTIVE)
+			huffman_encoder_init_adaptive(&encoder, &tx_model);
+		else if(coder == BENCH_CONTEXT)
+			huffman_encoder_init_context(&encoder);
+		else
+			huffman_encoder_init_table(&encoder, table);
+
+		ticktime_t start = now();
+		for(int round = 0; round < BENCH_ROUNDS; round++)
+		{
+			for(uint32_t i = 0; i < length; i += TX_CHUNK_SIZE)
+			{
+				uint32_t chunk = (length - i < TX_CHUNK_SIZE) ? (length - i) : TX_CHUNK_SIZE;
+				huffman_encoder_feed(&encoder, (const uint8_t *)bench_text + i, chunk, buffer, sizeof(buffer));
+			}
+		}
+		huffman_encoder_flush(&encoder, buffer, sizeof(buffer));
+
+		ticks[coder] = now() - start;
+		bits[coder] = encoder.total_bits;
+	}
+
+	/* The receiver has to empty its tree and history too before the next messages */
+	huffman_adaptive_reset(&tx_model);
+	model_reset = true;
+	huffman_lz_reset(&tx_history);
+	history_reset = true;
+
+	for(int coder = 0; coder < BENCH_CODERS; coder++)
+	{
+		/* Ticks are 1 ms */
+		uint32_t cycles = (ticks[coder] * (SYSCLOCK_FREQUENCY / 1000)) / bytes;
+		uint32_t bits_per_char = (bits[coder] * 100) / bytes;
+
+		print_token(FORMAT_BENCHMARK, names[coder],
+				(unsigned long)cycles, (unsigned long)(bits_per_char / 100), (unsigned long)(bits_per_char % 100));
+	}
+}
+
+/*********************************************************************************
+ * @brief   :   Runs the huffman tests with the adaptive tree and the LZ
+ *              history of the UART
+ *
+ *              The tests borrow tx_model and tx_history rather than holding
+ *              their own, both are emptied again afterwards
+ *
+ * @param   :   none
+ *
+ * @return  :   void
+*********************************************************************************/
+void test_tx_coders(void)
+{
+	test_huffman(&tx_model, &tx_history);
+
+	huffman_adaptive_reset(&tx_model);
+	model_reset = true;
+	huffman_lz_reset(&tx_history);
+	history_reset = true;
+}
+
 /*********************************************************************************
  * @brief   :   Sets the custom string member of the stats structure to true
  *
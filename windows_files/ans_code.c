@@ -0,0 +1,237 @@
+/**
+ * @file    :   ans_code.c
+ * @brief   :   An abstraction for tANS encoding and decoding functions
+ *
+ *              This source file provides functions which code messages
+ * 				with the tANS tables of lookup_table.h
+ *
+ * @author  :   Sanish Kharade
+ * @date    :   December 10, 2021
+ * @version :   1.0
+ *
+ * @tools   :   gcc, cygwin, Visual Studio Code
+ *
+ * @link    :   -
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ans_code.h"
+#include "lookup_table.h"
+
+#if HUFFMAN_ANS_TABLE_LOG != ANS_TABLE_LOG
+#error "ANS_TABLE_LOG must match the tANS tables in lookup_table.h"
+#endif
+
+/* Fields of an entry of huffman_ans_decode_table */
+#define ANS_DECODE_STATE(entry)		((entry) & 0x0FFF)
+#define ANS_DECODE_BITS(entry)		(((entry) >> 12) & 0x0F)
+#define ANS_DECODE_SYMBOL(entry)	((entry) >> 16)
+
+/*
+ * 	ans_writer_t writes bits backwards from the end of a buffer, as the
+ * 	encoder produces them in the reverse of the order they are read
+ * 	buffer		- buffer to fill
+ * 	end			- index of the last byte written
+ * 	bit_buffer	- bits waiting to be written, the first one written in the lsb
+ * 	bit_count	- number of bits in bit_buffer
+ * 	total_bits	- number of bits written
+ * 	overflow	- set if the bits did not fit
+*/
+typedef struct
+{
+	uint8_t *buffer;
+	size_t end;
+	uint32_t bit_buffer;
+	uint8_t bit_count;
+	uint32_t total_bits;
+	bool overflow;
+} ans_writer_t;
+
+/*********************************************************************************
+ * @brief   :  	Writes bits in front of the bits written so far
+ *
+ * @param   :   writer	- bit writer
+ * 				value	- bits to write, aligned to the lsb
+ * 				bits	- number of bits, at most 16
+ *
+ * @return  : 	void
+**********************************************************************************/
+static inline void ans_put_bits(ans_writer_t *writer, uint32_t value, uint8_t bits)
+{
+	writer->bit_buffer |= value << writer->bit_count;
+	writer->bit_count += bits;
+	writer->total_bits += bits;
+
+	while (writer->bit_count >= 8)
+	{
+		if (writer->end == 0)
+		{
+			writer->overflow = true;
+			return;
+		}
+		writer->buffer[--writer->end] = writer->bit_buffer;
+		writer->bit_buffer >>= 8;
+		writer->bit_count -= 8;
+	}
+}
+
+/*********************************************************************************
+ * @brief   :  	Encodes characters with the tANS coder of a static table
+ *
+ * 				The characters are encoded last to first. The bits are
+ * 				written from the end of the buffer and moved to its start
+ * 				at the end, shifted so the padding ends up in the last byte
+ *
+ * @param   :   table	- ID of the table, below HUFFMAN_STATIC_TABLES
+ * 				data	- characters to encode
+ * 				length	- number of characters in data
+ * 				buffer	- buffer to fill with the encoded characters
+ * 				nbytes	- size of the buffer
+ * 				bits	- set to the number of encoded bits
+ *
+ * @return  : 	size_t	- number of bytes written to buffer, 0 if they do not fit
+**********************************************************************************/
+size_t ans_encode_table(uint8_t table, const uint8_t *data, size_t length,
+							uint8_t *buffer, size_t nbytes, uint32_t *bits)
+{
+	ans_writer_t writer = { buffer, nbytes, 0, 0, 0, false };
+	uint32_t state = ANS_STATES;
+
+	*bits = 0;
+	if (length == 0 || table >= HUFFMAN_STATIC_TABLES)
+		return 0;
+
+	const uint16_t *state_table = huffman_ans_state_table[table];
+	const uint32_t *symbol_bits = huffman_ans_symbol_bits[table];
+	const int16_t *symbol_state = huffman_ans_symbol_state[table];
+
+	for (size_t i = length; i-- > 0; )
+	{
+		uint16_t symbol = data[i];
+
+		/* The 8 bits of a byte with no code are read after the escape */
+		if (symbol_bits[symbol] == 0)
+		{
+			ans_put_bits(&writer, symbol, 8);
+			symbol = HUFFMAN_ESCAPE_SYMBOL;
+		}
+
+		uint8_t nbits = (state + symbol_bits[symbol]) >> 16;
+
+		/* The last character decodes from the state alone, its bits are never read */
+		if (i != length - 1)
+			ans_put_bits(&writer, state & ((1 << nbits) - 1), nbits);
+		state = state_table[(state >> nbits) + symbol_state[symbol]];
+	}
+
+	ans_put_bits(&writer, state - ANS_STATES, ANS_TABLE_LOG);
+
+	/* The bits left over are the first ones of the message, padded in front to a byte */
+	uint32_t total_bits = writer.total_bits;
+	uint8_t padding = 0;
+	if (writer.bit_count > 0)
+	{
+		padding = 8 - writer.bit_count;
+		ans_put_bits(&writer, 0, padding);
+	}
+
+	if (writer.overflow)
+		return 0;
+
+	/* Move the bits to the start of the buffer and the padding to the end */
+	size_t encoded_bytes = (total_bits + 7) / 8;
+	for (size_t i = 0; i < encoded_bytes; i++)
+	{
+		uint8_t next = (writer.end + i + 1 < nbytes) ? buffer[writer.end + i + 1] : 0;
+		buffer[i] = (buffer[writer.end + i] << padding) | (padding ? next >> (8 - padding) : 0);
+	}
+
+	*bits = total_bits;
+	return encoded_bytes;
+}
+
+/*********************************************************************************
+ * @brief   :  	Decodes characters encoded by ans_encode_table
+ *
+ * @param   :   table			- ID of the table the characters were encoded with
+ * 				encoded_buffer	- encoded characters
+ * 				encoded_bytes	- number of bytes in encoded_buffer
+ * 				decoded_bytes	- number of characters to decode
+ * 				decoded_buffer	- buffer to be filled with the decoded characters
+ *
+ * @return  : 	uint16_t		- number of characters decoded, less than
+ * 								  decoded_bytes if the input is too short
+**********************************************************************************/
+uint16_t ans_decode_table(uint8_t table, const uint8_t encoded_buffer[], size_t encoded_bytes,
+							uint16_t decoded_bytes, uint8_t decoded_buffer[])
+{
+	bit_reader_t reader;
+	uint16_t dbuf_id = 0;
+
+	bit_reader_init(&reader, encoded_buffer, encoded_bytes);
+	if (decoded_bytes == 0 || table >= HUFFMAN_STATIC_TABLES || bit_reader_bits_left(&reader) < ANS_TABLE_LOG)
+		return 0;
+
+	const uint32_t *decode_table = huffman_ans_decode_table[table];
+
+	uint16_t state = bit_reader_read(&reader, ANS_TABLE_LOG);
+
+	while (dbuf_id < decoded_bytes)
+	{
+		uint32_t entry = decode_table[state];
+		uint16_t symbol = ANS_DECODE_SYMBOL(entry);
+		uint8_t nbits = (dbuf_id + 1 < decoded_bytes) ? ANS_DECODE_BITS(entry) : 0;
+
+		if (bit_reader_bits_left(&reader) < (size_t)nbits + ((symbol == HUFFMAN_ESCAPE_SYMBOL) ? 8 : 0))
+			break;
+
+		state = ANS_DECODE_STATE(entry);
+		if (nbits > 0)
+			state += bit_reader_read(&reader, nbits);
+		if (symbol == HUFFMAN_ESCAPE_SYMBOL)
+			symbol = bit_reader_read(&reader, 8);
+
+		decoded_buffer[dbuf_id++] = symbol;
+	}
+
+	return dbuf_id;
+}
+
+/*********************************************************************************
+ * @brief   :  	Encodes the message with the tANS coder of table 0
+ *
+ * @param   :   message	- message to be encoded
+ * 				buffer	- buffer to fill with encoded message
+ * 				nbytes	- size of the buffer
+ *
+ * @return  : 	int		- number of encoded bits
+**********************************************************************************/
+int ans_encode(const char *message, uint8_t *buffer, size_t nbytes)
+{
+	uint32_t bits;
+
+	ans_encode_table(0, (const uint8_t *)message, strlen(message), buffer, nbytes, &bits);
+	return bits;
+}
+
+/*********************************************************************************
+ * @brief   :  	Decodes a message encoded by ans_encode and prints the string
+ *
+ * @param   :   encoded_buffer	- encoded buffer
+ * 				encoded_bytes	- number of bytes in the encoded buffer
+ * 				decoded_bytes	- number of original bytes
+ * 				decoded_buffer	- buffer to be filled with the decoded string
+ *
+ * @return  : 	void
+**********************************************************************************/
+void ans_decode(const uint8_t encoded_buffer[], uint16_t encoded_bytes,
+					uint16_t decoded_bytes, uint8_t decoded_buffer[])
+{
+	uint16_t dbuf_id = ans_decode_table(0, encoded_buffer, encoded_bytes, decoded_bytes, decoded_buffer);
+
+	decoded_buffer[dbuf_id] = '\0';
+	printf("%s\n", decoded_buffer);
+}
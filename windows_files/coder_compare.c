@@ -0,0 +1,249 @@
+/**
+ * @file    :   coder_compare.c
+ * @brief   :   Compares the coders of the static tables on the PC
+ *
+ *              This source file cuts a log file into messages the way the
+ * 				KL25Z does, codes every message with the table it is smallest
+ * 				with, with huffman, tANS and the range coder, and prints the
+ * 				bits per character and the time per byte of each coder next
+ * 				to the entropy of the file. The same comparison runs on the
+ * 				KL25Z with the bench command.
+ *
+ * @author  :   Sanish Sanjay Kharade
+ * @date    :   December 10, 2021
+ * @version :   1.0
+ *
+ * @tools   :   gcc, cygwin, Visual Studio Code
+ *
+ * @link    :   -
+ *
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "huffman_code.h"
+#include "ans_code.h"
+#include "range_code.h"
+#include <math.h>
+
+/* Messages of TX_FRAME_SIZE characters as in uart.c, unless given */
+#define FRAME_SIZE		(85)
+
+/* Largest log file read */
+#define MAX_TEXT		(1 << 20)
+
+/* Number of times the text is coded to time it */
+#define ROUNDS			(50)
+
+static uint8_t text[MAX_TEXT];
+static uint8_t encoded[HUFFMAN_ENCODED_SIZE(MAX_TEXT)];
+static uint8_t decoded[MAX_TEXT];
+
+/* Coders compared */
+typedef enum
+{
+	CODER_HUFFMAN,
+	CODER_ANS,
+	CODER_RANGE,
+	CODERS
+} coder_t;
+
+static const char *coder_names[CODERS] = { "Huffman", "tANS", "Range" };
+
+/*
+ * 	coder_result_t is what one coder did with the text
+ * 	bits		- encoded bits of all the messages
+ * 	encode_ns	- time spent encoding a character
+ * 	decode_ns	- time spent decoding a character
+*/
+typedef struct
+{
+	uint32_t bits;
+	double encode_ns;
+	double decode_ns;
+} coder_result_t;
+
+/*********************************************************************************
+ * @brief   :  	Reads a log file with the line endings the KL25Z sends
+ *
+ * @param   :   file_name	- log file
+ *
+ * @return  : 	size_t		- number of characters, 0 if the file can't be read
+**********************************************************************************/
+static size_t read_text(const char *file_name)
+{
+	FILE *fileptr = fopen(file_name, "rb");
+	size_t length = 0;
+	int ch;
+
+	if (fileptr == NULL)
+		return 0;
+
+	/* Every line ends with "\n\r" as the table was trained with */
+	while ((ch = fgetc(fileptr)) != EOF && length < MAX_TEXT - 1)
+	{
+		if (ch == '\r')
+			continue;
+		text[length++] = ch;
+		if (ch == '\n')
+			text[length++] = '\r';
+	}
+
+	fclose(fileptr);
+	return length;
+}
+
+/*********************************************************************************
+ * @brief   :  	Codes the text a message at a time with one of the coders
+ *
+ * @param   :   length	- number of characters in text
+ * 				frame	- characters in a message
+ * 				coder	- coder to run
+ *
+ * @return  : 	coder_result_t	- bits and time of the coder
+**********************************************************************************/
+static coder_result_t run_coder(size_t length, size_t frame, coder_t coder)
+{
+	static size_t offsets[MAX_TEXT + 1];
+	coder_result_t result = {0};
+	clock_t start;
+
+	start = clock();
+	for (int round = 0; round < ROUNDS; round++)
+	{
+		size_t out = 0, m = 0;
+
+		result.bits = 0;
+		for (size_t pos = 0; pos < length; pos += frame, m++)
+		{
+			size_t size = (length - pos < frame) ? (length - pos) : frame;
+			uint8_t table = huffman_select_table(text + pos, size, HUFFMAN_STATIC_TABLES, NULL);
+			uint32_t bits;
+
+			offsets[m] = out;
+			if (coder == CODER_ANS)
+			{
+				out += ans_encode_table(table, text + pos, size, encoded + out, sizeof(encoded) - out, &bits);
+			}
+			else if (coder == CODER_RANGE)
+			{
+				out += range_encode_table(table, text + pos, size, encoded + out, sizeof(encoded) - out, &bits);
+			}
+			else
+			{
+				huffman_encoder_t encoder;
+
+				huffman_encoder_init_table(&encoder, table);
+				out += huffman_encoder_feed(&encoder, text + pos, size, encoded + out, sizeof(encoded) - out);
+				out += huffman_encoder_flush(&encoder, encoded + out, sizeof(encoded) - out);
+				bits = encoder.total_bits;
+			}
+			result.bits += bits;
+		}
+		offsets[m] = out;
+	}
+	result.encode_ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / ROUNDS / length;
+
+	start = clock();
+	for (int round = 0; round < ROUNDS; round++)
+	{
+		size_t m = 0;
+
+		for (size_t pos = 0; pos < length; pos += frame, m++)
+		{
+			size_t size = (length - pos < frame) ? (length - pos) : frame;
+			uint8_t table = huffman_select_table(text + pos, size, HUFFMAN_STATIC_TABLES, NULL);
+			size_t nbytes = offsets[m + 1] - offsets[m];
+
+			if (coder == CODER_ANS)
+			{
+				ans_decode_table(table, encoded + offsets[m], nbytes, size, decoded + pos);
+			}
+			else if (coder == CODER_RANGE)
+			{
+				range_decode_table(table, encoded + offsets[m], nbytes, size, decoded + pos);
+			}
+			else
+			{
+				huffman_decoder_t decoder;
+
+				huffman_decoder_init_table(&decoder, size, table);
+				huffman_decoder_feed(&decoder, encoded + offsets[m], nbytes, decoded + pos, size);
+			}
+		}
+	}
+	result.decode_ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / ROUNDS / length;
+
+	if (memcmp(text, decoded, length) != 0)
+		fprintf(stderr, "%s did not decode the text it encoded\n", coder_names[coder]);
+
+	return result;
+}
+
+/*********************************************************************************
+ * @brief   :  	Main entry point to the application
+ *
+ * @param   :   argc - number of arguments
+ * 				argv - log files, optionally -fN first for messages of N
+ * 					   characters (FRAME_SIZE if left out)
+ *
+ * @return  : 	int
+**********************************************************************************/
+int main(int argc, char *argv[])
+{
+	size_t frame = FRAME_SIZE;
+	int first_file = 1;
+
+	if (argc > 1 && strncmp(argv[1], "-f", 2) == 0)
+	{
+		frame = atoi(argv[1] + 2);
+		first_file++;
+	}
+
+	if (frame == 0 || argc <= first_file)
+	{
+		fprintf(stderr, "Usage: %s [-fN] log files\n", argv[0]);
+		return 1;
+	}
+
+	huffman_init();
+
+	for (int f = first_file; f < argc; f++)
+	{
+		size_t length = read_text(argv[f]);
+		if (length == 0)
+		{
+			fprintf(stderr, "Cannot read %s\n", argv[f]);
+			continue;
+		}
+
+		/* Order-0 entropy of the file, the least any of the coders can reach */
+		size_t counts[256] = {0};
+		double entropy = 0;
+
+		for (size_t i = 0; i < length; i++)
+			counts[text[i]]++;
+		for (int i = 0; i < 256; i++)
+		{
+			if (counts[i] > 0)
+				entropy += counts[i] * log2((double)length / counts[i]);
+		}
+
+		printf("%s, messages of %lu characters, entropy %.4f bits/char\n",
+				argv[f], (unsigned long)frame, entropy / length);
+
+		/* The time includes picking the table of every message */
+		for (coder_t coder = 0; coder < CODERS; coder++)
+		{
+			coder_result_t result = run_coder(length, frame, coder);
+
+			printf("  %-8s %.4f bits/char, encode %.1f ns/byte, decode %.1f ns/byte\n",
+					coder_names[coder], (double)result.bits / length, result.encode_ns, result.decode_ns);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,263 @@
+/**
+ * @file    :   flash_strings.c
+ * @brief   :   Encodes the constant strings of the KL25Z at build time
+ *
+ *              This source file reads the strings of flash_strings.txt,
+ * 				encodes each of them with the static table it is smallest
+ * 				with and prints flash_strings.h. The header holds the
+ * 				messages ready to be sent, so the KL25Z queues them on the
+ * 				Tx fifo without encoding anything. The messages are defined
+ * 				where FLASH_STRINGS_DATA is defined before the header is
+ * 				included, the IDs everywhere.
+ *
+ * @author  :   Sanish Sanjay Kharade
+ * @date    :   December 10, 2021
+ * @version :   1.0
+ *
+ * @tools   :   gcc, cygwin, Visual Studio Code
+ *
+ * @link    :   -
+ *
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+
+#include "huffman_code.h"
+#include "lookup_table.h"
+
+/* Most characters in one message, TX_FRAME_SIZE of uart.c */
+#define FRAME_SIZE		(85)
+
+/* Most strings and characters of all strings */
+#define MAX_STRINGS		(32)
+#define MAX_TEXT		(4096)
+
+/* Longest line of the input file */
+#define MAX_LINE		(512)
+
+/*
+ * 	flash_string_t is a string of the input file
+ * 	name	- name of the string, used for its ID
+ * 	text	- the string
+ * 	length	- number of characters in text
+*/
+typedef struct
+{
+	char name[32];
+	uint8_t text[MAX_TEXT];
+	size_t length;
+} flash_string_t;
+
+static flash_string_t strings[MAX_STRINGS];
+
+/*********************************************************************************
+ * @brief   :  	Appends a line of text to a string, replacing the escapes
+ *
+ * @param   :   string	- string to append to
+ * 				line	- text without the line ending
+ *
+ * @return  : 	int		- 0 on success, -1 if the string is too long
+**********************************************************************************/
+static int append_text(flash_string_t *string, const char *line)
+{
+	for (const char *p = line; *p != '\0'; p++)
+	{
+		char ch = *p;
+
+		if (ch == '\\' && p[1] != '\0')
+		{
+			p++;
+			ch = (*p == 'n') ? '\n' : (*p == 'r') ? '\r' : (*p == 't') ? '\t' : *p;
+		}
+
+		if (string->length >= MAX_TEXT)
+			return -1;
+		string->text[string->length++] = ch;
+	}
+
+	return 0;
+}
+
+/*********************************************************************************
+ * @brief   :  	Reads the strings of the input file
+ *
+ * @param   :   file_name	- input file
+ *
+ * @return  : 	int			- number of strings, -1 on error
+**********************************************************************************/
+static int read_strings(const char *file_name)
+{
+	char line[MAX_LINE];
+	int count = 0;
+	FILE *fileptr = fopen(file_name, "r");
+
+	if (fileptr == NULL)
+		return -1;
+
+	while (fgets(line, sizeof(line), fileptr) != NULL)
+	{
+		char *text = line;
+
+		line[strcspn(line, "\r\n")] = '\0';
+		if (line[0] == '#' || line[0] == '\0')
+			continue;
+
+		if (line[0] == ' ' || line[0] == '\t')
+		{
+			/* Continues the last string */
+			if (count == 0)
+				return -1;
+		}
+		else
+		{
+			if (count == MAX_STRINGS)
+				return -1;
+
+			/* The name ends at the first whitespace */
+			size_t name_length = strcspn(line, " \t");
+			if (name_length >= sizeof(strings[count].name))
+				return -1;
+			memcpy(strings[count].name, line, name_length);
+			strings[count].name[name_length] = '\0';
+			strings[count].length = 0;
+			text = line + name_length;
+			count++;
+		}
+
+		while (*text == ' ' || *text == '\t')
+			text++;
+		if (append_text(&strings[count - 1], text) != 0)
+			return -1;
+	}
+
+	fclose(fileptr);
+	return count;
+}
+
+/*********************************************************************************
+ * @brief   :  	Prints the messages of a string
+ *
+ * 				The string is cut into messages of FRAME_SIZE characters,
+ * 				each framed the same as the ones written by the KL25Z
+ *
+ * @param   :   string	- the string
+ *
+ * @return  : 	size_t	- number of bytes of the messages
+**********************************************************************************/
+static size_t print_messages(const flash_string_t *string)
+{
+	size_t total = 0;
+
+	printf("/* %s */\n", string->name);
+	for (size_t pos = 0; pos < string->length; pos += FRAME_SIZE)
+	{
+		size_t size = (string->length - pos < FRAME_SIZE) ? (string->length - pos) : FRAME_SIZE;
+		uint8_t encoded[HUFFMAN_ENCODED_SIZE(FRAME_SIZE)];
+		uint8_t message[HUFFMAN_FRAME_HEADER_MAX + sizeof(encoded) + HUFFMAN_FRAME_CRC_BYTES];
+		huffman_encoder_t encoder;
+		uint32_t bits;
+
+		uint8_t table = huffman_select_table(string->text + pos, size, HUFFMAN_STATIC_TABLES, &bits);
+
+		huffman_encoder_init_table(&encoder, table);
+		size_t nbytes = huffman_encoder_feed(&encoder, string->text + pos, size, encoded, sizeof(encoded));
+		nbytes += huffman_encoder_flush(&encoder, encoded + nbytes, sizeof(encoded) - nbytes);
+
+		/* A message which does not get smaller is stored as it is */
+		if (nbytes >= size)
+		{
+			memcpy(encoded, string->text + pos, size);
+			table = HUFFMAN_STORED_ID;
+			bits = 8 * size;
+			nbytes = size;
+		}
+
+		/* Frame - header, message and the CRC of all but the sync bytes. The KL25Z puts in its own sequence number */
+		size_t length = huffman_frame_header(HUFFMAN_FRAME_TYPE(HUFFMAN_FRAME_CONSTANT, table), 0, size, bits, message);
+		memcpy(message + length, encoded, nbytes);
+		length += nbytes;
+
+		uint16_t crc = huffman_frame_crc(HUFFMAN_FRAME_CRC_INIT, message + 2, length - 2);
+		message[length++] = crc >> 8;
+		message[length++] = crc & 0xFF;
+
+		for (size_t i = 0; i < length; i++)
+			printf("0x%02X,%s", message[i], ((i % 12) == 11 || i == length - 1) ? "\n" : " ");
+		total += length;
+	}
+
+	return total;
+}
+
+/*********************************************************************************
+ * @brief   :  	Main entry point to the application
+ *
+ * @param   :   argc - number of arguments
+ * 				argv - optional input file, flash_strings.txt if left out
+ *
+ * @return  : 	int
+**********************************************************************************/
+int main(int argc, char *argv[])
+{
+	const char *file_name = (argc > 1) ? argv[1] : "flash_strings.txt";
+	size_t offsets[MAX_STRINGS + 1] = {0};
+	size_t plain = 0;
+
+	int count = read_strings(file_name);
+	if (count <= 0)
+	{
+		fprintf(stderr, "Cannot read the strings of %s\n", file_name);
+		return 1;
+	}
+
+	huffman_init();
+
+	printf("#ifndef FLASH_STRINGS_H_\n");
+	printf("#define FLASH_STRINGS_H_\n\n");
+	printf("#include <stdint.h>\n");
+	printf("#include \"lookup_table.h\"\n\n");
+
+	printf("/* The strings are encoded with the tables of this lookup_table.h */\n");
+	printf("#if HUFFMAN_TABLES_HASH != 0x%08lXUL\n", (unsigned long)HUFFMAN_TABLES_HASH);
+	printf("#error \"flash_strings.h was encoded with other tables, regenerate it\"\n");
+	printf("#endif\n\n");
+
+	printf("/* ID of every string */\n");
+	for (int s = 0; s < count; s++)
+	{
+		printf("#define FLASH_STRING_");
+		for (const char *name = strings[s].name; *name != '\0'; name++)
+			putchar(isalnum((unsigned char)*name) ? toupper((unsigned char)*name) : '_');
+		printf(" (%d)\n", s);
+	}
+	printf("#define FLASH_STRING_COUNT (%d)\n\n", count);
+
+	/* The messages are only defined in the file which sends them */
+	printf("#ifdef FLASH_STRINGS_DATA\n\n");
+	printf("/* Frames of every string, as they are sent */\n");
+	printf("static const uint8_t flash_string_messages[] = {\n");
+	for (int s = 0; s < count; s++)
+	{
+		offsets[s + 1] = offsets[s] + print_messages(&strings[s]);
+		plain += strings[s].length + 1;
+	}
+	printf("};\n\n");
+
+	printf("/* Offset of the first message of every string, then the end of the last one */\n");
+	printf("static const uint16_t flash_string_offsets[FLASH_STRING_COUNT + 1] = {\n");
+	for (int s = 0; s <= count; s++)
+		printf("%lu,%s", (unsigned long)offsets[s], (s == count) ? "\n" : " ");
+	printf("};\n\n");
+
+	printf("#endif /* FLASH_STRINGS_DATA */\n\n");
+	printf("#endif\n");
+
+	/* The report goes to stderr as stdout is redirected to the header file */
+	fprintf(stderr, "%d strings: %lu bytes of messages instead of %lu bytes of text\n",
+			count, (unsigned long)offsets[count], (unsigned long)plain);
+
+	return 0;
+}
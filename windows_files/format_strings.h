@@ -0,0 +1,60 @@
+/**
+ * @file    :   format_strings.h
+ * @brief   :   Database of the format strings sent as tokens
+ *
+ *              Every format string printed with print_token is listed here
+ *              once. The KL25Z sends the ID of the string and its packed
+ *              arguments, and the PC renders the text from the same list.
+ *              The IDs are the positions in the list, so both sides must be
+ *              built with the same copy of this file. Add new strings at
+ *              the end to keep the IDs of the old ones.
+ *
+ * @author  :   Sanish Kharade
+ * @date    :   December 10, 2021
+ * @version :   1.0
+ *
+ * @tools   :   gcc, cygwin, Visual Studio Code
+ *
+ * @link    :   -
+*/
+
+#ifndef FORMAT_STRINGS_H_
+#define FORMAT_STRINGS_H_
+
+/*
+ * X(name, format) for every string. Conversions may be d, i, u, x, X, o, c, s
+ * and %, with flags, a width, a precision and the h, hh or l length
+ */
+#define FORMAT_STRINGS(X) \
+	X(FORMAT_TOO_MANY_ARGUMENTS,	"Too many arguments for the %s command\n\rEnter help command for syntax of all commands\n\r") \
+	X(FORMAT_INVALID_ARGUMENT,		"Invalid argument\n\r") \
+	X(FORMAT_AUTHOR,				"Sanish Kharade\n\r") \
+	X(FORMAT_RESET,					"Timer and Bytes Reset\n\r") \
+	X(FORMAT_MODE_USAGE,			"Usage: mode <static|adaptive|range|block|stream>\n\r") \
+	X(FORMAT_MODE_STATIC,			"Static huffman table selected\n\r") \
+	X(FORMAT_MODE_ADAPTIVE,			"Adaptive huffman tree selected\n\r") \
+	X(FORMAT_STATS,					"Original Bytes = %d\n\rReduced bytes = %d\n\rPercent Reduction = %d percent\n\rTime = %d ms\n\rThroughput = %lu bytes/s\n\r") \
+	X(FORMAT_BENCHMARK,				"%s: %lu cycles/byte, %lu.%02lu bits/char\n\r") \
+	X(FORMAT_MODE_RANGE,			"Range coder selected\n\r") \
+	X(FORMAT_MODE_BLOCK,			"Block tables selected\n\r") \
+	X(FORMAT_BATCH_USAGE,			"Usage: batch <bytes 0-%d> <ms>\n\r") \
+	X(FORMAT_BATCH,					"Batches of up to %d bytes, sent within %lu ms\n\r") \
+	X(FORMAT_MODE_STREAM,			"Bit stream selected\n\r") \
+	X(FORMAT_BAUD_USAGE,			"Usage: baud <rate>\n\r") \
+	X(FORMAT_BAUD_RANGE,			"Baud rate %lu is out of reach\n\r") \
+	X(FORMAT_BAUD_SWITCH,			"Switching to %lu baud\n\r") \
+	X(FORMAT_BAUD_FAILED,			"Link check failed, back to %lu baud\n\r") \
+	X(FORMAT_BAUD,					"Link checked at %lu baud, at most %lu bytes/s\n\r")
+
+#define FORMAT_ID(name, format)		name,
+
+/* ID of every format string */
+typedef enum
+{
+	FORMAT_STRINGS(FORMAT_ID)
+	FORMAT_COUNT
+} format_id_t;
+
+#undef FORMAT_ID
+
+#endif /* FORMAT_STRINGS_H_ */
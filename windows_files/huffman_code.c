@@ -14,158 +14,2809 @@
  * @link    :   Credits to Prof. Howdy Pierce for the huffman_encode function
  * 				
 */
+
+
 #include <stdio.h>
-#include <stdint.h>
+#include "huffman_code.h"
+#include "lookup_table.h"
+#include <assert.h>
 #include <string.h>
-#define min(x,y) ((x<=y)?x:y)
+#include <stdint.h>
+#include <stdbool.h>
+
+#if HUFFMAN_MAX_CODE_LENGTH > HUFFMAN_MAX_CODE_BITS
+#error "Codes in lookup_table.h are too long, regenerate it with a lower maximum code length"
+#endif
+
+#if HUFFMAN_NUM_TABLES != HUFFMAN_STATIC_TABLES
+#error "HUFFMAN_STATIC_TABLES must match the number of tables in lookup_table.h"
+#endif
+
+/* The table ID is sent in 3 bits of the message type, the last ID marks a stored message */
+#if HUFFMAN_MAX_TABLES > HUFFMAN_STORED_ID
+#error "Too many tables for the ID in the message type"
+#endif
+
+/* Announced code lengths are the symbols 0 to 15 of the code of the lengths */
+#if HUFFMAN_MAX_CODE_LENGTH > 15 || HUFFMAN_NUM_SYMBOLS > 257 + HUFFMAN_MAX_TOKENS
+#error "Code lengths of lookup_table.h do not fit in HUFFMAN_TABLE_BYTES"
+#endif
+
+#if HUFFMAN_NUM_TOKENS > HUFFMAN_MAX_TOKENS || HUFFMAN_LONGEST_TOKEN > HUFFMAN_MAX_TOKEN_LENGTH
+#error "Tokens of lookup_table.h do not fit the encoder, regenerate it with fewer tokens"
+#endif
+
+/* Fields of a node of huffman_token_trie */
+#define TRIE_CHARACTER			(0)
+#define TRIE_CHILD				(1)
+#define TRIE_SIBLING			(2)
+#define TRIE_TOKEN				(3)
+
+/* Number of entries in the primary decode table */
+#define HUFFMAN_PRIMARY_ENTRIES	(1U << HUFFMAN_LOOKUP_BITS)
+
+/* Decode table entries hold the symbol in the low 11 bits and the code length in the top 5 bits */
+#define LOOKUP_ENTRY(symbol, bits)	((huffman_lookup_t)(((bits) << 11) | (symbol)))
+#define LOOKUP_SYMBOL(entry)		((entry) & 0x7FF)
+#define LOOKUP_BITS(entry)			((entry) >> 11)
+
+/* Code length of a decode table entry which is not the prefix of any code */
+#define HUFFMAN_INVALID			(0x1F)
+
+/* Node numbers of the adaptive tree */
+#define ADAPTIVE_ROOT			(0)
+
+/* Marks a leaf in the child array of the adaptive tree */
+#define ADAPTIVE_LEAF			(0x8000)
+
+/* Symbol of the leaf for the bytes not seen yet */
+#define ADAPTIVE_NYT			(256)
+
+/* Number of symbols put in order by each sort step of the rebuild */
+#define REBUILD_SORT_STEP		(16)
+
+/*
+ * Symbols of the code of announced code lengths, after the lengths 0 to 15.
+ * LENGTHS_REPEAT repeats the last length 3 to 6 times, LENGTHS_ZEROS is 3 to
+ * 10 zeros and LENGTHS_LONG_ZEROS is 11 to 138 zeros. The count follows the
+ * symbol in LENGTHS_*_BITS bits
+ */
+#define LENGTHS_REPEAT			(16)
+#define LENGTHS_ZEROS			(17)
+#define LENGTHS_LONG_ZEROS		(18)
+#define LENGTHS_SYMBOLS			(19)
+#define LENGTHS_REPEAT_BITS		(2)
+#define LENGTHS_ZEROS_BITS		(3)
+#define LENGTHS_LONG_ZEROS_BITS	(7)
+
+/* Longest code of the code of the lengths, its own lengths are sent in 3 bits */
+#define LENGTHS_MAX_CODE_BITS	(7)
+
+/* Index of a position in the window of the history */
+#define LZ_INDEX(position)		((position) & (HUFFMAN_LZ_WINDOW - 1))
+
+/* Order of the exp-golomb code of the length of a repeat, which takes at most 11 bits */
+#define LZ_LENGTH_ORDER			(2)
+#define LZ_LENGTH_MAX_BITS		(11)
+
+/* Most zeros before the length of a repeat */
+#define LZ_LENGTH_MAX_ZEROS		((LZ_LENGTH_MAX_BITS - 1 - LZ_LENGTH_ORDER) / 2)
+
+/*
+ * 	Entry of the primary decode table, made with LOOKUP_ENTRY
+ * 	The code length is 0 if the code is longer than HUFFMAN_LOOKUP_BITS
+*/
+typedef uint16_t huffman_lookup_t;
+
+/*
+ * 	huffman_table_t holds the decode tables rebuilt from one set of code lengths
+ * 	primary			- decode table indexed by the next HUFFMAN_LOOKUP_BITS bits of the input
+ * 	sorted_symbols	- symbols sorted by code length, then by value. This is the order
+ * 					  of the canonical codes
+ * 	length_count	- number of codes of every length
+ * 	first_code		- first code of every length
+ * 	first_index		- index in sorted_symbols of the first code of every length
+ * 	max_code_bits	- length of the longest code
+*/
+typedef struct
+{
+	huffman_lookup_t primary[HUFFMAN_PRIMARY_ENTRIES];
+#if HUFFMAN_MAX_CODE_LENGTH > HUFFMAN_LOOKUP_BITS
+	uint16_t sorted_symbols[HUFFMAN_NUM_SYMBOLS];
+	uint16_t length_count[HUFFMAN_MAX_CODE_BITS + 1];
+	uint16_t first_code[HUFFMAN_MAX_CODE_BITS + 1];
+	uint16_t first_index[HUFFMAN_MAX_CODE_BITS + 1];
+#endif
+	uint8_t max_code_bits;
+} huffman_table_t;
+
+/*
+ * The one decode table, built from the code lengths of the table ID in
+ * scratch_id. It is built again when a decoder uses another ID,
+ * HUFFMAN_MAX_TABLES means none is built
+ */
+static huffman_table_t scratch;
+static uint8_t scratch_id = HUFFMAN_MAX_TABLES;
+
+/*
+ * Code lengths and canonical codes of the table built at runtime, the
+ * encoders index them by the symbol. The static ones are in lookup_table.h.
+ * runtime_id is the ID the table has now, HUFFMAN_MAX_TABLES while there is none
+ */
+static uint8_t runtime_lengths[HUFFMAN_NUM_SYMBOLS];
+static uint16_t runtime_codes[HUFFMAN_NUM_SYMBOLS];
+static uint8_t runtime_id = HUFFMAN_MAX_TABLES;
+
+_Static_assert(sizeof(scratch) + sizeof(runtime_lengths) + sizeof(runtime_codes) <= HUFFMAN_TABLES_RAM,
+				"The tables take more RAM than HUFFMAN_TABLES_RAM");
+
+/* Steps of the rebuild of the runtime table */
+typedef enum
+{
+	REBUILD_IDLE,
+	REBUILD_SORT,
+	REBUILD_LENGTHS,
+	REBUILD_COMPARE,
+	REBUILD_BUILD
+} rebuild_state_t;
+
+/* Times every symbol was encoded, halved after every rebuild so older traffic counts less */
+static uint32_t symbol_counts[HUFFMAN_NUM_SYMBOLS];
+
+/* Number of bytes counted since the last rebuild */
+static uint32_t counted_bytes = 0;
+
+/*
+ * 	State of the rebuild of the runtime table
+ * 	state	- next step
+ * 	shift	- the counts are shifted right by this much so the weights add up to 16 bits
+ * 	count	- number of symbols which get a code
+ * 	sorted	- number of symbols at the start of symbols which are in order
+ * 	symbols	- symbols in order of increasing weight
+ * 	weights	- weight of each symbol in symbols, replaced by its code length
+*/
+static struct
+{
+	rebuild_state_t state;
+	uint8_t shift;
+	uint16_t count;
+	uint16_t sorted;
+	uint16_t symbols[HUFFMAN_NUM_SYMBOLS];
+	uint16_t weights[HUFFMAN_NUM_SYMBOLS];
+} rebuild;
+
+/*
+ * Order the code lengths of the code of the lengths are sent in, the ones
+ * least likely to be 0 first so the zeros at the end can be left out
+ */
+static const uint8_t lengths_order[LENGTHS_SYMBOLS] =
+		{ 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+/*
+ * 	lengths_writer_t writes the packed code lengths of a table, msb first
+ * 	buffer		- buffer to fill
+ * 	nbytes		- size of the buffer
+ * 	idx			- index of the next byte of buffer
+ * 	bit_buffer	- bits not written yet, aligned to the lsb
+ * 	bit_count	- number of bits in bit_buffer
+ * 	overflow	- set if the bits did not fit
+*/
+typedef struct
+{
+	uint8_t *buffer;
+	size_t nbytes;
+	size_t idx;
+	uint32_t bit_buffer;
+	uint8_t bit_count;
+	bool overflow;
+} lengths_writer_t;
+
+/*********************************************************************************
+ * @brief   :  	Rebuilds the canonical codes from code lengths
+ *
+ * 				Codes of the same length are consecutive numbers in the order
+ * 				of the symbols, and every length starts where the previous one
+ * 				ended. lookup_table.h holds the codes of the static tables
+ * 				made in the same way.
+ *
+ * @param   :   code_lengths	- code length of every symbol, at most
+ * 								  HUFFMAN_MAX_CODE_LENGTH bits
+ * 				codes			- filled with the code of every symbol, 0 for
+ * 								  the bytes which are sent escaped
+ *
+ * @return  : 	void
+**********************************************************************************/
+static void build_codes(const uint8_t code_lengths[], uint16_t codes[])
+{
+	uint16_t length_count[HUFFMAN_MAX_CODE_BITS + 1] = {0};
+	uint16_t next_code[HUFFMAN_MAX_CODE_BITS + 1];
+	uint16_t code = 0;
+
+	for (int i = 0; i < HUFFMAN_NUM_SYMBOLS; i++)
+	{
+		assert(code_lengths[i] <= HUFFMAN_MAX_CODE_LENGTH);
+		length_count[code_lengths[i]]++;
+	}
+
+	/* Bytes without a code are not part of the canonical order */
+	length_count[0] = 0;
+
+	for (int bits = 1; bits <= HUFFMAN_MAX_CODE_BITS; bits++)
+	{
+		code = (code + length_count[bits - 1]) << 1;
+		next_code[bits] = code;
+	}
+
+	for (int i = 0; i < HUFFMAN_NUM_SYMBOLS; i++)
+		codes[i] = (code_lengths[i] > 0) ? next_code[code_lengths[i]]++ : 0;
+}
+
+/*********************************************************************************
+ * @brief   :  	Builds the decode tables of a table from its codes
+ *
+ * 				Codes of at most HUFFMAN_LOOKUP_BITS bits fill all the primary
+ * 				entries which start with them.
+ *
+ * @param   :   table			- table to build
+ * 				code_lengths	- code length of every symbol, at most
+ * 								  HUFFMAN_MAX_CODE_LENGTH bits
+ * 				codes			- canonical code of every symbol
+ *
+ * @return  : 	void
+**********************************************************************************/
+static void build_table(huffman_table_t *table, const uint8_t code_lengths[], const uint16_t codes[])
+{
+#if HUFFMAN_MAX_CODE_LENGTH > HUFFMAN_LOOKUP_BITS
+	uint16_t next_index[HUFFMAN_MAX_CODE_BITS + 1], index = 0;
+
+	memset(table->length_count, 0, sizeof(table->length_count));
+#endif
+
+	table->max_code_bits = 0;
+
+	for (int i = 0; i < HUFFMAN_NUM_SYMBOLS; i++)
+	{
+		if (code_lengths[i] > table->max_code_bits)
+			table->max_code_bits = code_lengths[i];
+#if HUFFMAN_MAX_CODE_LENGTH > HUFFMAN_LOOKUP_BITS
+		if (code_lengths[i] > 0)
+			table->length_count[code_lengths[i]]++;
+#endif
+	}
+
+#if HUFFMAN_MAX_CODE_LENGTH > HUFFMAN_LOOKUP_BITS
+	/* The first code of every length follows the codes of the length before */
+	for (int bits = 1; bits <= HUFFMAN_MAX_CODE_BITS; bits++)
+	{
+		table->first_code[bits] = (bits == 1) ? 0 : (table->first_code[bits - 1] + table->length_count[bits - 1]) << 1;
+		table->first_index[bits] = next_index[bits] = index;
+		index += table->length_count[bits];
+	}
+#endif
+
+	/* The escape is needed for every byte which has no code */
+	assert(code_lengths[HUFFMAN_ESCAPE_SYMBOL] > 0);
+
+	for (uint32_t i = 0; i < HUFFMAN_PRIMARY_ENTRIES; i++)
+		table->primary[i] = LOOKUP_ENTRY(0, HUFFMAN_INVALID);
+
+	for (int i = 0; i < HUFFMAN_NUM_SYMBOLS; i++)
+	{
+		uint8_t code_bits = code_lengths[i];
+
+		if (code_bits == 0)
+			continue;
+
+		if (code_bits <= HUFFMAN_LOOKUP_BITS)
+		{
+			uint8_t free_bits = HUFFMAN_LOOKUP_BITS - code_bits;
+			uint32_t first = (uint32_t)codes[i] << free_bits;
+
+			for (uint32_t j = first; j < first + (1UL << free_bits); j++)
+				table->primary[j] = LOOKUP_ENTRY(i, code_bits);
+		}
+#if HUFFMAN_MAX_CODE_LENGTH > HUFFMAN_LOOKUP_BITS
+		else
+		{
+			/* Longer codes are decoded from the first code of each length */
+			table->primary[codes[i] >> (code_bits - HUFFMAN_LOOKUP_BITS)] = LOOKUP_ENTRY(0, 0);
+			table->sorted_symbols[next_index[code_bits]++] = i;
+		}
+#endif
+	}
+}
+
+/*********************************************************************************
+ * @brief   :  	Returns the code lengths of a table
+ *
+ * @param   :   table	- ID of a static table or of the runtime table
+ *
+ * @return  : 	const uint8_t *	- code length of every symbol
+**********************************************************************************/
+static inline const uint8_t *table_lengths(uint8_t table)
+{
+	assert(huffman_has_table(table));
+
+	if (table < HUFFMAN_STATIC_TABLES)
+		return huffman_code_lengths[table];
+
+	return runtime_lengths;
+}
+
+/*********************************************************************************
+ * @brief   :  	Returns the canonical codes of a table
+ *
+ * @param   :   table	- ID of a static table or of the runtime table
+ *
+ * @return  : 	const uint16_t *	- code of every symbol
+**********************************************************************************/
+static inline const uint16_t *table_codes(uint8_t table)
+{
+	assert(huffman_has_table(table));
+
+	if (table < HUFFMAN_STATIC_TABLES)
+		return huffman_codes[table];
+
+	return runtime_codes;
+}
+
+/*********************************************************************************
+ * @brief   :  	Returns the ID of the table in use at an index
+ *
+ * @param   :   index	- index of the table, the static tables come first
+ * 						  and the runtime table after them
+ *
+ * @return  : 	uint8_t	- ID of the table
+**********************************************************************************/
+static inline uint8_t table_in_use(uint8_t index)
+{
+	return (index < HUFFMAN_STATIC_TABLES) ? index : runtime_id;
+}
+
+/*********************************************************************************
+ * @brief   :  	Returns the decode tables of a table ID
+ *
+ * 				The tables are built from the code lengths unless they are
+ * 				the ones built last. They are only valid until a decoder
+ * 				uses another ID, so every call of a decoder looks them up again
+ *
+ * @param   :   table	- ID of a table huffman_has_table accepts
+ *
+ * @return  : 	const huffman_table_t *	- decode tables
+**********************************************************************************/
+static inline const huffman_table_t *use_table(uint8_t table)
+{
+	if (scratch_id != table)
+	{
+		build_table(&scratch, table_lengths(table), table_codes(table));
+		scratch_id = table;
+	}
+
+	return &scratch;
+}
+
+/*********************************************************************************
+ * @brief   :  	Replaces the runtime table
+ *
+ * @param   :   table			- ID the table gets, from HUFFMAN_RUNTIME_TABLE
+ * 				code_lengths	- code length of every symbol
+ *
+ * @return  : 	void
+**********************************************************************************/
+static void set_lengths(uint8_t table, const uint8_t code_lengths[])
+{
+	assert(table >= HUFFMAN_STATIC_TABLES && table < HUFFMAN_MAX_TABLES);
+
+	memcpy(runtime_lengths, code_lengths, HUFFMAN_NUM_SYMBOLS);
+	build_codes(code_lengths, runtime_codes);
+	runtime_id = table;
+	if (scratch_id >= HUFFMAN_STATIC_TABLES)
+		scratch_id = HUFFMAN_MAX_TABLES;
+}
+
+/*********************************************************************************
+ * @brief   :  	Returns the ID the next runtime table gets, the one the
+ * 				runtime table has not got now
+ *
+ * @param   :   none
+ *
+ * @return  : 	uint8_t	- ID of the table
+**********************************************************************************/
+static inline uint8_t next_runtime_id(void)
+{
+	return (runtime_id == HUFFMAN_RUNTIME_TABLE) ? HUFFMAN_RUNTIME_TABLE + 1 : HUFFMAN_RUNTIME_TABLE;
+}
+
+/*********************************************************************************
+ * @brief   :  	Sets up the tables from the code lengths in the huffman
+ * 				lookup table
+ *
+ * 				There is no runtime table until one is built or imported
+ *
+ * @param   :   none
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_init(void)
+{
+	runtime_id = HUFFMAN_MAX_TABLES;
+	scratch_id = HUFFMAN_MAX_TABLES;
+}
+
+/*********************************************************************************
+ * @brief   :  	Returns the ID of the runtime table
+ *
+ * @param   :   none
+ *
+ * @return  : 	uint8_t	- ID of the table, HUFFMAN_MAX_TABLES if there is none
+**********************************************************************************/
+uint8_t huffman_runtime_table(void)
+{
+	return runtime_id;
+}
+
+/*********************************************************************************
+ * @brief   :  	Tells whether a table ID can be used
+ *
+ * @param   :   table	- ID of the table
+ *
+ * @return  : 	bool	- true for the static tables and the ID the runtime
+ * 						  table has now
+**********************************************************************************/
+bool huffman_has_table(uint8_t table)
+{
+	return table < HUFFMAN_STATIC_TABLES || (table < HUFFMAN_MAX_TABLES && table == runtime_id);
+}
+
+/*********************************************************************************
+ * @brief   :  	Looks up the code at the start of the next 16 bits
+ *
+ * 				Codes of at most HUFFMAN_LOOKUP_BITS bits are decoded with one
+ * 				lookup in the primary table. When the table has longer codes,
+ * 				they are found by comparing the next bits with the first code
+ * 				of each longer length.
+ *
+ * @param   :   table	- table of the message
+ * 				peek	- next 16 bits of the input
+ *
+ * @return  : 	huffman_lookup_t	- decoded symbol and its code length,
+ * 									  length 0 or HUFFMAN_INVALID for corrupt input
+**********************************************************************************/
+static inline huffman_lookup_t lookup_code(const huffman_table_t *table, uint16_t peek)
+{
+	huffman_lookup_t entry = table->primary[peek >> (16 - HUFFMAN_LOOKUP_BITS)];
+
+#if HUFFMAN_MAX_CODE_LENGTH > HUFFMAN_LOOKUP_BITS
+	if (LOOKUP_BITS(entry) == 0)
+	{
+		/* A code of this length is one of its length_count consecutive codes */
+		for (uint8_t bits = HUFFMAN_LOOKUP_BITS + 1; bits <= table->max_code_bits; bits++)
+		{
+			uint16_t offset = (peek >> (16 - bits)) - table->first_code[bits];
+			if (offset < table->length_count[bits])
+			{
+				entry = LOOKUP_ENTRY(table->sorted_symbols[table->first_index[bits] + offset], bits);
+				break;
+			}
+		}
+	}
+#endif
+
+	return entry;
+}
+
+/*********************************************************************************
+ * @brief   :  	Decodes the symbol at the start of the next 24 bits
+ *
+ * 				An escape code is followed by the 8 bits of the byte
+ *
+ * @param   :   table	- table of the message
+ * 				peek	- next 24 bits of the input
+ * 				bits	- set to the number of bits used, 0 for corrupt input
+ *
+ * @return  : 	uint16_t	- decoded byte, or token from HUFFMAN_FIRST_TOKEN
+**********************************************************************************/
+static inline uint16_t decode_symbol(const huffman_table_t *table, uint32_t peek, uint8_t *bits)
+{
+	huffman_lookup_t entry = lookup_code(table, peek >> 8);
+	uint8_t code_bits = LOOKUP_BITS(entry);
+
+	if (code_bits == 0 || code_bits == HUFFMAN_INVALID)
+	{
+		*bits = 0;
+		return 0;
+	}
+
+	if (LOOKUP_SYMBOL(entry) == HUFFMAN_ESCAPE_SYMBOL)
+	{
+		*bits = code_bits + 8;
+		return (peek >> (16 - code_bits)) & 0xFF;
+	}
+
+	*bits = code_bits;
+	return LOOKUP_SYMBOL(entry);
+}
+
+/*********************************************************************************
+ * @brief   :  	Returns the number of characters a decoded symbol stands for
+ *
+ * @param   :   symbol	- byte, or token from HUFFMAN_FIRST_TOKEN
+ *
+ * @return  : 	uint8_t	- number of characters
+**********************************************************************************/
+static inline uint8_t symbol_length(uint16_t symbol)
+{
+	if (symbol < HUFFMAN_FIRST_TOKEN)
+		return 1;
+
+	return huffman_token_offsets[symbol - HUFFMAN_FIRST_TOKEN + 1] - huffman_token_offsets[symbol - HUFFMAN_FIRST_TOKEN];
+}
+
+/*********************************************************************************
+ * @brief   :  	Writes out the characters of a decoded symbol
+ *
+ * @param   :   symbol	- byte, or token from HUFFMAN_FIRST_TOKEN
+ * 				buffer	- buffer to fill, at least symbol_length(symbol) bytes
+ *
+ * @return  : 	uint8_t	- number of characters written
+**********************************************************************************/
+static inline uint8_t write_symbol(uint16_t symbol, uint8_t buffer[])
+{
+	if (symbol < HUFFMAN_FIRST_TOKEN)
+	{
+		buffer[0] = symbol;
+		return 1;
+	}
+
+	uint8_t length = symbol_length(symbol);
+	memcpy(buffer, huffman_token_text + huffman_token_offsets[symbol - HUFFMAN_FIRST_TOKEN], length);
+	return length;
+}
+
+/*********************************************************************************
+ * @brief   :  	Finds the symbol which codes the start of some characters
+ *
+ * 				The characters are followed down huffman_token_trie from the
+ * 				node of the first one. The longest token the table has a
+ * 				code for is taken, otherwise the first character
+ *
+ * @param   :   lengths	- code lengths of the table
+ * 				data	- characters
+ * 				length	- number of characters in data, at least 1
+ * 				matched	- set to the number of characters of the symbol
+ *
+ * @return  : 	uint16_t	- byte, or token from HUFFMAN_FIRST_TOKEN
+**********************************************************************************/
+static inline uint16_t match_token(const uint8_t lengths[], const uint8_t *data, size_t length,
+									uint8_t *matched)
+{
+	uint16_t symbol = data[0];
+	uint8_t node = huffman_token_start[data[0]];
+
+	*matched = 1;
+	for (size_t i = 0; i < length && node != 0; )
+	{
+		if (huffman_token_trie[node][TRIE_CHARACTER] != data[i])
+		{
+			node = huffman_token_trie[node][TRIE_SIBLING];
+			continue;
+		}
+
+		uint8_t token = huffman_token_trie[node][TRIE_TOKEN];
+
+		i++;
+		if (token != 0 && lengths[HUFFMAN_FIRST_TOKEN + token - 1] > 0)
+		{
+			symbol = HUFFMAN_FIRST_TOKEN + token - 1;
+			*matched = i;
+		}
+		node = huffman_token_trie[node][TRIE_CHILD];
+	}
+
+	return symbol;
+}
+
+/*********************************************************************************
+ * @brief   :  	Exchanges two nodes of the adaptive tree with their subtrees
+ *
+ * 				The nodes keep their numbers and parents, only what hangs
+ * 				below them moves
+ *
+ * @param   :   model	- adaptive tree
+ * 				a, b	- nodes of the same weight, neither an ancestor of the other
+ *
+ * @return  : 	void
+**********************************************************************************/
+static void adaptive_swap(huffman_adaptive_t *model, uint8_t a, uint8_t b)
+{
+	uint16_t child = model->child[a];
+	model->child[a] = model->child[b];
+	model->child[b] = child;
+
+	uint8_t nodes[2] = { a, b };
+	for (int i = 0; i < 2; i++)
+	{
+		uint8_t node = nodes[i];
+		child = model->child[node];
+
+		if (!(child & ADAPTIVE_LEAF))
+		{
+			model->parent[child] = node;
+			model->parent[child + 1] = node;
+		}
+		else if ((child & ~ADAPTIVE_LEAF) == ADAPTIVE_NYT)
+			model->nyt = node;
+		else
+			model->leaf[child & ~ADAPTIVE_LEAF] = node;
+	}
+}
+
+/*********************************************************************************
+ * @brief   :  	Halves the counts of the adaptive tree and builds it again
+ *
+ * 				The bytes are added back in order with their halved counts,
+ * 				so both sides end up with the same tree
+ *
+ * @param   :   model	- adaptive tree
+ *
+ * @return  : 	void
+**********************************************************************************/
+static void adaptive_halve(huffman_adaptive_t *model);
+
+/*********************************************************************************
+ * @brief   :  	Counts one more occurrence of a byte in the adaptive tree
+ *
+ * 				A byte seen for the first time splits the NYT leaf into a
+ * 				leaf for the byte and a new NYT leaf, unless the tree is
+ * 				full, then nothing is counted. Then every node from the
+ * 				leaf up to the root is moved to the front of the nodes of its
+ * 				weight before its weight is incremented, which keeps the nodes
+ * 				in order of weight.
+ *
+ * @param   :   model	- adaptive tree
+ * 				symbol	- byte which was coded
+ *
+ * @return  : 	void
+**********************************************************************************/
+static void adaptive_update(huffman_adaptive_t *model, uint8_t symbol)
+{
+	uint8_t node = model->leaf[symbol];
+
+	if (node == 0)
+	{
+		uint8_t nyt = model->nyt;
+
+		if (nyt + 2 >= HUFFMAN_ADAPTIVE_NODES)
+			return;
+
+		model->child[nyt] = nyt + 1;
+
+		model->weight[nyt + 1] = 0;
+		model->parent[nyt + 1] = nyt;
+		model->child[nyt + 1] = ADAPTIVE_LEAF | symbol;
+		model->leaf[symbol] = nyt + 1;
+
+		model->weight[nyt + 2] = 0;
+		model->parent[nyt + 2] = nyt;
+		model->child[nyt + 2] = ADAPTIVE_LEAF | ADAPTIVE_NYT;
+		model->nyt = nyt + 2;
+
+		node = nyt + 1;
+	}
+
+	while (node != ADAPTIVE_ROOT)
+	{
+		uint8_t parent = model->parent[node];
+		uint8_t front = node;
+
+		/* First node of the same weight */
+		while (front > ADAPTIVE_ROOT && model->weight[front - 1] == model->weight[node])
+			front--;
+
+		if (front == parent && parent + 1 != node)
+		{
+			/*
+			 * The sibling is the NYT leaf, so the parent has the same weight
+			 * and heads the nodes of that weight. The leaf takes the place
+			 * of the parent, the parent moves one place down and the next
+			 * node goes under it as the sibling of the NYT leaf
+			 */
+			adaptive_swap(model, node, parent + 1);
+			adaptive_swap(model, parent, parent + 1);
+			node = parent;
+		}
+		else if (front != node && front != parent)
+		{
+			adaptive_swap(model, node, front);
+			node = front;
+		}
+
+		model->weight[node]++;
+		node = model->parent[node];
+	}
+	model->weight[ADAPTIVE_ROOT]++;
+
+	if (model->weight[ADAPTIVE_ROOT] >= HUFFMAN_ADAPTIVE_MAX_WEIGHT)
+		adaptive_halve(model);
+}
+
+static void adaptive_halve(huffman_adaptive_t *model)
+{
+	uint8_t symbols[HUFFMAN_ADAPTIVE_LEAVES - 1];
+	uint16_t counts[HUFFMAN_ADAPTIVE_LEAVES - 1];
+	uint8_t seen = 0;
+
+	for (int i = 0; i < 256; i++)
+	{
+		if (model->leaf[i] != 0)
+		{
+			symbols[seen] = i;
+			counts[seen++] = (model->weight[model->leaf[i]] + 1) / 2;
+		}
+	}
+
+	huffman_adaptive_reset(model);
+	for (uint8_t i = 0; i < seen; i++)
+	{
+		while (counts[i]-- > 0)
+			adaptive_update(model, symbols[i]);
+	}
+}
+
+/*********************************************************************************
+ * @brief   :  	Decodes the bytes completed by the input of an adaptive decoder
+ *
+ * @param   :   decoder			- decoder state, its reader set up with the input
+ * 				decoded_buffer	- buffer to be filled with the decoded characters
+ * 				nbytes			- size of decoded_buffer
+ *
+ * @return  : 	size_t			- number of characters decoded
+**********************************************************************************/
+static size_t adaptive_decode(huffman_decoder_t *decoder, uint8_t decoded_buffer[], size_t nbytes)
+{
+	huffman_adaptive_t *model = decoder->model;
+	bit_reader_t *reader = &decoder->reader;
+	size_t dbuf_id = 0;
+
+	while (decoder->remaining > 0 && dbuf_id < nbytes && !decoder->corrupt)
+	{
+		uint8_t node = ADAPTIVE_ROOT;
+		uint8_t code_bits = 0;
+
+		bit_reader_refill(reader);
+
+		uint32_t peek = bit_reader_peek(reader, HUFFMAN_ADAPTIVE_MAX_CODE_BITS);
+		size_t bits_left = bit_reader_bits_left(reader);
+
+		/* Walk down from the root one bit at a time */
+		while (!(model->child[node] & ADAPTIVE_LEAF))
+		{
+			assert(code_bits < HUFFMAN_ADAPTIVE_MAX_CODE_BITS);
+			node = model->child[node] + ((peek >> (HUFFMAN_ADAPTIVE_MAX_CODE_BITS - 1 - code_bits)) & 1);
+			code_bits++;
+		}
+
+		/* The code continues in the next chunk */
+		if (code_bits > bits_left)
+			break;
+
+		uint16_t symbol = model->child[node] & ~ADAPTIVE_LEAF;
+
+		if (symbol == ADAPTIVE_NYT)
+		{
+			/* A byte seen for the first time follows the code */
+			if ((size_t)code_bits + 8 > bits_left)
+				break;
+
+			bit_reader_consume(reader, code_bits);
+			symbol = bit_reader_read(reader, 8);
+
+			if (model->leaf[symbol] != 0)
+			{
+				decoder->corrupt = true;
+				break;
+			}
+		}
+		else
+			bit_reader_consume(reader, code_bits);
+
+		decoded_buffer[dbuf_id++] = symbol;
+		decoder->remaining--;
+		adaptive_update(model, symbol);
+	}
+
+	return dbuf_id;
+}
+
+/*********************************************************************************
+ * @brief   :  	Encodes bytes with the adaptive tree
+ *
+ * 				The code of a byte is the path to its leaf, collected from
+ * 				the leaf up to the root. A byte seen for the first time is
+ * 				sent as the code of the NYT leaf followed by its 8 bits.
+ *
+ * @param   :   encoder	- encoder state
+ * 				data	- next chunk of the message
+ * 				length	- number of bytes in data
+ * 				buffer	- buffer to fill with the encoded bytes
+ * 				nbytes	- size of the buffer
+ *
+ * @return  : 	size_t	- number of bytes written to buffer
+**********************************************************************************/
+static size_t adaptive_encode(huffman_encoder_t *encoder, const uint8_t *data, size_t length,
+								uint8_t *buffer, size_t nbytes)
+{
+	huffman_adaptive_t *model = encoder->model;
+	size_t buf_idx = 0;
+	uint32_t bit_buffer = encoder->bit_buffer;
+	uint8_t bit_count = encoder->bit_count;
+
+	for (const uint8_t *p = data; p < data + length; p++)
+	{
+		uint8_t node = model->leaf[*p];
+		bool literal = (node == 0);
+		uint32_t code = 0;
+		uint8_t code_bits = 0;
+
+		if (literal)
+			node = model->nyt;
+
+		while (node != ADAPTIVE_ROOT)
+		{
+			uint8_t parent = model->parent[node];
+			code |= (uint32_t)(node - model->child[parent]) << code_bits;
+			code_bits++;
+			node = parent;
+		}
+		assert(code_bits <= HUFFMAN_ADAPTIVE_MAX_CODE_BITS);
+
+		/* At most 7 bits are pending, the literal goes in after the full bytes are out */
+		for (int part = 0; part < (literal ? 2 : 1); part++)
+		{
+			if (part == 1)
+			{
+				code = *p;
+				code_bits = 8;
+			}
+
+			bit_buffer = (bit_buffer << code_bits) | code;
+			bit_count += code_bits;
+			encoder->total_bits += code_bits;
+
+			while (bit_count >= 8)
+			{
+				assert(buf_idx < nbytes);
+				bit_count -= 8;
+				buffer[buf_idx++] = bit_buffer >> bit_count;
+			}
+		}
+
+		adaptive_update(model, *p);
+	}
+
+	encoder->bit_buffer = bit_buffer;
+	encoder->bit_count = bit_count;
+
+	return buf_idx;
+}
+
+/*********************************************************************************
+ * @brief   :  	Hashes the 3 bytes a repeat starts with
+ *
+ * @param   :   a, b, c	- the bytes
+ *
+ * @return  : 	uint16_t	- hash of HUFFMAN_LZ_HASH_BITS bits
+**********************************************************************************/
+static inline uint16_t lz_hash(uint8_t a, uint8_t b, uint8_t c)
+{
+	uint32_t key = ((uint32_t)a << 16) | ((uint32_t)b << 8) | c;
+
+	/* Fibonacci hashing, the top bits of the product are the best mixed */
+	return (uint32_t)(key * 2654435761UL) >> (32 - HUFFMAN_LZ_HASH_BITS);
+}
+
+/*********************************************************************************
+ * @brief   :  	Adds a byte to the history
+ *
+ * 				The 3 bytes ending with it are entered in the hash table
+ *
+ * @param   :   lz		- history
+ * 				byte	- byte to add
+ *
+ * @return  : 	void
+**********************************************************************************/
+static inline void lz_push(huffman_lz_t *lz, uint8_t byte)
+{
+	lz->window[LZ_INDEX(lz->position)] = byte;
+	lz->position++;
+
+	if (lz->filled < HUFFMAN_LZ_WINDOW)
+		lz->filled++;
+
+	if (lz->filled >= HUFFMAN_LZ_MIN_MATCH)
+	{
+		uint16_t start = lz->position - 3;
+
+		lz->head[lz_hash(lz->window[LZ_INDEX(start)], lz->window[LZ_INDEX(start + 1)],
+							lz->window[LZ_INDEX(start + 2)])] = start;
+	}
+}
+
+/*********************************************************************************
+ * @brief   :  	Returns the number of bits of the exp-golomb code of the
+ * 				length of a repeat
+ *
+ * @param   :   length	- length of the repeat
+ *
+ * @return  : 	uint8_t	- number of bits
+**********************************************************************************/
+static inline uint8_t lz_length_bits(uint16_t length)
+{
+	uint16_t value = length - HUFFMAN_LZ_MIN_MATCH + (1 << LZ_LENGTH_ORDER);
+	uint8_t top = 0;
+
+	while (value >> (top + 1))
+		top++;
+
+	return 2 * top - LZ_LENGTH_ORDER + 1;
+}
+
+/*********************************************************************************
+ * @brief   :  	Adds bits to the output of an encoder
+ *
+ * @param   :   encoder	- encoder state, less than 8 bits pending
+ * 				code	- bits, aligned to the lsb
+ * 				bits	- number of bits, at most 24
+ * 				buffer	- buffer to fill with the encoded bytes
+ * 				buf_idx	- index of the next byte of buffer
+ * 				nbytes	- size of the buffer
+ *
+ * @return  : 	size_t	- index of the next byte of buffer
+**********************************************************************************/
+static inline size_t lz_put_bits(huffman_encoder_t *encoder, uint32_t code, uint8_t bits,
+									uint8_t *buffer, size_t buf_idx, size_t nbytes)
+{
+	encoder->bit_buffer = (encoder->bit_buffer << bits) | code;
+	encoder->bit_count += bits;
+	encoder->total_bits += bits;
+
+	while (encoder->bit_count >= 8)
+	{
+		assert(buf_idx < nbytes);
+		encoder->bit_count -= 8;
+		buffer[buf_idx++] = encoder->bit_buffer >> encoder->bit_count;
+	}
+
+	return buf_idx;
+}
+
+/*********************************************************************************
+ * @brief   :  	Encodes bytes as characters of the table and repeats of
+ * 				earlier text
+ *
+ * 				The last position of the 3 bytes at each character is looked
+ * 				up in the hash table of the history, and a run of the last
+ * 				character is taken as a repeat from 1 back. A repeat is
+ * 				sent when it takes fewer bits than its characters would, as
+ * 				the escape code, a 1 bit, the exp-golomb code of its length
+ * 				and its distance in HUFFMAN_LZ_WINDOW_BITS bits. An escaped
+ * 				byte has a 0 bit between the escape code and the byte.
+ *
+ * @param   :   encoder	- encoder state
+ * 				data	- next chunk of the message
+ * 				length	- number of bytes in data
+ * 				buffer	- buffer to fill with the encoded bytes
+ * 				nbytes	- size of the buffer
+ *
+ * @return  : 	size_t	- number of bytes written to buffer
+**********************************************************************************/
+static size_t lz_encode(huffman_encoder_t *encoder, const uint8_t *data, size_t length,
+							uint8_t *buffer, size_t nbytes)
+{
+	const uint8_t *lengths = table_lengths(encoder->table);
+	const uint16_t *codes = table_codes(encoder->table);
+	uint8_t escape_bits = lengths[HUFFMAN_ESCAPE_SYMBOL];
+	uint32_t escape = codes[HUFFMAN_ESCAPE_SYMBOL];
+	huffman_lz_t *lz = encoder->lz;
+	size_t buf_idx = 0;
+	size_t i = 0;
+
+	while (i < length)
+	{
+		uint16_t match = 0, distance = 0;
+
+		if (i + HUFFMAN_LZ_MIN_MATCH <= length)
+		{
+			uint16_t start = lz->head[lz_hash(data[i], data[i + 1], data[i + 2])];
+			size_t longest = length - i;
+
+			distance = lz->position - start;
+			if (longest > HUFFMAN_LZ_MAX_MATCH)
+				longest = HUFFMAN_LZ_MAX_MATCH;
+
+			/* A repeat may run on into the bytes it repeats */
+			if (distance > 0 && distance <= lz->filled)
+			{
+				while (match < longest)
+				{
+					uint8_t byte = (match < distance) ? lz->window[LZ_INDEX(start + match)]
+														: data[i + match - distance];
+					if (byte != data[i + match])
+						break;
+					match++;
+				}
+			}
+		}
+
+		/*
+		 * A run of the last character is a repeat of it from 1 back. The
+		 * hash only finds it 3 characters into the run
+		 */
+		if (lz->filled > 0 && i + HUFFMAN_LZ_MIN_MATCH <= length)
+		{
+			uint8_t last = lz->window[LZ_INDEX(lz->position - 1)];
+			uint16_t run = 0;
+
+			while (i + run < length && run < HUFFMAN_LZ_MAX_MATCH && data[i + run] == last)
+				run++;
+
+			if (run > match)
+			{
+				match = run;
+				distance = 1;
+			}
+		}
+
+		if (match >= HUFFMAN_LZ_MIN_MATCH)
+		{
+			uint32_t literal_bits = 0;
+			uint8_t match_bits = escape_bits + 1 + lz_length_bits(match) + HUFFMAN_LZ_WINDOW_BITS;
+
+			for (uint16_t k = 0; k < match; k++)
+			{
+				uint8_t code_bits = lengths[data[i + k]];
+				literal_bits += code_bits ? code_bits : escape_bits + 9;
+			}
+
+			if (match_bits < literal_bits)
+			{
+				uint16_t value = match - HUFFMAN_LZ_MIN_MATCH + (1 << LZ_LENGTH_ORDER);
+				uint8_t length_bits = lz_length_bits(match);
+
+				buf_idx = lz_put_bits(encoder, (escape << 1) | 1, escape_bits + 1,
+										buffer, buf_idx, nbytes);
+
+				/* Zeros for the top bits of the value, then the value */
+				buf_idx = lz_put_bits(encoder, value, length_bits, buffer, buf_idx, nbytes);
+				buf_idx = lz_put_bits(encoder, distance - 1, HUFFMAN_LZ_WINDOW_BITS, buffer, buf_idx, nbytes);
+
+				for (uint16_t k = 0; k < match; k++)
+					lz_push(lz, data[i++]);
+				continue;
+			}
+		}
+
+		if (lengths[data[i]] > 0)
+			buf_idx = lz_put_bits(encoder, codes[data[i]], lengths[data[i]],
+									buffer, buf_idx, nbytes);
+		else
+			buf_idx = lz_put_bits(encoder, (escape << 9) | data[i], escape_bits + 9,
+									buffer, buf_idx, nbytes);
+
+		lz_push(lz, data[i++]);
+	}
+
+	return buf_idx;
+}
+
+/*********************************************************************************
+ * @brief   :  	Decodes the characters and repeats completed by the input
+ * 				of an LZ decoder
+ *
+ * @param   :   decoder			- decoder state, its reader set up with the input
+ * 				decoded_buffer	- buffer to be filled with the decoded characters
+ * 				nbytes			- size of decoded_buffer
+ *
+ * @return  : 	size_t			- number of characters decoded
+**********************************************************************************/
+static size_t lz_decode(huffman_decoder_t *decoder, uint8_t decoded_buffer[], size_t nbytes)
+{
+	const huffman_table_t *table = use_table(decoder->table);
+	huffman_lz_t *lz = decoder->lz;
+	bit_reader_t *reader = &decoder->reader;
+	size_t dbuf_id = 0;
+
+	while (decoder->remaining > 0 && dbuf_id < nbytes && !decoder->corrupt)
+	{
+		bit_reader_refill(reader);
+
+		uint32_t peek = bit_reader_peek(reader, 24);
+		size_t bits_left = bit_reader_bits_left(reader);
+
+		if (decoder->repeat)
+		{
+			uint8_t zeros = 0;
+
+			while (zeros <= LZ_LENGTH_MAX_ZEROS && !(peek & (1UL << (23 - zeros))))
+				zeros++;
+
+			uint8_t length_bits = 2 * zeros + LZ_LENGTH_ORDER + 1;
+
+			if (zeros > LZ_LENGTH_MAX_ZEROS)
+			{
+				if (bits_left >= zeros)
+					decoder->corrupt = true;
+				break;
+			}
+
+			/* The length or the distance continues in the next chunk */
+			if ((size_t)length_bits + HUFFMAN_LZ_WINDOW_BITS > bits_left)
+				break;
+
+			uint16_t match = ((peek >> (24 - length_bits)) & ((1UL << length_bits) - 1))
+								- (1 << LZ_LENGTH_ORDER) + HUFFMAN_LZ_MIN_MATCH;
+			uint16_t distance = ((peek >> (24 - length_bits - HUFFMAN_LZ_WINDOW_BITS))
+								& (HUFFMAN_LZ_WINDOW - 1)) + 1;
+
+			if (match > decoder->remaining || distance > lz->filled)
+			{
+				decoder->corrupt = true;
+				break;
+			}
+
+			/* Not enough room, the caller gets the repeat with the next chunk */
+			if (match > nbytes - dbuf_id)
+				break;
+
+			bit_reader_consume(reader, length_bits + HUFFMAN_LZ_WINDOW_BITS);
+			decoder->repeat = false;
+
+			for (uint16_t k = 0; k < match; k++)
+			{
+				uint8_t byte = lz->window[LZ_INDEX(lz->position - distance)];
+
+				decoded_buffer[dbuf_id++] = byte;
+				lz_push(lz, byte);
+			}
+			decoder->remaining -= match;
+			continue;
+		}
+
+		huffman_lookup_t entry = lookup_code(table, peek >> 8);
+		uint8_t code_bits = LOOKUP_BITS(entry);
+		uint8_t byte;
+
+		if (code_bits == 0 || code_bits == HUFFMAN_INVALID)
+		{
+			/* Not a valid code even though all of its bits are here */
+			if (bits_left >= table->max_code_bits)
+				decoder->corrupt = true;
+			break;
+		}
+
+		if (LOOKUP_SYMBOL(entry) == HUFFMAN_ESCAPE_SYMBOL)
+		{
+			if ((size_t)code_bits + 1 > bits_left)
+				break;
+
+			/* A 1 after the escape starts a repeat */
+			if (peek & (1UL << (23 - code_bits)))
+			{
+				bit_reader_consume(reader, code_bits + 1);
+				decoder->repeat = true;
+				continue;
+			}
+
+			byte = peek >> (15 - code_bits);
+			code_bits += 9;
+		}
+		else if (LOOKUP_SYMBOL(entry) < HUFFMAN_ESCAPE_SYMBOL)
+			byte = LOOKUP_SYMBOL(entry);
+		else
+		{
+			/* The repeats take the place of the tokens, the code is corrupt once all of it is here */
+			if (code_bits <= bits_left)
+				decoder->corrupt = true;
+			break;
+		}
+
+		/* The code continues in the next chunk */
+		if (code_bits > bits_left)
+			break;
+
+		bit_reader_consume(reader, code_bits);
+		decoded_buffer[dbuf_id++] = byte;
+		decoder->remaining--;
+		lz_push(lz, byte);
+	}
+
+	return dbuf_id;
+}
+
+/*********************************************************************************
+ * @brief   :  	Decodes characters from a bit reader
+ *
+ * 				The data must be encoded with table 0
+ *
+ * @param   :   reader			- bit reader over the encoded data
+ * 				decoded_bytes	- number of characters to decode
+ * 				decoded_buffer	- buffer to be filled with the decoded characters
+ *
+ * @return  : 	uint16_t		- number of characters decoded, less than
+ * 								  decoded_bytes if the input is corrupt
+**********************************************************************************/
+uint16_t huffman_decode_reader(bit_reader_t *reader, uint16_t decoded_bytes, uint8_t decoded_buffer[])
+{
+	uint16_t dbuf_id = 0;
+
+	while (dbuf_id < decoded_bytes)
+	{
+		uint8_t bits;
+
+		bit_reader_refill(reader);
+
+		/* Any code, escaped or not, fits in a 24 bit peek */
+		uint16_t symbol = decode_symbol(use_table(0), bit_reader_peek(reader, 24), &bits);
+
+		/* Corrupt input, the bits do not start any code or the token runs past the end */
+		if (bits == 0 || symbol_length(symbol) > decoded_bytes - dbuf_id)
+			break;
+
+		dbuf_id += write_symbol(symbol, decoded_buffer + dbuf_id);
+		bit_reader_consume(reader, bits);
+	}
+
+	return dbuf_id;
+}
+
+/*********************************************************************************
+ * @brief   :  	Decodes the encoded buffer and prints the string
+ *
+ * 				The encoded buffer is only read, so it can be decoded again.
+ * 				The data must be encoded with table 0
+ *
+ * @param   :   encoded_buffer	- encoded buffer
+ * 				encoded_bytes	- number of bytes in the encoded buffer
+ * 				decoded_bytes	- number of original bytes
+ * 				decoded_buffer	- buffer to be filled with the decoded string
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_decode(const uint8_t encoded_buffer[], uint16_t encoded_bytes,
+						uint16_t decoded_bytes, uint8_t decoded_buffer[])
+{
+	bit_reader_t reader;
+
+	bit_reader_init(&reader, encoded_buffer, encoded_bytes);
+	uint16_t dbuf_id = huffman_decode_reader(&reader, decoded_bytes, decoded_buffer);
+
+	decoded_buffer[dbuf_id]= '\0';
+	printf("%s\n", decoded_buffer);
+}
+
+/*********************************************************************************
+ * @brief   :  	Starts decoding a message which arrives in chunks
+ *
+ * @param   :   decoder			- decoder state
+ * 				decoded_bytes	- number of characters in the message
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_decoder_init(huffman_decoder_t *decoder, uint16_t decoded_bytes)
+{
+	bit_reader_init(&decoder->reader, NULL, 0);
+	decoder->remaining = decoded_bytes;
+	decoder->corrupt = false;
+	decoder->model = NULL;
+	decoder->table = 0;
+	decoder->context = false;
+	decoder->previous = HUFFMAN_CONTEXT_START;
+	decoder->lz = NULL;
+	decoder->repeat = false;
+}
+
+/*********************************************************************************
+ * @brief   :  	Starts decoding a message encoded with one of the tables
+ *
+ * @param   :   decoder			- decoder state
+ * 				decoded_bytes	- number of characters in the message
+ * 				table			- ID of a table huffman_has_table accepts
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_decoder_init_table(huffman_decoder_t *decoder, uint16_t decoded_bytes, uint8_t table)
+{
+	assert(huffman_has_table(table));
+	huffman_decoder_init(decoder, decoded_bytes);
+	decoder->table = table;
+}
+
+/*********************************************************************************
+ * @brief   :  	Starts decoding the next message of a stream with one of
+ * 				the tables
+ *
+ * 				The bits left over from the last chunk are the first bits
+ * 				of the message
+ *
+ * @param   :   decoder			- decoder state of a static table
+ * 				decoded_bytes	- number of characters in the message
+ * 				table			- ID of a table huffman_has_table accepts
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_decoder_next_message(huffman_decoder_t *decoder, uint16_t decoded_bytes, uint8_t table)
+{
+	assert(huffman_has_table(table) && decoder->model == NULL && decoder->lz == NULL && !decoder->context);
+	decoder->remaining = decoded_bytes;
+	decoder->table = table;
+}
+
+/*********************************************************************************
+ * @brief   :  	Starts decoding a message of the order-1 coder
+ *
+ * @param   :   decoder			- decoder state
+ * 				decoded_bytes	- number of characters in the message
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_decoder_init_context(huffman_decoder_t *decoder, uint16_t decoded_bytes)
+{
+	huffman_decoder_init(decoder, decoded_bytes);
+	decoder->context = true;
+}
+
+/*********************************************************************************
+ * @brief   :  	Starts decoding a message encoded with an adaptive tree
+ *
+ * @param   :   decoder			- decoder state
+ * 				decoded_bytes	- number of characters in the message
+ * 				model			- adaptive tree, updated as the message is decoded
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_decoder_init_adaptive(huffman_decoder_t *decoder, uint16_t decoded_bytes,
+										huffman_adaptive_t *model)
+{
+	huffman_decoder_init(decoder, decoded_bytes);
+	decoder->model = model;
+}
+
+/*********************************************************************************
+ * @brief   :  	Starts decoding a message of characters and repeats
+ *
+ * @param   :   decoder			- decoder state
+ * 				decoded_bytes	- number of characters in the message
+ * 				table			- ID of the table of the characters
+ * 				lz				- history the repeats point into, the decoded
+ * 								  characters are added to it
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_decoder_init_lz(huffman_decoder_t *decoder, uint16_t decoded_bytes, uint8_t table,
+								huffman_lz_t *lz)
+{
+	huffman_decoder_init_table(decoder, decoded_bytes, table);
+	decoder->lz = lz;
+}
+
+/*********************************************************************************
+ * @brief   :  	Decodes the characters completed by the next chunk of input
+ *
+ * 				Bits at the end of the chunk which do not make a whole code
+ * 				are kept in the decoder for the next call
+ *
+ * @param   :   decoder			- decoder state
+ * 				data			- next chunk of encoded data
+ * 				length			- number of bytes in data
+ * 				decoded_buffer	- buffer to be filled with the decoded characters
+ * 				nbytes			- size of decoded_buffer, at least
+ * 								  HUFFMAN_DECODED_SIZE(length) or the rest of the message
+ *
+ * @return  : 	size_t			- number of characters decoded
+**********************************************************************************/
+size_t huffman_decoder_feed(huffman_decoder_t *decoder, const uint8_t *data, size_t length,
+								uint8_t decoded_buffer[], size_t nbytes)
+{
+	bit_reader_t *reader = &decoder->reader;
+	size_t dbuf_id = 0;
+
+	/* Drop the padding loaded past the end of the last chunk, its bits are all 0 */
+	if (reader->padding > reader->count)
+		reader->padding = reader->count;
+	reader->count -= reader->padding;
+	reader->padding = 0;
+
+	/* Continue with the bits left over from the last chunk */
+	reader->data = data;
+	reader->length = length;
+	reader->position = 0;
+
+	if (decoder->model != NULL)
+		dbuf_id = adaptive_decode(decoder, decoded_buffer, nbytes);
+	else if (decoder->lz != NULL)
+		dbuf_id = lz_decode(decoder, decoded_buffer, nbytes);
+	else
+	{
+		while (decoder->remaining > 0 && dbuf_id < nbytes && !decoder->corrupt)
+		{
+			uint8_t bits;
+
+			/* The order-1 coder takes the table of the previous character */
+			const huffman_table_t *table = use_table(decoder->context ? huffman_context_map[decoder->previous]
+																		: decoder->table);
+
+			bit_reader_refill(reader);
+
+			uint16_t symbol = decode_symbol(table, bit_reader_peek(reader, 24), &bits);
+			size_t bits_left = bit_reader_bits_left(reader);
+
+			if (bits == 0)
+			{
+				/* Not a valid code even though all of its bits are here */
+				if (bits_left >= table->max_code_bits)
+					decoder->corrupt = true;
+				break;
+			}
+
+			/* The code continues in the next chunk */
+			if (bits > bits_left)
+				break;
+
+			uint8_t count = symbol_length(symbol);
+
+			if (count > decoder->remaining)
+			{
+				decoder->corrupt = true;
+				break;
+			}
+
+			/* Not enough room, the caller gets the token with the next chunk */
+			if (count > nbytes - dbuf_id)
+				break;
+
+			write_symbol(symbol, decoded_buffer + dbuf_id);
+			dbuf_id += count;
+			decoder->remaining -= count;
+			decoder->previous = decoded_buffer[dbuf_id - 1];
+			bit_reader_consume(reader, bits);
+		}
+	}
+
+	/* The whole chunk must be loaded, there is no way to feed its rest again */
+	assert(decoder->remaining == 0 || decoder->corrupt || reader->position == reader->length);
+
+	return dbuf_id;
+}
+
+/*********************************************************************************
+ * @brief   :  	Starts encoding a message in chunks
+ *
+ * @param   :   encoder	- encoder state
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_encoder_init(huffman_encoder_t *encoder)
+{
+	encoder->bit_buffer = 0;
+	encoder->bit_count = 0;
+	encoder->total_bits = 0;
+	encoder->model = NULL;
+	encoder->table = 0;
+	encoder->context = false;
+	encoder->previous = HUFFMAN_CONTEXT_START;
+	encoder->lz = NULL;
+	encoder->pending_count = 0;
+}
+
+/*********************************************************************************
+ * @brief   :  	Starts encoding a message in chunks with one of the tables
+ *
+ * @param   :   encoder	- encoder state
+ * 				table	- ID of a table huffman_has_table accepts
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_encoder_init_table(huffman_encoder_t *encoder, uint8_t table)
+{
+	assert(huffman_has_table(table));
+	huffman_encoder_init(encoder);
+	encoder->table = table;
+}
+
+/*********************************************************************************
+ * @brief   :  	Starts encoding the next message of a stream with one of
+ * 				the tables
+ *
+ * 				The bits left over from the last message are sent in front
+ * 				of the message
+ *
+ * @param   :   encoder	- encoder state of a static table, with no characters
+ * 						  held back
+ * 				table	- ID of a table huffman_has_table accepts
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_encoder_next_message(huffman_encoder_t *encoder, uint8_t table)
+{
+	assert(huffman_has_table(table) && encoder->pending_count == 0);
+	encoder->table = table;
+}
+
+/*********************************************************************************
+ * @brief   :  	Starts encoding a message in chunks with the order-1 coder
+ *
+ * 				Every character or token is coded with the table
+ * 				huffman_context_map gives for the character before it
+ *
+ * @param   :   encoder	- encoder state
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_encoder_init_context(huffman_encoder_t *encoder)
+{
+	huffman_encoder_init(encoder);
+	encoder->context = true;
+}
+
+/*********************************************************************************
+ * @brief   :  	Starts encoding a message in chunks with an adaptive tree
+ *
+ * @param   :   encoder	- encoder state
+ * 				model	- adaptive tree, updated as the message is encoded
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_encoder_init_adaptive(huffman_encoder_t *encoder, huffman_adaptive_t *model)
+{
+	huffman_encoder_init(encoder);
+	encoder->model = model;
+}
+
+/*********************************************************************************
+ * @brief   :  	Starts encoding a message with repeats of earlier text
+ *
+ * @param   :   encoder	- encoder state
+ * 				table	- ID of the table of the characters
+ * 				lz		- history to send repeats from, the characters are
+ * 						  added to it as they are encoded
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_encoder_init_lz(huffman_encoder_t *encoder, uint8_t table, huffman_lz_t *lz)
+{
+	huffman_encoder_init_table(encoder, table);
+	encoder->lz = lz;
+}
+
+/*********************************************************************************
+ * @brief   :  	Empties a history
+ *
+ * @param   :   lz	- history
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_lz_reset(huffman_lz_t *lz)
+{
+	lz->position = 0;
+	lz->filled = 0;
+}
+
+/*********************************************************************************
+ * @brief   :  	Adds a message sent without repeats to a history
+ *
+ * @param   :   lz		- history
+ * 				data	- message
+ * 				length	- number of bytes in data
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_lz_append(huffman_lz_t *lz, const uint8_t *data, size_t length)
+{
+	for (size_t i = 0; i < length; i++)
+		lz_push(lz, data[i]);
+}
+
+/*********************************************************************************
+ * @brief   :  	Empties an adaptive tree
+ *
+ * 				The tree starts as the NYT leaf alone
+ *
+ * @param   :   model	- adaptive tree
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_adaptive_reset(huffman_adaptive_t *model)
+{
+	memset(model->leaf, 0, sizeof(model->leaf));
+
+	model->weight[ADAPTIVE_ROOT] = 0;
+	model->parent[ADAPTIVE_ROOT] = ADAPTIVE_ROOT;
+	model->child[ADAPTIVE_ROOT] = ADAPTIVE_LEAF | ADAPTIVE_NYT;
+	model->nyt = ADAPTIVE_ROOT;
+}
+
+/*********************************************************************************
+ * @brief   :  	Adds the bytes of a stored message to an adaptive tree
+ *
+ * 				The tree ends up as encoding or decoding the bytes leaves it
+ *
+ * @param   :   model	- adaptive tree
+ * 				data	- bytes of the message
+ * 				length	- number of bytes in data
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_adaptive_add(huffman_adaptive_t *model, const uint8_t *data, size_t length)
+{
+	for (size_t i = 0; i < length; i++)
+		adaptive_update(model, data[i]);
+}
+
+/*********************************************************************************
+ * @brief   :  	Encodes the symbol at the start of the characters held back
+ *
+ * 				The order-1 coder takes the table of the character before the symbol
+ *
+ * @param   :   encoder	- encoder state of a static table or of the order-1 coder
+ * 				buffer	- buffer to fill with the encoded bytes
+ * 				nbytes	- size of the buffer
+ *
+ * @return  : 	size_t	- number of bytes written to buffer
+**********************************************************************************/
+static size_t encode_pending(huffman_encoder_t *encoder, uint8_t *buffer, size_t nbytes)
+{
+	uint8_t table = encoder->context ? huffman_context_map[encoder->previous] : encoder->table;
+	const uint8_t *lengths = table_lengths(table);
+	const uint16_t *codes = table_codes(table);
+	size_t buf_idx = 0;
+	uint8_t matched;
+
+	uint16_t symbol = match_token(lengths, encoder->pending, encoder->pending_count, &matched);
+	uint32_t code = codes[symbol];
+	uint8_t code_bits = lengths[symbol];
+
+	if (code_bits == 0)
+	{
+		code = ((uint32_t)codes[HUFFMAN_ESCAPE_SYMBOL] << 8) | symbol;
+		code_bits = lengths[HUFFMAN_ESCAPE_SYMBOL] + 8;
+	}
+
+	/* At most 7 bits are pending here, so any code fits in the 32 bit buffer */
+	encoder->bit_buffer = (encoder->bit_buffer << code_bits) | code;
+	encoder->bit_count += code_bits;
+	encoder->total_bits += code_bits;
+
+	while (encoder->bit_count >= 8)
+	{
+		assert(buf_idx < nbytes);
+		encoder->bit_count -= 8;
+		buffer[buf_idx++] = encoder->bit_buffer >> encoder->bit_count;
+	}
+
+	encoder->previous = encoder->pending[matched - 1];
+	encoder->pending_count -= matched;
+	memmove(encoder->pending, encoder->pending + matched, encoder->pending_count);
+
+	return buf_idx;
+}
+
+/*********************************************************************************
+ * @brief   :  	Encodes the next chunk of a message with a static table or
+ * 				the order-1 coder
+ *
+ * 				The characters are held back until HUFFMAN_MAX_TOKEN_LENGTH
+ * 				of them are known, so the longest token at the first one is
+ * 				found whatever the chunks are. The message encodes the same
+ * 				as huffman_encoded_bits counts it
+ *
+ * @param   :   encoder	- encoder state
+ * 				data	- next chunk of the message
+ * 				length	- number of bytes in data
+ * 				buffer	- buffer to fill with the encoded bytes
+ * 				nbytes	- size of the buffer
+ *
+ * @return  : 	size_t	- number of bytes written to buffer
+**********************************************************************************/
+static size_t token_encode(huffman_encoder_t *encoder, const uint8_t *data, size_t length,
+							uint8_t *buffer, size_t nbytes)
+{
+	size_t buf_idx = 0;
+
+	for (const uint8_t *p = data; p < data + length; p++)
+	{
+		encoder->pending[encoder->pending_count++] = *p;
+
+		/* A symbol takes at least one character, so a code goes out for every one added */
+		if (encoder->pending_count == HUFFMAN_MAX_TOKEN_LENGTH)
+			buf_idx += encode_pending(encoder, buffer + buf_idx, nbytes - buf_idx);
+	}
+
+	return buf_idx;
+}
+
+/*********************************************************************************
+ * @brief   :  	Encodes the next chunk of a message
+ *
+ * 				Credits to Prof. Howdy Pierce for the original encoder
+ *
+ * 				The code of each character is found by indexing the table with
+ * 				the character, and the bits are collected in a 32 bit register
+ * 				which is written out a whole byte at a time. Less than 8 bits
+ * 				are left in the encoder for the next chunk. Bytes without a
+ * 				code are sent as the escape code followed by the 8 bits of
+ * 				the byte.
+ *
+ * 				A static table also codes the tokens of lookup_table.h, its
+ * 				encoder holds back the characters a token may start with.
+ * 				An encoder started with huffman_encoder_init_adaptive codes
+ * 				with its adaptive tree instead of the table. One started with
+ * 				huffman_encoder_init_context codes tokens as well and switches
+ * 				table after every symbol, one started with huffman_encoder_init_lz
+ * 				also sends repeats.
+ *
+ * @param   :   encoder	- encoder state
+ * 				data	- next chunk of the message
+ * 				length	- number of bytes in data
+ * 				buffer	- buffer to fill with the encoded bytes
+ * 				nbytes	- size of the buffer, at least HUFFMAN_ENCODED_SIZE(length)
+ *
+ * @return  : 	size_t	- number of bytes written to buffer
+**********************************************************************************/
+size_t huffman_encoder_feed(huffman_encoder_t *encoder, const uint8_t *data, size_t length,
+								uint8_t *buffer, size_t nbytes)
+{
+	if (encoder->model != NULL)
+		return adaptive_encode(encoder, data, length, buffer, nbytes);
+	if (encoder->lz != NULL)
+		return lz_encode(encoder, data, length, buffer, nbytes);
+
+	return token_encode(encoder, data, length, buffer, nbytes);
+}
+
+/*********************************************************************************
+ * @brief   :  	Writes out the bits left in the encoder
+ *
+ * @param   :   encoder	- encoder state
+ * 				buffer	- buffer to fill with the last byte
+ * 				nbytes	- size of the buffer
+ *
+ * @return  : 	size_t	- number of bytes written to buffer, 0 or 1
+**********************************************************************************/
+size_t huffman_encoder_flush(huffman_encoder_t *encoder, uint8_t *buffer, size_t nbytes)
+{
+	size_t buf_idx = 0;
+
+	/* The characters held back end the message, no token continues them */
+	while (encoder->pending_count > 0)
+		buf_idx += encode_pending(encoder, buffer + buf_idx, nbytes - buf_idx);
+
+	if (encoder->bit_count == 0)
+		return buf_idx;
+
+	/* Write the last partial byte padded with zeroes */
+	assert(nbytes > buf_idx);
+	buffer[buf_idx++] = encoder->bit_buffer << (8 - encoder->bit_count);
+	encoder->bit_buffer = 0;
+	encoder->bit_count = 0;
+
+	return buf_idx;
+}
+
+/*********************************************************************************
+ * @brief   :  	Ends a message of a stream coded with a static table
+ *
+ * 				The characters held back are encoded and the whole bytes
+ * 				written out. Less than 8 bits stay in the encoder, the next
+ * 				message of the stream continues them with the same table
+ *
+ * @param   :   encoder	- encoder state of a static table
+ * 				buffer	- buffer to fill with the last bytes
+ * 				nbytes	- size of the buffer
+ *
+ * @return  : 	size_t	- number of bytes written to buffer
+**********************************************************************************/
+size_t huffman_encoder_end_message(huffman_encoder_t *encoder, uint8_t *buffer, size_t nbytes)
+{
+	size_t buf_idx = 0;
+
+	assert(encoder->model == NULL && encoder->lz == NULL && !encoder->context);
+
+	while (encoder->pending_count > 0)
+		buf_idx += encode_pending(encoder, buffer + buf_idx, nbytes - buf_idx);
+
+	return buf_idx;
+}
+
+/*********************************************************************************
+ * @brief   :  	Ends a stream by padding the bits left in the encoder
+ *
+ * 				The padding is the start of the escape code, which the
+ * 				decoder waits for 8 more bits after, so it never decodes
+ * 				the padding as a character
+ *
+ * @param   :   encoder	- encoder state of a static table
+ * 				buffer	- buffer to fill with the last byte
+ * 				nbytes	- size of the buffer
+ *
+ * @return  : 	size_t	- number of bytes written to buffer, 0 or 1
+**********************************************************************************/
+size_t huffman_encoder_pad(huffman_encoder_t *encoder, uint8_t *buffer, size_t nbytes)
+{
+	uint8_t escape_bits = table_lengths(encoder->table)[HUFFMAN_ESCAPE_SYMBOL];
+
+	if (encoder->bit_count == 0)
+		return 0;
+
+	/* The escape and its 8 bits are longer than the 7 bits of padding at most */
+	uint8_t padding = 8 - encoder->bit_count;
+	uint32_t code = (uint32_t)table_codes(encoder->table)[HUFFMAN_ESCAPE_SYMBOL] << 8;
+
+	assert(nbytes > 0 && escape_bits > 0);
+	buffer[0] = (encoder->bit_buffer << padding) | (code >> (escape_bits + 8 - padding));
+	encoder->bit_buffer = 0;
+	encoder->bit_count = 0;
+
+	return 1;
+}
+
+/*********************************************************************************
+ * @brief   :  	Returns the number of bits a message encodes to with
+ * 				one of the tables
+ *
+ * @param   :   table	- ID of a table huffman_has_table accepts
+ * 				data	- message
+ * 				length	- number of bytes in data
+ *
+ * @return  : 	uint32_t	- number of encoded bits
+**********************************************************************************/
+uint32_t huffman_encoded_bits(uint8_t table, const uint8_t *data, size_t length)
+{
+	const uint8_t *lengths = table_lengths(table);
+	uint32_t bits = 0;
+	uint8_t matched;
+
+	for (size_t i = 0; i < length; i += matched)
+	{
+		uint16_t symbol = match_token(lengths, data + i, length - i, &matched);
+
+		if (lengths[symbol] > 0)
+			bits += lengths[symbol];
+		else
+			bits += lengths[HUFFMAN_ESCAPE_SYMBOL] + 8;
+	}
+
+	return bits;
+}
+
+/*********************************************************************************
+ * @brief   :  	Returns the number of bits a message encodes to with the
+ * 				order-1 coder
+ *
+ * @param   :   data	- message
+ * 				length	- number of bytes in data
+ *
+ * @return  : 	uint32_t	- number of encoded bits
+**********************************************************************************/
+uint32_t huffman_context_bits(const uint8_t *data, size_t length)
+{
+	uint8_t previous = HUFFMAN_CONTEXT_START;
+	uint32_t bits = 0;
+	uint8_t matched;
+
+	for (size_t i = 0; i < length; i += matched)
+	{
+		const uint8_t *lengths = table_lengths(huffman_context_map[previous]);
+		uint16_t symbol = match_token(lengths, data + i, length - i, &matched);
+
+		if (lengths[symbol] > 0)
+			bits += lengths[symbol];
+		else
+			bits += lengths[HUFFMAN_ESCAPE_SYMBOL] + 8;
+		previous = data[i + matched - 1];
+	}
+
+	return bits;
+}
+
+/*********************************************************************************
+ * @brief   :  	Picks the table which encodes a message to the fewest bits
+ *
+ * @param   :   data		- message
+ * 				length		- number of bytes in data
+ * 				table_count	- number of tables to pick from, the static tables
+ * 							  and the runtime table after them
+ * 				bits		- filled with the number of encoded bits, may be NULL
+ *
+ * @return  : 	uint8_t		- ID of the table, the lowest one on a tie
+**********************************************************************************/
+uint8_t huffman_select_table(const uint8_t *data, size_t length, uint8_t table_count, uint32_t *bits)
+{
+	uint8_t best = 0;
+	uint32_t best_bits = huffman_encoded_bits(0, data, length);
+
+	for (uint8_t index = 1; index < table_count; index++)
+	{
+		uint8_t table = table_in_use(index);
+		uint32_t table_bits = huffman_encoded_bits(table, data, length);
+
+		if (table_bits < best_bits)
+		{
+			best = table;
+			best_bits = table_bits;
+		}
+	}
+
+	if (bits != NULL)
+		*bits = best_bits;
+
+	return best;
+}
+
+/*********************************************************************************
+ * @brief   :  	Encodes the message using the huffman lookup table for
+ * 				data compression
+ *
+ * @param   :   message	- message to be encoded
+ * 				buffer	- buffer to fill with encoded message
+ * 				nbytes	- size of the buffer
+ *
+ * @return  : 	int		- number of encoded bits
+**********************************************************************************/
+int huffman_encode(const char *message, uint8_t *buffer, size_t nbytes)
+{
+	huffman_encoder_t encoder;
+	size_t length = strlen(message);
+
+	huffman_encoder_init(&encoder);
+	size_t buf_idx = huffman_encoder_feed(&encoder, (const uint8_t *)message, length, buffer, nbytes);
+	huffman_encoder_flush(&encoder, buffer + buf_idx, nbytes - buf_idx);
+
+	return encoder.total_bits;
+}
+
+/*********************************************************************************
+ * @brief   :  	Counts the bytes of a message for the next rebuild of the
+ * 				runtime table
+ *
+ * @param   :   data	- message
+ * 				length	- number of bytes in data
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_count(const uint8_t *data, size_t length)
+{
+	for (size_t i = 0; i < length; i++)
+		symbol_counts[data[i]]++;
+
+	counted_bytes += length;
+}
+
+/*********************************************************************************
+ * @brief   :  	Replaces sorted weights by the lengths of a huffman code
+ *
+ * 				In-place calculation of minimum-redundancy codes by Moffat and
+ * 				Katajainen. The first pass builds the tree with parent pointers
+ * 				in the array, the second one turns them into depths of the
+ * 				internal nodes and the third one into the depths of the leaves.
+ *
+ * @param   :   weights	- weights in increasing order, replaced by the code lengths
+ * 				n		- number of weights
+ *
+ * @return  : 	void
+**********************************************************************************/
+static void minimum_redundancy_lengths(uint16_t weights[], int n)
+{
+	uint16_t *A = weights;
+	int root, leaf, next, avbl, used, depth;
+
+	if (n == 1)
+	{
+		A[0] = 1;
+		return;
+	}
+
+	A[0] += A[1];
+	root = 0;
+	leaf = 2;
+	for (next = 1; next < n - 1; next++)
+	{
+		/* First item of the pair, a leaf or an internal node */
+		if (leaf >= n || A[root] < A[leaf])
+		{
+			A[next] = A[root];
+			A[root++] = next;
+		}
+		else
+			A[next] = A[leaf++];
+
+		/* Second item of the pair */
+		if (leaf >= n || (root < next && A[root] < A[leaf]))
+		{
+			A[next] += A[root];
+			A[root++] = next;
+		}
+		else
+			A[next] += A[leaf++];
+	}
+
+	A[n - 2] = 0;
+	for (next = n - 3; next >= 0; next--)
+		A[next] = A[A[next]] + 1;
+
+	avbl = 1;
+	used = depth = 0;
+	root = n - 2;
+	next = n - 1;
+	while (avbl > 0)
+	{
+		while (root >= 0 && A[root] == depth)
+		{
+			used++;
+			root--;
+		}
+		while (avbl > used)
+		{
+			A[next--] = depth;
+			avbl--;
+		}
+		avbl = 2 * used;
+		depth++;
+		used = 0;
+	}
+}
+
+/*********************************************************************************
+ * @brief   :  	Limits code lengths to a maximum length
+ *
+ * 				Longer codes are cut to the limit, which takes more code space
+ * 				than there is. The least frequent codes below the limit are
+ * 				then made a bit longer until the codes fit again.
+ *
+ * @param   :   lengths		- code lengths of symbols in order of increasing weight
+ * 				n			- number of lengths
+ * 				max_bits	- longest code allowed, room for n codes
+ *
+ * @return  : 	void
+**********************************************************************************/
+static void limit_lengths(uint16_t lengths[], int n, uint8_t max_bits)
+{
+	/* Code space used, in units of the space of a code of the maximum length */
+	uint32_t space = 0;
 
-#include <assert.h>
-#include "lookup_table.h"
-#include "huffman_code.h"
+	for (int i = 0; i < n; i++)
+	{
+		if (lengths[i] > max_bits)
+			lengths[i] = max_bits;
+		space += 1UL << (max_bits - lengths[i]);
+	}
+
+	while (space > (1UL << max_bits))
+	{
+		int i = 0;
+
+		while (lengths[i] >= max_bits)
+			i++;
+
+		lengths[i]++;
+		space -= 1UL << (max_bits - lengths[i]);
+	}
+}
 
 /*********************************************************************************
- * @brief   :  	Decodes the encoded buffer and prints the string
+ * @brief   :  	Works out limited code lengths from counts in one go
  *
- * @param   :   encoded_buffer	- encoded buffer
- * 				encoded_bits	- number of original bytes
- * 				decoded_buffer	- buffer to be filled with the decoded string
+ * 				The same steps as the rebuild of the runtime table, for the
+ * 				few symbols of the code of the lengths or a block table
+ *
+ * @param   :   counts		- count of every symbol
+ * 				n			- number of symbols, at most HUFFMAN_NUM_SYMBOLS
+ * 				max_bits	- longest code allowed
+ * 				lengths		- set to the code length of every symbol, 0 if
+ * 							  it was not counted
  *
  * @return  : 	void
 **********************************************************************************/
-void huffman_decode(uint8_t encoded_buffer[], uint16_t encoded_bits, uint8_t decoded_buffer[])
+static void lengths_from_counts(const uint32_t counts[], int n, uint8_t max_bits, uint8_t lengths[])
 {
-	uint8_t *buf = encoded_buffer;
+	uint16_t symbols[HUFFMAN_NUM_SYMBOLS];
+	uint16_t weights[HUFFMAN_NUM_SYMBOLS];
+	uint32_t total = 0;
+	uint8_t shift = 0;
+	int count = 0;
+
+	for (int i = 0; i < n; i++)
+	{
+		total += counts[i];
+		lengths[i] = 0;
+	}
 
-	uint16_t ebuf_id = 0, dbuf_id = 0;
-	uint16_t code1 = 0, code_length = 1;
-	uint16_t i = 1, bit_pos=0;
-	//bool char_found = false;
+	/* Each weight may be rounded up to 1, so leave room for that */
+	while ((total >> shift) > 0xFFFFUL - HUFFMAN_NUM_SYMBOLS)
+		shift++;
 
-	while(1)
+	/* Insertion sort by weight, the order of symbols of the same weight is kept */
+	for (int i = 0; i < n; i++)
 	{
-		code1 |= (buf[ebuf_id] & 0x80) >> 7;
+		uint16_t weight = counts[i] >> shift;
+		int j = count;
 
-		while(huffman_codes[i].character != '~')
+		if (counts[i] == 0)
+			continue;
+		if (weight == 0)
+			weight = 1;
+
+		while (j > 0 && weights[j - 1] > weight)
 		{
-			if(code_length == huffman_codes[i].code_bits)//&& not zero
-			{
-				if(code1 == huffman_codes[i].code)
-				{
+			symbols[j] = symbols[j - 1];
+			weights[j] = weights[j - 1];
+			j--;
+		}
+		symbols[j] = i;
+		weights[j] = weight;
+		count++;
+	}
 
-					decoded_buffer[dbuf_id++] = huffman_codes[i].character;
-					code1 = 0;
-					code_length = 0;
-					//char_found = true;
-					break;
-				}
+	if (count == 0)
+		return;
+
+	minimum_redundancy_lengths(weights, count);
+	limit_lengths(weights, count, max_bits);
+
+	for (int i = 0; i < count; i++)
+		lengths[symbols[i]] = weights[i];
+}
+
+/*********************************************************************************
+ * @brief   :  	Writes bits of the packed code lengths
+ *
+ * @param   :   writer	- bit writer
+ * 				value	- bits to write, aligned to the lsb
+ * 				bits	- number of bits, at most 16
+ *
+ * @return  : 	void
+**********************************************************************************/
+static void lengths_put_bits(lengths_writer_t *writer, uint32_t value, uint8_t bits)
+{
+	writer->bit_buffer = (writer->bit_buffer << bits) | value;
+	writer->bit_count += bits;
+
+	while (writer->bit_count >= 8)
+	{
+		writer->bit_count -= 8;
+		if (writer->idx < writer->nbytes)
+			writer->buffer[writer->idx++] = writer->bit_buffer >> writer->bit_count;
+		else
+			writer->overflow = true;
+	}
+}
+
+/*********************************************************************************
+ * @brief   :  	Packs code lengths, Deflate style
+ *
+ * 				Runs of the same length are cut into LENGTHS_REPEAT and zero
+ * 				run symbols. The symbols are coded with a huffman code of
+ * 				their own, whose code lengths go first: 4 bits for how many of
+ * 				them are sent in lengths_order, then 3 bits for each of them.
+ *
+ * @param   :   code_lengths	- code length of every symbol, at most 15
+ * 				buffer			- buffer to fill with the packed lengths
+ * 				nbytes			- size of the buffer
+ *
+ * @return  : 	size_t			- number of bytes written to buffer, 0 if they
+ * 								  do not fit
+**********************************************************************************/
+static size_t pack_lengths(const uint8_t code_lengths[], uint8_t *buffer, size_t nbytes)
+{
+	lengths_writer_t writer = { buffer, nbytes, 0, 0, 0, false };
+	uint8_t symbols[HUFFMAN_NUM_SYMBOLS], counts[HUFFMAN_NUM_SYMBOLS];
+	uint32_t symbol_count[LENGTHS_SYMBOLS] = {0};
+	uint8_t lengths[LENGTHS_SYMBOLS];
+	uint16_t codes[LENGTHS_SYMBOLS];
+	uint16_t length_count[LENGTHS_MAX_CODE_BITS + 1] = {0};
+	uint16_t next_code[LENGTHS_MAX_CODE_BITS + 1];
+	uint16_t code = 0;
+	int count = 0, sent;
+
+	for (int i = 0; i < HUFFMAN_NUM_SYMBOLS; )
+	{
+		uint8_t length = code_lengths[i];
+		int run = 1;
+
+		while (i + run < HUFFMAN_NUM_SYMBOLS && code_lengths[i + run] == length)
+			run++;
+		i += run;
+
+		if (length == 0)
+		{
+			while (run >= 11)
+			{
+				int n = (run < 138) ? run : 138;
+				symbols[count] = LENGTHS_LONG_ZEROS;
+				counts[count++] = n - 11;
+				run -= n;
+			}
+			if (run >= 3)
+			{
+				symbols[count] = LENGTHS_ZEROS;
+				counts[count++] = run - 3;
+				run = 0;
 			}
-			i++;
 		}
-		// if(char_found == false)
-		// {
-		//   decoded_buffer[dbuf_id++] = huffman_codes[i].character;
-		// }
-		// else
-		// {
-		//   char_found = false;
-		// }
-		i=1;
-		code_length++;
-		code1 <<= 1;
-		buf[ebuf_id] <<= 1;
-		bit_pos++;
-		if(bit_pos == 8)
-		{
-			bit_pos = 0;
-			ebuf_id++;
-		}
-		if(dbuf_id == encoded_bits)
-			break;
-	
+		else
+		{
+			symbols[count] = length;
+			counts[count++] = 0;
+			run--;
+			while (run >= 3)
+			{
+				int n = (run < 6) ? run : 6;
+				symbols[count] = LENGTHS_REPEAT;
+				counts[count++] = n - 3;
+				run -= n;
+			}
+		}
+
+		while (run-- > 0)
+		{
+			symbols[count] = length;
+			counts[count++] = 0;
+		}
 	}
 
-	decoded_buffer[dbuf_id]= '\0';
-	printf("%s\n", decoded_buffer);
+	/* Canonical codes of the symbols, as build_codes makes them */
+	for (int i = 0; i < count; i++)
+		symbol_count[symbols[i]]++;
+	lengths_from_counts(symbol_count, LENGTHS_SYMBOLS, LENGTHS_MAX_CODE_BITS, lengths);
+
+	for (int i = 0; i < LENGTHS_SYMBOLS; i++)
+		length_count[lengths[i]]++;
+	length_count[0] = 0;
+	for (int bits = 1; bits <= LENGTHS_MAX_CODE_BITS; bits++)
+	{
+		code = (code + length_count[bits - 1]) << 1;
+		next_code[bits] = code;
+	}
+	for (int i = 0; i < LENGTHS_SYMBOLS; i++)
+	{
+		if (lengths[i] > 0)
+			codes[i] = next_code[lengths[i]]++;
+	}
+
+	/* At least 4 lengths are sent, so the number fits in 4 bits */
+	for (sent = LENGTHS_SYMBOLS; sent > 4 && lengths[lengths_order[sent - 1]] == 0; sent--)
+		;
+	lengths_put_bits(&writer, sent - 4, 4);
+	for (int i = 0; i < sent; i++)
+		lengths_put_bits(&writer, lengths[lengths_order[i]], 3);
+
+	for (int i = 0; i < count; i++)
+	{
+		lengths_put_bits(&writer, codes[symbols[i]], lengths[symbols[i]]);
+
+		if (symbols[i] == LENGTHS_REPEAT)
+			lengths_put_bits(&writer, counts[i], LENGTHS_REPEAT_BITS);
+		else if (symbols[i] == LENGTHS_ZEROS)
+			lengths_put_bits(&writer, counts[i], LENGTHS_ZEROS_BITS);
+		else if (symbols[i] == LENGTHS_LONG_ZEROS)
+			lengths_put_bits(&writer, counts[i], LENGTHS_LONG_ZEROS_BITS);
+	}
+
+	if (writer.bit_count > 0)
+		lengths_put_bits(&writer, 0, 8 - writer.bit_count);
+
+	return writer.overflow ? 0 : writer.idx;
 }
 
 /*********************************************************************************
- * @brief   :  	Encodes the message using the huffman lookup table for
- * 				data compression
- * 	
- * 				Credits to Prof. Howdy Pierce for this function
+ * @brief   :  	Unpacks code lengths packed by pack_lengths
  *
- * @param   :   message	- message to be encoded
- * 				buffer	- buffer to fill with encoded message
- * 				nbytes	- size of the buffer
+ * 				The code of the lengths is decoded a bit at a time, from the
+ * 				first code of every length, as it has only 19 symbols
  *
- * @return  : 	void
+ * @param   :   data			- packed code lengths
+ * 				length			- number of bytes in data
+ * 				code_lengths	- set to the code length of every symbol
+ *
+ * @return  : 	bool			- false if the packed lengths are corrupt
 **********************************************************************************/
-int huffman_encode(const char *message, uint8_t *buffer, size_t nbytes)
+static bool unpack_lengths(const uint8_t *data, size_t length, uint8_t code_lengths[])
 {
-    /* Current write position into encoded data */
-	int buf_idx = 0;
+	bit_reader_t reader;
+	uint8_t lengths[LENGTHS_SYMBOLS] = {0};
+	uint8_t sorted[LENGTHS_SYMBOLS];
+	uint16_t length_count[LENGTHS_MAX_CODE_BITS + 1] = {0};
+	uint16_t offset[LENGTHS_MAX_CODE_BITS + 1];
+	size_t sent;
+	int i = 0;
 
-    /*  Number of bits already written at buf_idx */
-	int bits_written=0;
+	bit_reader_init(&reader, data, length);
+	if (bit_reader_bits_left(&reader) < 4)
+		return false;
 
-    /*  Huffman code for the current symbol */
-	int hc_idx;
+	sent = bit_reader_read(&reader, 4) + 4;
+	if (bit_reader_bits_left(&reader) < 3 * sent)
+		return false;
+	for (size_t j = 0; j < sent; j++)
+		lengths[lengths_order[j]] = bit_reader_read(&reader, 3);
 
-	memset(buffer, 0, nbytes);
+	/* Symbols in the order of their canonical codes */
+	for (int j = 0; j < LENGTHS_SYMBOLS; j++)
+		length_count[lengths[j]]++;
+	offset[1] = 0;
+	for (int bits = 1; bits < LENGTHS_MAX_CODE_BITS; bits++)
+		offset[bits + 1] = offset[bits] + length_count[bits];
+	for (int j = 0; j < LENGTHS_SYMBOLS; j++)
+	{
+		if (lengths[j] > 0)
+			sorted[offset[lengths[j]]++] = j;
+	}
 
-	for (const char *p = message; *p != '\0'; p++)
+	while (i < HUFFMAN_NUM_SYMBOLS)
 	{
-		/* Find the huffman code for this symbol */
-		for (hc_idx= 0; huffman_codes[hc_idx].character != *p; hc_idx++);
-			//assert (huff_code[hc_idx].symbol - HUFF_CODE_END_SYMBOL);
+		int code = 0, first = 0, index = 0, symbol = -1;
+		int run = 1;
+		uint8_t value;
 
-        //		if(huffman_codes[hc_idx].code_bits == 0)
-        //		{
-        //			hc_idx == 126;
-        //		}
+		for (int bits = 1; bits <= LENGTHS_MAX_CODE_BITS && symbol < 0; bits++)
+		{
+			if (bit_reader_bits_left(&reader) == 0)
+				return false;
+			code |= bit_reader_read(&reader, 1);
+
+			if (code - first < length_count[bits])
+				symbol = sorted[index + code - first];
+
+			index += length_count[bits];
+			first = (first + length_count[bits]) << 1;
+			code <<= 1;
+		}
 
-        /* Get the code and number of code bits */
-		uint32_t code = huffman_codes[hc_idx].code;
-		int code_bits = huffman_codes[hc_idx].code_bits;
+		if (symbol < 0)
+			return false;
 
-		while (code_bits > 0)
+		if (symbol < LENGTHS_REPEAT)
 		{
+			value = symbol;
+		}
+		else
+		{
+			uint8_t bits = (symbol == LENGTHS_REPEAT) ? LENGTHS_REPEAT_BITS :
+							(symbol == LENGTHS_ZEROS) ? LENGTHS_ZEROS_BITS : LENGTHS_LONG_ZEROS_BITS;
+
+			if (bit_reader_bits_left(&reader) < bits || (symbol == LENGTHS_REPEAT && i == 0))
+				return false;
+
+			run = bit_reader_read(&reader, bits) + ((symbol == LENGTHS_LONG_ZEROS) ? 11 : 3);
+			value = (symbol == LENGTHS_REPEAT) ? code_lengths[i - 1] : 0;
+		}
+
+		if (i + run > HUFFMAN_NUM_SYMBOLS)
+			return false;
+		while (run-- > 0)
+			code_lengths[i++] = value;
+	}
+
+	return true;
+}
+
+/*********************************************************************************
+ * @brief   :  	Returns the bits the counted bytes take with a code length
+ *
+ * @param   :   code_bits	- code length, 0 if the byte is escaped
+ * 				escape_bits	- length of the escape code
+ * 				weight		- weight of the byte
+ *
+ * @return  : 	uint32_t	- number of bits
+**********************************************************************************/
+static inline uint32_t weighted_bits(uint8_t code_bits, uint8_t escape_bits, uint32_t weight)
+{
+	return weight * (code_bits ? code_bits : escape_bits + 8);
+}
+
+/*********************************************************************************
+ * @brief   :  	Does the next step of rebuilding the runtime table
+ *
+ * 				The steps take the counted symbols, sort them by weight a few
+ * 				at a time, work out and limit the code lengths, compare the
+ * 				new code with the ones in use and finally replace the lengths.
+ * 				No step takes more than a few thousand cycles.
+ *
+ * @param   :   table_count	- number of tables in use, the static tables and
+ * 							  the runtime table after them. The new table
+ * 							  is compared with the best of them
+ *
+ * @return  : 	bool		- true when the runtime table was replaced, it
+ * 							  has a new ID and must be announced before
+ * 							  it is used
+**********************************************************************************/
+bool huffman_rebuild_step(uint8_t table_count)
+{
+	switch (rebuild.state)
+	{
+	case REBUILD_IDLE:
+	{
+		uint32_t total = 0;
 
-			/* this write: the number of bits to grab in this go-round */
-			int this_write = min(8 - bits_written, code_bits);
+		if (counted_bytes < HUFFMAN_REBUILD_BYTES)
+			return false;
 
-			assert (bits_written + this_write <= 8);
+		for (int i = 0; i < HUFFMAN_NUM_SYMBOLS; i++)
+			total += symbol_counts[i];
 
-			/* read shift: position within code to get the bits from */
-            int read_shift = code_bits - this_write;
+		/* Each weight may be rounded up to 1, so leave room for that */
+		rebuild.shift = 0;
+		while ((total >> rebuild.shift) > 0xFFFFUL - HUFFMAN_NUM_SYMBOLS)
+			rebuild.shift++;
 
-			/* tmp: bits to write, shifted down to lsb */
-			uint32_t tmp = (code >> read_shift) & ((1UL<<this_write)-1);
-			
-			/* write_shift: shift to fit into this buffer */
-			int write_shift = 8 - bits_written - this_write;
+		rebuild.count = 0;
+		for (int i = 0; i < HUFFMAN_NUM_SYMBOLS; i++)
+		{
+			uint16_t weight = symbol_counts[i] >> rebuild.shift;
 
-            /* buffer[buf_idx]: buffer we're writing into */
-			buffer[buf_idx] |= tmp << write_shift;
+			/* The escape always gets a code */
+			if (weight == 0 && (symbol_counts[i] > 0 || i == HUFFMAN_ESCAPE_SYMBOL))
+				weight = 1;
 
-			bits_written += this_write;
-			code_bits -= this_write;
-			if (bits_written == 8)
+			if (weight > 0)
 			{
-				bits_written = 0;
-				buf_idx++;
-				assert(buf_idx < nbytes);
+				rebuild.symbols[rebuild.count] = i;
+				rebuild.weights[rebuild.count] = weight;
+				rebuild.count++;
+			}
+		}
+
+		rebuild.sorted = 1;
+		rebuild.state = REBUILD_SORT;
+		break;
+	}
+
+	case REBUILD_SORT:
+	{
+		/* Insertion sort, the order of symbols of the same weight is kept */
+		for (int n = 0; n < REBUILD_SORT_STEP && rebuild.sorted < rebuild.count; n++)
+		{
+			uint16_t symbol = rebuild.symbols[rebuild.sorted];
+			uint16_t weight = rebuild.weights[rebuild.sorted];
+			int i = rebuild.sorted;
+
+			while (i > 0 && rebuild.weights[i - 1] > weight)
+			{
+				rebuild.symbols[i] = rebuild.symbols[i - 1];
+				rebuild.weights[i] = rebuild.weights[i - 1];
+				i--;
 			}
+			rebuild.symbols[i] = symbol;
+			rebuild.weights[i] = weight;
+			rebuild.sorted++;
+		}
+
+		if (rebuild.sorted >= rebuild.count)
+			rebuild.state = REBUILD_LENGTHS;
+		break;
+	}
+
+	case REBUILD_LENGTHS:
+		minimum_redundancy_lengths(rebuild.weights, rebuild.count);
+		limit_lengths(rebuild.weights, rebuild.count, HUFFMAN_MAX_CODE_LENGTH);
+		rebuild.state = REBUILD_COMPARE;
+		break;
+
+	case REBUILD_COMPARE:
+	{
+		uint8_t code_lengths[HUFFMAN_NUM_SYMBOLS] = {0};
+		uint8_t packed[HUFFMAN_TABLE_BYTES];
+		uint8_t escape_bits = 0;
+		uint32_t old_bits = UINT32_MAX, new_bits = 0;
+
+		for (int i = 0; i < rebuild.count; i++)
+		{
+			if (rebuild.symbols[i] == HUFFMAN_ESCAPE_SYMBOL)
+				escape_bits = rebuild.weights[i];
+		}
+
+		/* Compare the codes on the counts as they are now */
+		for (int i = 0; i < rebuild.count; i++)
+		{
+			uint32_t weight = symbol_counts[rebuild.symbols[i]] >> rebuild.shift;
+
+			new_bits += weighted_bits(rebuild.weights[i], escape_bits, weight);
+		}
+
+		for (uint8_t index = 0; index < table_count; index++)
+		{
+			const uint8_t *lengths = table_lengths(table_in_use(index));
+			uint32_t table_bits = 0;
+
+			for (int i = 0; i < rebuild.count; i++)
+			{
+				uint16_t symbol = rebuild.symbols[i];
+				uint32_t weight = symbol_counts[symbol] >> rebuild.shift;
+
+				table_bits += weighted_bits(lengths[symbol], lengths[HUFFMAN_ESCAPE_SYMBOL], weight);
+			}
+
+			if (table_bits < old_bits)
+				old_bits = table_bits;
+		}
+
+		for (int i = 0; i < rebuild.count; i++)
+			code_lengths[rebuild.symbols[i]] = rebuild.weights[i];
+
+		/* Not worth the bytes of the announcement */
+		if (new_bits + 8 * pack_lengths(code_lengths, packed, sizeof(packed)) >= old_bits)
+		{
+			for (int i = 0; i < HUFFMAN_NUM_SYMBOLS; i++)
+				symbol_counts[i] /= 2;
+			counted_bytes = 0;
+			rebuild.state = REBUILD_IDLE;
+			break;
+		}
+
+		rebuild.state = REBUILD_BUILD;
+		break;
+	}
+
+	case REBUILD_BUILD:
+	{
+		uint8_t code_lengths[HUFFMAN_NUM_SYMBOLS] = {0};
+
+		for (int i = 0; i < rebuild.count; i++)
+			code_lengths[rebuild.symbols[i]] = rebuild.weights[i];
+
+		set_lengths(next_runtime_id(), code_lengths);
+
+		for (int i = 0; i < HUFFMAN_NUM_SYMBOLS; i++)
+			symbol_counts[i] /= 2;
+		counted_bytes = 0;
+		rebuild.state = REBUILD_IDLE;
+		return true;
+	}
+	}
+
+	return false;
+}
+
+/*********************************************************************************
+ * @brief   :  	Builds the runtime table from the counts of a block of messages
+ *
+ * 				Unlike the rebuild, the counts are of the block alone and the
+ * 				table is built in one go, as the block is waiting
+ *
+ * @param   :   data		- block of messages
+ * 				length		- number of bytes in data
+ * 				table_count	- number of tables in use, the static tables
+ * 							  and the runtime table after them
+ * 				buffer		- buffer to fill with the packed code lengths
+ * 				nbytes		- size of the buffer, at least HUFFMAN_TABLE_BYTES
+ *
+ * @return  : 	size_t		- number of bytes written to buffer, 0 if the
+ * 							  block is sent with the tables in use. The
+ * 							  runtime table is then left as it was
+**********************************************************************************/
+size_t huffman_build_block_table(const uint8_t *data, size_t length, uint8_t table_count,
+									uint8_t *buffer, size_t nbytes)
+{
+	uint32_t counts[HUFFMAN_NUM_SYMBOLS] = {0};
+	uint8_t code_lengths[HUFFMAN_NUM_SYMBOLS];
+	uint32_t old_bits, new_bits = 0;
+	size_t packed_bytes;
+
+	assert(nbytes >= HUFFMAN_TABLE_BYTES);
+
+	for (size_t i = 0; i < length; i++)
+		counts[data[i]]++;
+
+	/* The escape always gets a code, though the block never needs it */
+	counts[HUFFMAN_ESCAPE_SYMBOL] = 1;
+
+	lengths_from_counts(counts, HUFFMAN_NUM_SYMBOLS, HUFFMAN_MAX_CODE_LENGTH, code_lengths);
+
+	for (int i = 0; i < 256; i++)
+		new_bits += counts[i] * code_lengths[i];
+
+	packed_bytes = pack_lengths(code_lengths, buffer, nbytes);
+	huffman_select_table(data, length, table_count, &old_bits);
+
+	/* The lengths are sent in a frame of their own, sync bytes, header and CRC included */
+	if (new_bits + 8 * HUFFMAN_FRAME_BYTES(packed_bytes, 8 * packed_bytes) >= old_bits)
+		return 0;
+
+	set_lengths(next_runtime_id(), code_lengths);
+	return packed_bytes;
+}
+
+/*********************************************************************************
+ * @brief   :  	Packs the code lengths of a table to announce it
+ *
+ * 				The lengths are packed with pack_lengths
+ *
+ * @param   :   table	- ID of the table
+ * 				buffer	- buffer to fill with the lengths
+ * 				nbytes	- size of the buffer, at least HUFFMAN_TABLE_BYTES
+ *
+ * @return  : 	size_t	- number of bytes written to buffer
+**********************************************************************************/
+size_t huffman_export_table(uint8_t table, uint8_t *buffer, size_t nbytes)
+{
+	assert(nbytes >= HUFFMAN_TABLE_BYTES);
+
+	return pack_lengths(table_lengths(table), buffer, nbytes);
+}
+
+/*********************************************************************************
+ * @brief   :  	Builds a table from code lengths packed by huffman_export_table
+ *
+ * 				The table replaces the runtime table and the ID it had
+ *
+ * @param   :   table	- ID of the table, from HUFFMAN_RUNTIME_TABLE as the
+ * 						  static tables cannot be replaced
+ * 				data	- packed code lengths
+ * 				length	- number of bytes in data
+ *
+ * @return  : 	bool	- false if the lengths do not make a valid table,
+ * 						  the table is left as it was
+**********************************************************************************/
+bool huffman_import_table(uint8_t table, const uint8_t *data, size_t length)
+{
+	uint8_t code_lengths[HUFFMAN_NUM_SYMBOLS];
+	uint32_t space = 0;
+
+	if (table < HUFFMAN_STATIC_TABLES || table >= HUFFMAN_MAX_TABLES || !unpack_lengths(data, length, code_lengths))
+		return false;
+
+	for (int i = 0; i < HUFFMAN_NUM_SYMBOLS; i++)
+	{
+		if (code_lengths[i] > HUFFMAN_MAX_CODE_LENGTH)
+			return false;
+		if (code_lengths[i] > 0)
+			space += 1UL << (HUFFMAN_MAX_CODE_LENGTH - code_lengths[i]);
+	}
+
+	/* The codes must fit in the code space and the escape must have one */
+	if (space > (1UL << HUFFMAN_MAX_CODE_LENGTH) || code_lengths[HUFFMAN_ESCAPE_SYMBOL] == 0)
+		return false;
+
+	set_lengths(table, code_lengths);
+	return true;
+}
+
+/*********************************************************************************
+ * @brief   :  	Writes a varint, 7 bits of the value at a time from the lsb
+ *
+ * @param   :   value	- value to write
+ * 				buffer	- buffer of at least HUFFMAN_VARINT_BYTES(value) bytes
+ *
+ * @return  : 	size_t	- number of bytes written
+**********************************************************************************/
+static size_t write_varint(uint32_t value, uint8_t *buffer)
+{
+	size_t idx = 0;
+
+	while (value >= 0x80)
+	{
+		buffer[idx++] = (value & 0x7F) | 0x80;
+		value >>= 7;
+	}
+	buffer[idx++] = value;
+	return idx;
+}
+
+/*********************************************************************************
+ * @brief   :  	Reads a varint written by write_varint
+ *
+ * @param   :   data	- bytes of the varint
+ * 				length	- number of bytes in data
+ * 				value	- filled with the value
+ *
+ * @return  : 	int		- number of bytes read, 0 if more bytes are needed,
+ * 						  -1 if the varint does not fit in 32 bits
+**********************************************************************************/
+static int read_varint(const uint8_t *data, size_t length, uint32_t *value)
+{
+	uint32_t result = 0;
+
+	for (size_t i = 0; i < HUFFMAN_VARINT_BYTES(UINT32_MAX); i++)
+	{
+		if (i == length)
+			return 0;
+
+		/* The 5th byte only has 4 bits left of the 32 */
+		if (i == HUFFMAN_VARINT_BYTES(UINT32_MAX) - 1 && data[i] > 0x0F)
+			return -1;
+
+		result |= (uint32_t)(data[i] & 0x7F) << (7 * i);
+		if (!(data[i] & 0x80))
+		{
+			*value = result;
+			return i + 1;
 		}
 	}
 
-//	if(bits_written != 8)
-//	{
-//		buf_idx++;
-//	}
+	return -1;
+}
+
+/*********************************************************************************
+ * @brief   :  	Writes the sync bytes, type and sizes a frame starts with
+ *
+ * @param   :   type		- type byte of the frame
+ * 				sequence	- sequence number of the frame
+ * 				size		- original size of the message
+ * 				bits		- number of encoded bits, the message is ceil(bits / 8) bytes
+ * 				buffer		- buffer of at least HUFFMAN_FRAME_HEADER_MAX bytes
+ *
+ * @return  : 	size_t	- number of bytes written
+**********************************************************************************/
+size_t huffman_frame_header(uint8_t type, uint8_t sequence, uint32_t size, uint32_t bits, uint8_t *buffer)
+{
+	size_t idx = 0;
+
+	buffer[idx++] = HUFFMAN_FRAME_SYNC_0;
+	buffer[idx++] = HUFFMAN_FRAME_SYNC_1;
+	buffer[idx++] = type;
+	buffer[idx++] = sequence;
+	idx += write_varint(size, buffer + idx);
+	idx += write_varint(bits, buffer + idx);
+
+	return idx;
+}
+
+/*********************************************************************************
+ * @brief   :  	Reads the header of a frame
+ *
+ * @param   :   data		- received bytes, starting with the sync bytes
+ * 				length		- number of bytes in data
+ * 				type		- filled with the type byte
+ * 				sequence	- filled with the sequence number
+ * 				size		- filled with the original size
+ * 				bits		- filled with the number of encoded bits
+ *
+ * @return  : 	int		- number of bytes of the header, 0 if more bytes are
+ * 						  needed, -1 if data does not start with a header
+**********************************************************************************/
+int huffman_frame_parse(const uint8_t *data, size_t length, uint8_t *type, uint8_t *sequence,
+						uint32_t *size, uint32_t *bits)
+{
+	int idx = 4, count;
+
+	if ((length > 0 && data[0] != HUFFMAN_FRAME_SYNC_0) || (length > 1 && data[1] != HUFFMAN_FRAME_SYNC_1))
+		return -1;
+	if (length < 4)
+		return 0;
+	*type = data[2];
+	*sequence = data[3];
+
+	count = read_varint(data + idx, length - idx, size);
+	if (count <= 0)
+		return count;
+	idx += count;
+
+	count = read_varint(data + idx, length - idx, bits);
+	if (count <= 0)
+		return count;
+
+	return idx + count;
+}
+
+/*********************************************************************************
+ * @brief   :  	Adds bytes to the CRC-16/CCITT-FALSE of a frame
+ *
+ * 				The CRC is worked out a bit at a time, a table would take
+ * 				512 bytes of flash and the link is far slower either way
+ *
+ * @param   :   crc		- CRC of the bytes so far, HUFFMAN_FRAME_CRC_INIT at first
+ * 				data	- bytes to add
+ * 				length	- number of bytes in data
+ *
+ * @return  : 	uint16_t	- CRC with the bytes added
+**********************************************************************************/
+uint16_t huffman_frame_crc(uint16_t crc, const uint8_t *data, size_t length)
+{
+	for (size_t i = 0; i < length; i++)
+	{
+		crc ^= (uint16_t)data[i] << 8;
+		for (int bit = 0; bit < 8; bit++)
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+	}
 
-	//change
-	//printf("bits written = %d\n", 8*buf_idx + bits_written);
-	//return buf_idx;
-	return 8*buf_idx + bits_written;
-}
\ No newline at end of file
+	return crc;
+}
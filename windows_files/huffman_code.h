@@ -15,27 +15,832 @@
  * 				
 */
 
+#ifndef HUFFMAN_CODE_H_
+#define HUFFMAN_CODE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "bit_reader.h"
+
+/*
+ * Number of bits resolved by a single lookup in the primary decode table
+ * The primary table takes 2^HUFFMAN_LOOKUP_BITS entries of 2 bytes each in RAM
+ * Every code is decoded with one lookup when this is at least the maximum
+ * code length the table was generated with
+ */
+#ifndef HUFFMAN_LOOKUP_BITS
+#define HUFFMAN_LOOKUP_BITS			(9)
+#endif
+
+/* Longest code supported by the decoder */
+#define HUFFMAN_MAX_CODE_BITS		(16)
+
+/*
+ * Coder of the messages sent with a static table, 0 for huffman and 1 for the
+ * tANS coder of ans.h. tANS codes closer to the entropy of the tables, its
+ * tables take about 18 KB of flash and are only linked in when it is selected
+ */
+#ifndef HUFFMAN_ANS
+#define HUFFMAN_ANS					(0)
+#endif
+
+/*
+ * Code tables selected by their ID. The first HUFFMAN_STATIC_TABLES are built
+ * from lookup_table.h, one for every training file followed by the tables of
+ * the order-1 coder, and must match its HUFFMAN_NUM_TABLES.
+ * The runtime table is rebuilt from the counts of the encoded bytes, or
+ * built from the counts of one block of messages and announced in front of
+ * it. The last of them replaces the one before and takes the other of the
+ * IDs HUFFMAN_RUNTIME_TABLE and HUFFMAN_RUNTIME_TABLE + 1, so a receiver
+ * which lost the announcement knows it has not got the table a message
+ * uses. Only the code lengths of a table are kept, a decoder builds the
+ * table it uses into a single table of about 1 KB
+ */
+#define HUFFMAN_STATIC_TABLES		(4)
+#define HUFFMAN_RUNTIME_TABLE		(HUFFMAN_STATIC_TABLES)
+#define HUFFMAN_MAX_TABLES			(HUFFMAN_STATIC_TABLES + 2)
+
+/*
+ * Most bytes of RAM the tables may take, checked when huffman.c is built.
+ * The KL25Z has 16 KB of SRAM for everything, this leaves room for one built
+ * table with its primary decode table and about 2 KB of codes and lengths.
+ * Fewer lookup bits than the longest code add the tables of the longer codes
+ */
+#ifndef HUFFMAN_TABLES_RAM
+#define HUFFMAN_TABLES_RAM			(2048 + 2 * (1UL << HUFFMAN_LOOKUP_BITS))
+#endif
+
+/*
+ * Tokens of lookup_table.h, strings of at most HUFFMAN_MAX_TOKEN_LENGTH
+ * characters the static tables code as one symbol after the escape. The
+ * encoder holds back that many characters to find the longest token
+ */
+#define HUFFMAN_MAX_TOKENS			(16)
+#define HUFFMAN_MAX_TOKEN_LENGTH	(8)
+
+/*
+ * Most bytes of code lengths sent to announce a table. The lengths are run
+ * length coded with a code of their own, which takes at most 7 bits for every
+ * length of the 257 + HUFFMAN_MAX_TOKENS symbols after the 61 bits of its own
+ * code lengths
+ */
+#define HUFFMAN_TABLE_BYTES			(247)
+
+/* Bytes counted before the runtime table is rebuilt */
+#define HUFFMAN_REBUILD_BYTES		(4096)
+
+
+/*
+ * Most characters huffman_decoder_feed decodes from length bytes, as every
+ * code has at least 1 bit and a token has at most HUFFMAN_MAX_TOKEN_LENGTH characters
+ */
+#define HUFFMAN_DECODED_SIZE(length)	(HUFFMAN_MAX_TOKEN_LENGTH * (8 * (length) + BIT_BUFFER_BITS))
+
+/*
+ * Most leaves of the adaptive tree, one for each of the first 127 bytes seen
+ * and one for the bytes not seen yet. Logs use far fewer bytes, a byte seen
+ * once the tree is full is always sent after the code of the NYT leaf
+ */
+#define HUFFMAN_ADAPTIVE_LEAVES		(128)
+
+/* Nodes of the adaptive tree once it is full, numbered in a byte */
+#define HUFFMAN_ADAPTIVE_NODES		(2 * HUFFMAN_ADAPTIVE_LEAVES - 1)
+
+/*
+ * Total weight at which the counts of the adaptive tree are halved, so the
+ * model follows recent traffic. A code of n bits needs a total weight of at
+ * least fibonacci(n + 1), which bounds the codes at HUFFMAN_ADAPTIVE_MAX_CODE_BITS
+ */
+#define HUFFMAN_ADAPTIVE_MAX_WEIGHT		(8192)
+#define HUFFMAN_ADAPTIVE_MAX_CODE_BITS	(20)
+
+/*
+ * Most bytes huffman_encoder_feed writes for length characters, all of them
+ * escaped or new to the adaptive tree
+ */
+#define HUFFMAN_ENCODED_SIZE(length)	(((length) * (HUFFMAN_ADAPTIVE_MAX_CODE_BITS + 8)) / 8 + 1)
+
+/*
+ * Every message is sent as a frame. The frame starts with the two sync bytes,
+ * then the type byte, the sequence number, the original size and the number
+ * of encoded bits as varints, the ceil(bits / 8) bytes of the message and a
+ * CRC-16 of everything after the sync bytes. A receiver which lost its place
+ * looks for the next sync bytes whose frame has a valid CRC. The sequence
+ * number goes up by one with every frame, so the receiver knows when frames
+ * were lost in between
+ */
+#define HUFFMAN_FRAME_SYNC_0		(0xA5)
+#define HUFFMAN_FRAME_SYNC_1		(0x5A)
+
+/* Bytes of a varint, 7 bits of the value in each, the msb set in all but the last */
+#define HUFFMAN_VARINT_BYTES(value)	((value) < (1UL << 7) ? 1 : (value) < (1UL << 14) ? 2 : \
+									 (value) < (1UL << 21) ? 3 : (value) < (1UL << 28) ? 4 : 5)
+
+/* Most bytes in front of a message, the varints hold up to 32 bits */
+#define HUFFMAN_FRAME_HEADER_MAX	(4 + 2 * HUFFMAN_VARINT_BYTES(UINT32_MAX))
+
+/* Bytes of the CRC after a message, sent msb first */
+#define HUFFMAN_FRAME_CRC_BYTES		(2)
+
+/* Initial value of the CRC-16/CCITT-FALSE of a frame */
+#define HUFFMAN_FRAME_CRC_INIT		(0xFFFF)
+
+/* Bytes of a whole frame with the given original size and encoded bits */
+#define HUFFMAN_FRAME_BYTES(size, bits)	(4 + HUFFMAN_VARINT_BYTES(size) + HUFFMAN_VARINT_BYTES(bits) + \
+										 ((bits) + 7) / 8 + HUFFMAN_FRAME_CRC_BYTES)
+
+/*
+ * Type byte of every frame. The low 3 bits are the kind of message,
+ * the next bit HUFFMAN_FRAME_TOKENS and the next 3 bits the ID of the table it uses
+ */
+#define HUFFMAN_FRAME_STATIC		(0x00)
+#define HUFFMAN_FRAME_ADAPTIVE		(0x01)
+
+/* Code lengths of a table built at runtime, packed by huffman_export_table */
+#define HUFFMAN_FRAME_TABLE			(0x02)
+
+/* Every character coded with the table of the character before it */
+#define HUFFMAN_FRAME_CONTEXT		(0x03)
+
+/* Characters coded with the table, or as repeats of earlier text */
+#define HUFFMAN_FRAME_LZ			(0x04)
+
+/* Characters coded with the table when the firmware was built, kept out of the LZ history */
+#define HUFFMAN_FRAME_CONSTANT		(0x05)
+
+/* Characters coded with the tANS coder and the table */
+#define HUFFMAN_FRAME_ANS			(0x06)
+
+/* Characters coded with the range coder and the table */
+#define HUFFMAN_FRAME_RANGE			(0x07)
+
+#define HUFFMAN_FRAME_TYPE(kind, table)	((kind) | ((table) << 4))
+#define HUFFMAN_FRAME_KIND(type)		((type) & 0x07)
+#define HUFFMAN_FRAME_ID(type)			(((type) >> 4) & 0x07)
+
+/*
+ * Table ID of a message sent as its raw bytes, as coding it would not make
+ * it smaller. The kind it would have been coded with is kept, so the receiver
+ * still applies the reset bit and adds the bytes to its adaptive tree or history
+ */
+#define HUFFMAN_STORED_ID				(7)
+#define HUFFMAN_FRAME_STORED(type)		(HUFFMAN_FRAME_ID(type) == HUFFMAN_STORED_ID)
+
+/*
+ * A table is never sent stored, so the stored table type announces repeats
+ * instead. The receiver prints the message it decoded last as many more times
+ * as the original size in the header says, nothing follows the header
+ */
+#define HUFFMAN_FRAME_REPEAT			HUFFMAN_FRAME_TYPE(HUFFMAN_FRAME_TABLE, HUFFMAN_STORED_ID)
+
+/*
+ * Byte the receiver sends back when frames were lost, as the adaptive tree,
+ * the LZ history, the stream and the runtime table it holds may no longer
+ * match the sender's. The sender starts all of them over and sends a resync
+ * frame, a repeat with the reset bit and nothing after the header. The
+ * receiver starts over as well when it gets the resync frame, and drops the
+ * messages which need any of them until then
+ */
+#define HUFFMAN_LINK_NAK				(0x15)
+#define HUFFMAN_FRAME_RESYNC			(HUFFMAN_FRAME_REPEAT | HUFFMAN_FRAME_RESET)
+
+/* Set in the type byte when the message is a format string ID and its packed arguments */
+#define HUFFMAN_FRAME_TOKENS		(0x08)
+
+/*
+ * Set in the type byte when the adaptive tree, or the history of a
+ * HUFFMAN_FRAME_LZ message, starts over with this message
+ */
+#define HUFFMAN_FRAME_RESET			(0x80)
+
+/*
+ * A static message of a stream sets the reset bit, which the static kind
+ * has no use for. Its bits continue the bits of the message before it
+ * without padding, the frame holds the whole bytes and the bits of the last
+ * partial byte go out with the next message of the stream. A frame after
+ * which every character of the stream is decoded ends it, the bits left are
+ * padding, and the next stream may use another table
+ */
+#define HUFFMAN_FRAME_STREAM			(HUFFMAN_FRAME_STATIC | HUFFMAN_FRAME_RESET)
+#define HUFFMAN_FRAME_IS_STREAM(type)	(((type) & 0x8F) == HUFFMAN_FRAME_STREAM)
+
+/*
+ * Bytes of earlier text a repeat can point back into. A repeat is sent as
+ * the escape code, a 1 bit, its length and its distance
+ */
+#define HUFFMAN_LZ_WINDOW_BITS		(9)
+#define HUFFMAN_LZ_WINDOW			(1 << HUFFMAN_LZ_WINDOW_BITS)
+
+/* Bits of the hash of the 3 bytes a repeat starts with */
+#define HUFFMAN_LZ_HASH_BITS		(8)
+
+/* Shortest and longest repeat */
+#define HUFFMAN_LZ_MIN_MATCH		(3)
+#define HUFFMAN_LZ_MAX_MATCH		(HUFFMAN_LZ_MIN_MATCH + 123)
+
+/*
+ * 	huffman_adaptive_t is the tree of the adaptive coder (FGK algorithm)
+ *
+ * 	The encoder and the decoder update their trees in the same way after every
+ * 	byte, so the codes follow the traffic without a table being sent. Nodes are
+ * 	numbered from the root in order of non-increasing weight, with siblings
+ * 	next to each other. The tree takes about 1.5 KB of RAM, whatever the traffic.
+ *
+ * 	weight	- number of times the bytes under the node were coded
+ * 	parent	- node of the parent
+ * 	child	- first of the two children, the second one follows it.
+ * 			  For a leaf, the leaf flag and the byte
+ * 	leaf	- node of every byte, 0 if the byte is not in the tree
+ * 	nyt		- node of the leaf for the bytes not seen yet, always the last node
+*/
+typedef struct
+{
+	uint16_t weight[HUFFMAN_ADAPTIVE_NODES];
+	uint8_t parent[HUFFMAN_ADAPTIVE_NODES];
+	uint16_t child[HUFFMAN_ADAPTIVE_NODES];
+	uint8_t leaf[256];
+	uint8_t nyt;
+} huffman_adaptive_t;
+
+/*
+ * 	huffman_lz_t is the history the repeats of HUFFMAN_FRAME_LZ messages point into
+ *
+ * 	Every message goes into the history of the sender and of the receiver, so
+ * 	both hold the same text. The history takes about 1 KB of RAM.
+ *
+ * 	window		- the last HUFFMAN_LZ_WINDOW bytes
+ * 	head		- position of the last 3 bytes with every hash, used by the encoder
+ * 	position	- number of bytes added, the index of the next one in window
+ * 	filled		- number of bytes in window, at most HUFFMAN_LZ_WINDOW
+*/
+typedef struct
+{
+	uint8_t window[HUFFMAN_LZ_WINDOW];
+	uint16_t head[1 << HUFFMAN_LZ_HASH_BITS];
+	uint16_t position;
+	uint16_t filled;
+} huffman_lz_t;
+
+/*
+ * 	huffman_encoder_t is the state of a message encoded in chunks
+ * 	bit_buffer	- bits not written out yet, aligned to the lsb
+ * 	bit_count	- number of bits in bit_buffer, less than 8 between chunks
+ * 	total_bits	- number of bits encoded so far
+ * 	model		- adaptive tree, NULL to use the static table
+ * 	table		- ID of the static table
+ * 	context		- set to pick the table from the previous character instead
+ * 	previous	- previous character of the message
+ * 	lz			- history to send repeats from, NULL for none
+ * 	pending		- characters held back until the longest token at the first
+ * 				  one is known, static table only
+ * 	pending_count	- number of characters in pending
+*/
+typedef struct
+{
+	uint32_t bit_buffer;
+	uint8_t bit_count;
+	uint32_t total_bits;
+	huffman_adaptive_t *model;
+	uint8_t table;
+	bool context;
+	uint8_t previous;
+	huffman_lz_t *lz;
+	uint8_t pending[HUFFMAN_MAX_TOKEN_LENGTH];
+	uint8_t pending_count;
+} huffman_encoder_t;
+
+/*
+ * 	huffman_decoder_t is the state of a message decoded in chunks
+ * 	reader		- bit reader holding the bits not decoded yet
+ * 	remaining	- number of characters still to be decoded
+ * 	corrupt		- set when the input does not match the table
+ * 	model		- adaptive tree, NULL to use the static table
+ * 	table		- ID of the static table
+ * 	context		- set to pick the table from the previous character instead
+ * 	previous	- previous decoded character
+ * 	lz			- history the repeats point into, NULL for none
+ * 	repeat		- set when the length and distance of a repeat come next
+*/
+typedef struct
+{
+	bit_reader_t reader;
+	uint16_t remaining;
+	bool corrupt;
+	huffman_adaptive_t *model;
+	uint8_t table;
+	bool context;
+	uint8_t previous;
+	huffman_lz_t *lz;
+	bool repeat;
+} huffman_decoder_t;
+
+/*********************************************************************************
+ * @brief   :  	Builds every table from the code lengths in the huffman
+ * 				lookup table
+ *
+ * 				Must be called once before huffman_encode and huffman_decode
+ *
+ * @param   :   none
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_init(void);
+
+/*********************************************************************************
+ * @brief   :  	Counts the bytes of a message for the next rebuild of the
+ * 				runtime table
+ *
+ * @param   :   data	- message
+ * 				length	- number of bytes in data
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_count(const uint8_t *data, size_t length);
+
+/*********************************************************************************
+ * @brief   :  	Does the next step of rebuilding the runtime table
+ *
+ * 				Meant to be called while the application is idle. Every call
+ * 				does a small bounded amount of work. Once HUFFMAN_REBUILD_BYTES
+ * 				were counted, the code lengths are worked out from the counts
+ * 				and limited to HUFFMAN_MAX_CODE_LENGTH bits. The table is only
+ * 				replaced if it saves more than it costs to announce it.
+ *
+ * @param   :   table_count	- number of tables in use, the static tables and
+ * 							  the runtime table after them. The new table
+ * 							  is compared with the best of them
+ *
+ * @return  : 	bool		- true when the runtime table was replaced, it
+ * 							  has a new ID and must be announced before
+ * 							  it is used
+**********************************************************************************/
+bool huffman_rebuild_step(uint8_t table_count);
+
+/*********************************************************************************
+ * @brief   :  	Builds the runtime table from the counts of a block of messages
+ *
+ * 				The code lengths are worked out from the counts of data,
+ * 				limited to HUFFMAN_MAX_CODE_LENGTH bits and packed as
+ * 				huffman_export_table does. The block table replaces
+ * 				the runtime table and gets a new ID. It is only built if
+ * 				the block and the packed lengths together take fewer bits
+ * 				than the block does with the best of the tables in use.
+ *
+ * @param   :   data		- block of messages
+ * 				length		- number of bytes in data
+ * 				table_count	- number of tables in use, the static tables
+ * 							  and the runtime table after them
+ * 				buffer		- buffer to fill with the packed code lengths
+ * 				nbytes		- size of the buffer, at least HUFFMAN_TABLE_BYTES
+ *
+ * @return  : 	size_t		- number of bytes written to buffer, 0 if the
+ * 							  block is sent with the tables in use. The
+ * 							  runtime table is then left as it was
+**********************************************************************************/
+size_t huffman_build_block_table(const uint8_t *data, size_t length, uint8_t table_count,
+									uint8_t *buffer, size_t nbytes);
+
+/*********************************************************************************
+ * @brief   :  	Packs the code lengths of a table to announce it
+ *
+ * @param   :   table	- ID of the table
+ * 				buffer	- buffer to fill with the lengths
+ * 				nbytes	- size of the buffer, at least HUFFMAN_TABLE_BYTES
+ *
+ * @return  : 	size_t	- number of bytes written to buffer
+**********************************************************************************/
+size_t huffman_export_table(uint8_t table, uint8_t *buffer, size_t nbytes);
+
+/*********************************************************************************
+ * @brief   :  	Builds a table from code lengths packed by huffman_export_table
+ *
+ * 				The table replaces the runtime table and the ID it had
+ *
+ * @param   :   table	- ID of the table, from HUFFMAN_RUNTIME_TABLE as the
+ * 						  static tables cannot be replaced
+ * 				data	- packed code lengths
+ * 				length	- number of bytes in data
+ *
+ * @return  : 	bool	- false if the lengths do not make a valid table,
+ * 						  the table is left as it was
+**********************************************************************************/
+bool huffman_import_table(uint8_t table, const uint8_t *data, size_t length);
+
+/*********************************************************************************
+ * @brief   :  	Returns the ID of the runtime table
+ *
+ * @param   :   none
+ *
+ * @return  : 	uint8_t	- ID of the table, HUFFMAN_MAX_TABLES if there is none
+**********************************************************************************/
+uint8_t huffman_runtime_table(void);
+
+/*********************************************************************************
+ * @brief   :  	Tells whether a table ID can be used
+ *
+ * @param   :   table	- ID of the table
+ *
+ * @return  : 	bool	- true for the static tables and the ID the runtime
+ * 						  table has now
+**********************************************************************************/
+bool huffman_has_table(uint8_t table);
+
+/*********************************************************************************
+ * @brief   :  	Decodes characters from a bit reader
+ *
+ * 				The reader can be set up over a receive ring with
+ * 				bit_reader_init_ring to decode without copying the data.
+ * 				The data must be encoded with table 0
+ *
+ * @param   :   reader			- bit reader over the encoded data
+ * 				decoded_bytes	- number of characters to decode
+ * 				decoded_buffer	- buffer to be filled with the decoded characters
+ *
+ * @return  : 	uint16_t		- number of characters decoded, less than
+ * 								  decoded_bytes if the input is corrupt
+**********************************************************************************/
+uint16_t huffman_decode_reader(bit_reader_t *reader, uint16_t decoded_bytes, uint8_t decoded_buffer[]);
+
 /*********************************************************************************
  * @brief   :  	Decodes the encoded buffer and prints the string
  *
+ * 				The encoded buffer is only read, so it can be decoded again.
+ * 				The data must be encoded with table 0
+ *
  * @param   :   encoded_buffer	- encoded buffer
- * 				encoded_bits	- number of original bytes
+ * 				encoded_bytes	- number of bytes in the encoded buffer
+ * 				decoded_bytes	- number of original bytes
  * 				decoded_buffer	- buffer to be filled with the decoded string
  *
  * @return  : 	void
 **********************************************************************************/
-void huffman_decode(uint8_t encoded_buffer[], uint16_t encoded_bits, uint8_t decoded_buffer[]);
+void huffman_decode(const uint8_t encoded_buffer[], uint16_t encoded_bytes,
+						uint16_t decoded_bytes, uint8_t decoded_buffer[]);
+
+/*********************************************************************************
+ * @brief   :  	Starts decoding a message which arrives in chunks
+ *
+ * @param   :   decoder			- decoder state
+ * 				decoded_bytes	- number of characters in the message
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_decoder_init(huffman_decoder_t *decoder, uint16_t decoded_bytes);
+
+/*********************************************************************************
+ * @brief   :  	Starts decoding a message encoded with one of the tables
+ *
+ * @param   :   decoder			- decoder state
+ * 				decoded_bytes	- number of characters in the message
+ * 				table			- ID of a table huffman_has_table accepts
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_decoder_init_table(huffman_decoder_t *decoder, uint16_t decoded_bytes, uint8_t table);
+
+/*********************************************************************************
+ * @brief   :  	Starts decoding the next message of a stream with one of
+ * 				the tables
+ *
+ * 				The bits left over from the last chunk are the first bits
+ * 				of the message
+ *
+ * @param   :   decoder			- decoder state of a static table
+ * 				decoded_bytes	- number of characters in the message
+ * 				table			- ID of a table huffman_has_table accepts
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_decoder_next_message(huffman_decoder_t *decoder, uint16_t decoded_bytes, uint8_t table);
+
+/*********************************************************************************
+ * @brief   :  	Starts decoding a message of the order-1 coder
+ *
+ * @param   :   decoder			- decoder state
+ * 				decoded_bytes	- number of characters in the message
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_decoder_init_context(huffman_decoder_t *decoder, uint16_t decoded_bytes);
+
+/*********************************************************************************
+ * @brief   :  	Starts decoding a message encoded with an adaptive tree
+ *
+ * 				The tree must be in the state the encoder's tree was in
+ * 				when the message was encoded
+ *
+ * @param   :   decoder			- decoder state
+ * 				decoded_bytes	- number of characters in the message
+ * 				model			- adaptive tree, updated as the message is decoded
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_decoder_init_adaptive(huffman_decoder_t *decoder, uint16_t decoded_bytes,
+										huffman_adaptive_t *model);
+
+/*********************************************************************************
+ * @brief   :  	Starts decoding a message of characters and repeats
+ *
+ * 				The history must hold what the encoder's history held when
+ * 				the message was encoded. The decoded characters are added to it.
+ *
+ * @param   :   decoder			- decoder state
+ * 				decoded_bytes	- number of characters in the message
+ * 				table			- ID of the table of the characters
+ * 				lz				- history the repeats point into
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_decoder_init_lz(huffman_decoder_t *decoder, uint16_t decoded_bytes, uint8_t table,
+								huffman_lz_t *lz);
+
+/*********************************************************************************
+ * @brief   :  	Decodes the characters completed by the next chunk of input
+ *
+ * 				Bits at the end of the chunk which do not make a whole code
+ * 				are kept in the decoder for the next call
+ *
+ * @param   :   decoder			- decoder state
+ * 				data			- next chunk of encoded data
+ * 				length			- number of bytes in data
+ * 				decoded_buffer	- buffer to be filled with the decoded characters
+ * 				nbytes			- size of decoded_buffer, at least
+ * 								  HUFFMAN_DECODED_SIZE(length) or the rest of the message.
+ * 								  Only the rest of the message will do for repeats
+ *
+ * @return  : 	size_t			- number of characters decoded
+**********************************************************************************/
+size_t huffman_decoder_feed(huffman_decoder_t *decoder, const uint8_t *data, size_t length,
+								uint8_t decoded_buffer[], size_t nbytes);
+
+/*********************************************************************************
+ * @brief   :  	Starts encoding a message in chunks
+ *
+ * @param   :   encoder	- encoder state
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_encoder_init(huffman_encoder_t *encoder);
+
+/*********************************************************************************
+ * @brief   :  	Starts encoding a message in chunks with one of the tables
+ *
+ * @param   :   encoder	- encoder state
+ * 				table	- ID of a table huffman_has_table accepts
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_encoder_init_table(huffman_encoder_t *encoder, uint8_t table);
+
+/*********************************************************************************
+ * @brief   :  	Starts encoding the next message of a stream with one of
+ * 				the tables
+ *
+ * 				The bits left over from the last message are sent in front
+ * 				of the message
+ *
+ * @param   :   encoder	- encoder state of a static table, with no characters
+ * 						  held back
+ * 				table	- ID of a table huffman_has_table accepts
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_encoder_next_message(huffman_encoder_t *encoder, uint8_t table);
+
+/*********************************************************************************
+ * @brief   :  	Starts encoding a message in chunks with the order-1 coder
+ *
+ * 				Every character is coded with the table huffman_context_map
+ * 				gives for the character before it
+ *
+ * @param   :   encoder	- encoder state
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_encoder_init_context(huffman_encoder_t *encoder);
+
+/*********************************************************************************
+ * @brief   :  	Starts encoding a message in chunks with an adaptive tree
+ *
+ * @param   :   encoder	- encoder state
+ * 				model	- adaptive tree, updated as the message is encoded
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_encoder_init_adaptive(huffman_encoder_t *encoder, huffman_adaptive_t *model);
+
+/*********************************************************************************
+ * @brief   :  	Empties an adaptive tree
+ *
+ * 				The encoder and the decoder must start from an empty tree
+ * 				at the same message
+ *
+ * @param   :   model	- adaptive tree
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_adaptive_reset(huffman_adaptive_t *model);
+
+/*********************************************************************************
+ * @brief   :  	Adds the bytes of a stored message to an adaptive tree
+ *
+ * 				The tree ends up as encoding or decoding the bytes leaves it
+ *
+ * @param   :   model	- adaptive tree
+ * 				data	- bytes of the message
+ * 				length	- number of bytes in data
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_adaptive_add(huffman_adaptive_t *model, const uint8_t *data, size_t length);
+
+/*********************************************************************************
+ * @brief   :  	Starts encoding a message in chunks, sending repeats of
+ * 				earlier text as a length and a distance
+ *
+ * 				Repeats do not reach past the end of a chunk, so the whole
+ * 				message should be fed at once. The characters are added to
+ * 				the history as they are encoded.
+ *
+ * @param   :   encoder	- encoder state
+ * 				table	- ID of the table of the characters
+ * 				lz		- history to send repeats from
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_encoder_init_lz(huffman_encoder_t *encoder, uint8_t table, huffman_lz_t *lz);
+
+/*********************************************************************************
+ * @brief   :  	Empties a history
+ *
+ * 				The encoder and the decoder must start from an empty history
+ * 				at the same message
+ *
+ * @param   :   lz	- history
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_lz_reset(huffman_lz_t *lz);
+
+/*********************************************************************************
+ * @brief   :  	Adds a message sent without repeats to a history
+ *
+ * @param   :   lz		- history
+ * 				data	- message
+ * 				length	- number of bytes in data
+ *
+ * @return  : 	void
+**********************************************************************************/
+void huffman_lz_append(huffman_lz_t *lz, const uint8_t *data, size_t length);
+
+/*********************************************************************************
+ * @brief   :  	Encodes the next chunk of a message
+ *
+ * 				Less than 8 bits are left in the encoder for the next chunk.
+ * 				With the static table up to HUFFMAN_MAX_TOKEN_LENGTH - 1
+ * 				characters are held back too, so a token may span chunks
+ *
+ * @param   :   encoder	- encoder state
+ * 				data	- next chunk of the message
+ * 				length	- number of bytes in data
+ * 				buffer	- buffer to fill with the encoded bytes
+ * 				nbytes	- size of the buffer, at least HUFFMAN_ENCODED_SIZE(length)
+ *
+ * @return  : 	size_t	- number of bytes written to buffer
+**********************************************************************************/
+size_t huffman_encoder_feed(huffman_encoder_t *encoder, const uint8_t *data, size_t length,
+								uint8_t *buffer, size_t nbytes);
+
+/*********************************************************************************
+ * @brief   :  	Writes out the characters and bits left in the encoder
+ *
+ * @param   :   encoder	- encoder state
+ * 				buffer	- buffer to fill with the last bytes
+ * 				nbytes	- size of the buffer, at least
+ * 						  HUFFMAN_ENCODED_SIZE(HUFFMAN_MAX_TOKEN_LENGTH)
+ *
+ * @return  : 	size_t	- number of bytes written to buffer
+**********************************************************************************/
+size_t huffman_encoder_flush(huffman_encoder_t *encoder, uint8_t *buffer, size_t nbytes);
+
+/*********************************************************************************
+ * @brief   :  	Ends a message of a stream coded with a static table
+ *
+ * 				The characters held back are encoded and the whole bytes
+ * 				written out. Less than 8 bits stay in the encoder, the next
+ * 				message of the stream continues them with the same table
+ *
+ * @param   :   encoder	- encoder state of a static table
+ * 				buffer	- buffer to fill with the last bytes
+ * 				nbytes	- size of the buffer, at least
+ * 						  HUFFMAN_ENCODED_SIZE(HUFFMAN_MAX_TOKEN_LENGTH)
+ *
+ * @return  : 	size_t	- number of bytes written to buffer
+**********************************************************************************/
+size_t huffman_encoder_end_message(huffman_encoder_t *encoder, uint8_t *buffer, size_t nbytes);
+
+/*********************************************************************************
+ * @brief   :  	Ends a stream by padding the bits left in the encoder
+ *
+ * 				The padding is the start of the escape code, which the
+ * 				decoder waits for 8 more bits after, so it never decodes
+ * 				the padding as a character
+ *
+ * @param   :   encoder	- encoder state of a static table
+ * 				buffer	- buffer to fill with the last byte
+ * 				nbytes	- size of the buffer
+ *
+ * @return  : 	size_t	- number of bytes written to buffer, 0 or 1
+**********************************************************************************/
+size_t huffman_encoder_pad(huffman_encoder_t *encoder, uint8_t *buffer, size_t nbytes);
+
+/*********************************************************************************
+ * @brief   :  	Returns the number of bits a message encodes to with
+ * 				one of the tables
+ *
+ * @param   :   table	- ID of a table huffman_has_table accepts
+ * 				data	- message
+ * 				length	- number of bytes in data
+ *
+ * @return  : 	uint32_t	- number of encoded bits
+**********************************************************************************/
+uint32_t huffman_encoded_bits(uint8_t table, const uint8_t *data, size_t length);
+
+/*********************************************************************************
+ * @brief   :  	Returns the number of bits a message encodes to with the
+ * 				order-1 coder
+ *
+ * @param   :   data	- message
+ * 				length	- number of bytes in data
+ *
+ * @return  : 	uint32_t	- number of encoded bits
+**********************************************************************************/
+uint32_t huffman_context_bits(const uint8_t *data, size_t length);
+
+/*********************************************************************************
+ * @brief   :  	Picks the table which encodes a message to the fewest bits
+ *
+ * @param   :   data		- message
+ * 				length		- number of bytes in data
+ * 				table_count	- number of tables to pick from, the static tables
+ * 							  and the runtime table after them
+ * 				bits		- filled with the number of encoded bits, may be NULL
+ *
+ * @return  : 	uint8_t		- ID of the table, the lowest one on a tie
+**********************************************************************************/
+uint8_t huffman_select_table(const uint8_t *data, size_t length, uint8_t table_count, uint32_t *bits);
 
 /*********************************************************************************
  * @brief   :  	Encodes the message using the huffman lookup table for
  * 				data compression
- * 	
- * 				Credits to Prof. Howdy Pierce for this function
  *
  * @param   :   message	- message to be encoded
  * 				buffer	- buffer to fill with encoded message
  * 				nbytes	- size of the buffer
  *
- * @return  : 	void
+ * @return  : 	int		- number of encoded bits
 **********************************************************************************/
-int huffman_encode(const char *message, uint8_t *buffer, size_t nbytes);
\ No newline at end of file
+int huffman_encode(const char *message, uint8_t *buffer, size_t nbytes);
+
+/*********************************************************************************
+ * @brief   :  	Writes the sync bytes, type and sizes a frame starts with
+ *
+ * @param   :   type		- type byte of the frame
+ * 				sequence	- sequence number of the frame
+ * 				size		- original size of the message
+ * 				bits		- number of encoded bits, the message is ceil(bits / 8) bytes
+ * 				buffer		- buffer of at least HUFFMAN_FRAME_HEADER_MAX bytes
+ *
+ * @return  : 	size_t	- number of bytes written
+**********************************************************************************/
+size_t huffman_frame_header(uint8_t type, uint8_t sequence, uint32_t size, uint32_t bits, uint8_t *buffer);
+
+/*********************************************************************************
+ * @brief   :  	Reads the header of a frame
+ *
+ * @param   :   data		- received bytes, starting with the sync bytes
+ * 				length		- number of bytes in data
+ * 				type		- filled with the type byte
+ * 				sequence	- filled with the sequence number
+ * 				size		- filled with the original size
+ * 				bits		- filled with the number of encoded bits
+ *
+ * @return  : 	int		- number of bytes of the header, 0 if more bytes are
+ * 						  needed, -1 if data does not start with a header
+**********************************************************************************/
+int huffman_frame_parse(const uint8_t *data, size_t length, uint8_t *type, uint8_t *sequence,
+						uint32_t *size, uint32_t *bits);
+
+/*********************************************************************************
+ * @brief   :  	Adds bytes to the CRC-16/CCITT-FALSE of a frame
+ *
+ * @param   :   crc		- CRC of the bytes so far, HUFFMAN_FRAME_CRC_INIT at first
+ * 				data	- bytes to add
+ * 				length	- number of bytes in data
+ *
+ * @return  : 	uint16_t	- CRC with the bytes added
+**********************************************************************************/
+uint16_t huffman_frame_crc(uint16_t crc, const uint8_t *data, size_t length);
+
+#endif /* HUFFMAN_CODE_H_ */
@@ -27,6 +27,7 @@
 #include <string.h>
 #include <stdint.h>
 #include <math.h>
+#include <ctype.h>
 
 #include <assert.h>
 
@@ -37,13 +38,49 @@
 */
 typedef struct
 {
-	unsigned char character;
+	int character;
 	uint32_t code;
 	int code_bits;
 	int frequency;
 } huffman_code_t;
 
-huffman_code_t table[26];
+huffman_code_t table[NUMBER_OF_SYMBOLS];
+
+/* Code lengths of every generated table */
+int table_code_bits[MAX_TABLES][NUMBER_OF_SYMBOLS];
+
+/* Frequencies every generated table was built from, the escape counted once */
+int table_frequency[MAX_TABLES][NUMBER_OF_SYMBOLS];
+
+/* tANS tables of every generated table, see generate_ans_tables */
+uint32_t ans_decode_table[MAX_TABLES][ANS_STATES];
+uint16_t ans_state_table[MAX_TABLES][ANS_STATES];
+uint32_t ans_symbol_bits[MAX_TABLES][NUMBER_OF_SYMBOLS];
+int ans_symbol_state[MAX_TABLES][NUMBER_OF_SYMBOLS];
+
+/* Frequencies of the symbols before every symbol for the range coder, then the total */
+int range_cumulative[MAX_TABLES][NUMBER_OF_SYMBOLS + 1];
+
+/*
+ * Number of times every symbol follows every character in all the training
+ * files, the files split into symbols as the KL25Z does, a token counted
+ * after the character before it
+ */
+int context_frequency[NUMBER_OF_CHARACTERS][NUMBER_OF_SYMBOLS];
+
+/* Number of times every byte follows every character, for the coders of single characters */
+int context_byte_frequency[NUMBER_OF_CHARACTERS][NUMBER_OF_CHARACTERS];
+
+/* Table used after every character by the order-1 coder */
+int context_map[NUMBER_OF_CHARACTERS];
+
+/* Characters of every token chosen by choose_tokens, token t is symbol FIRST_TOKEN + t */
+unsigned char token_text[MAX_TOKENS][MAX_TOKEN_LENGTH];
+int token_length[MAX_TOKENS];
+int token_count = 0;
+
+/* Frequencies of the symbols every table codes, the tokens counted instead of their characters */
+int symbol_frequency[MAX_TABLES][NUMBER_OF_SYMBOLS];
 
 /*********************************************************************************
  * @brief   :   Creates a mew node of the huffman tree
@@ -53,7 +90,7 @@ huffman_code_t table[26];
  *
  * @return  : 	HuffmanTreeNode	- pointer to the new node
 **********************************************************************************/
-struct HuffmanTreeNode* new_node(char data, unsigned freq)
+struct HuffmanTreeNode* new_node(int data, unsigned freq)
 {
 	struct HuffmanTreeNode* temp = (struct HuffmanTreeNode*)malloc(sizeof(struct HuffmanTreeNode));
 
@@ -226,13 +263,13 @@ int is_leaf(struct HuffmanTreeNode* root)
  * 				Parent function to the create_huffman_tree 
  * 				and create_huffman_tree functions
  *
- * @param   :   data 	- array of characters
+ * @param   :   data 	- array of symbols
  * 				freq	- array of the frequency of characters	
  * 				size	- number of elements	
  *
  * @return  : 	HuffmanTree - pointer to the Huffman tree
 **********************************************************************************/
-struct HuffmanTree* create_build_huffman_tree(char data[], int freq[], int size)
+struct HuffmanTree* create_build_huffman_tree(int data[], int freq[], int size)
 {
 	struct HuffmanTree* minHeap = create_huffman_tree(size);
 
@@ -249,13 +286,13 @@ struct HuffmanTree* create_build_huffman_tree(char data[], int freq[], int size)
  * @brief   :   Makes the huffman tree
  * 				Parent function to the create_build_huffman_tree function
  *
- * @param   :   data 	- array of characters
+ * @param   :   data 	- array of symbols
  * 				freq	- array of the frequency of characters	
  * 				size	- number of elements	
  *
  * @return  : 	HuffmanTreeNode - root of the Huffman tree
 **********************************************************************************/
-struct HuffmanTreeNode* make_huffman_tree(char data[], int freq[], int size)
+struct HuffmanTreeNode* make_huffman_tree(int data[], int freq[], int size)
 {
 	struct HuffmanTreeNode *left, *right, *top;
 
@@ -272,7 +309,7 @@ struct HuffmanTreeNode* make_huffman_tree(char data[], int freq[], int size)
 		 * 	Make the two nodes as children of the new node
 		 *	Add this node to the tree
 		 */
-		top = new_node('$', left->freq + right->freq);
+		top = new_node(-1, left->freq + right->freq);
 
 		top->left = left;
 		top->right = right;
@@ -307,104 +344,458 @@ void traverse_huffman_tree(struct HuffmanTreeNode* root, int arr[], int top)
 		traverse_huffman_tree(root->right, arr, top + 1);
 	}
 
-	/* Leaf node detected */
+	/* Leaf node detected, only the depth is kept. The codes are assigned canonically */
 	if (is_leaf(root))
 	{
-		table[root->data].code_bits = top;
-		for (int i = 0; i < top; i++)
+		/* A tree with a single character still needs a one bit code */
+		table[root->data].code_bits = (top > 0) ? top : 1;
+	}
+}
+
+/*********************************************************************************
+ * @brief   :  	Compares two package-merge items by weight for qsort
+ *
+ * @param   :   a - first item
+ * 				b - second item
+ *
+ * @return  : 	int - negative, zero or positive like strcmp
+**********************************************************************************/
+static int compare_items(const void *a, const void *b)
+{
+	const struct PackageMergeItem *x = a, *y = b;
+
+	if (x->weight != y->weight)
+		return (x->weight < y->weight) ? -1 : 1;
+	return x->symbol - y->symbol;
+}
+
+/*********************************************************************************
+ * @brief   :  	Adds one bit to the code of every character in an item
+ *
+ * @param   :   item - leaf or package
+ *
+ * @return  : 	void
+**********************************************************************************/
+static void count_item_bits(struct PackageMergeItem *item)
+{
+	if (item->symbol >= 0)
+	{
+		table[item->symbol].code_bits++;
+	}
+	else
+	{
+		count_item_bits(item->left);
+		count_item_bits(item->right);
+	}
+}
+
+/*********************************************************************************
+ * @brief   :  	Limits the code lengths to a maximum using package-merge
+ *
+ * 				Every character is a coin of its frequency at each of the
+ * 				max_code_bits levels. Starting from the deepest level, pairs of
+ * 				the cheapest items are packaged and merged with the coins of the
+ * 				next level. The code length of a character is the number of its
+ * 				coins in the 2n-2 cheapest items of the last level, which gives
+ * 				the optimal code with no code longer than max_code_bits.
+ *
+ * @param   :   max_code_bits - longest code allowed
+ *
+ * @return  : 	void
+**********************************************************************************/
+void limit_code_lengths(int max_code_bits)
+{
+	struct PackageMergeItem *leaves = malloc(NUMBER_OF_SYMBOLS * sizeof(struct PackageMergeItem));
+	struct PackageMergeItem *list = NULL;
+	int symbols = 0, list_length = 0;
+
+	for (int i = 0; i < NUMBER_OF_SYMBOLS; i++)
+	{
+		table[i].code_bits = 0;
+		if (table[i].frequency > 0)
+		{
+			leaves[symbols].weight = table[i].frequency;
+			leaves[symbols].symbol = i;
+			leaves[symbols].left = leaves[symbols].right = NULL;
+			symbols++;
+		}
+	}
+
+	/* A single character still needs a one bit code */
+	if (symbols < 2)
+	{
+		if (symbols == 1)
+			table[leaves[0].symbol].code_bits = 1;
+		return;
+	}
+
+	/* There must be room for all the characters */
+	assert(max_code_bits < 32 && (1UL << max_code_bits) >= (unsigned long)symbols);
+
+	qsort(leaves, symbols, sizeof(struct PackageMergeItem), compare_items);
+
+	for (int level = max_code_bits; level >= 1; level--)
+	{
+		int packages = list_length / 2;
+		struct PackageMergeItem *merged = malloc((symbols + packages) * sizeof(struct PackageMergeItem));
+		int leaf = 0, package = 0, count = 0;
+
+		/* The previous list stays allocated as the packages point into it */
+		while (leaf < symbols || package < packages)
 		{
-			if (arr[i] == 1)
+			unsigned long package_weight = 0;
+
+			if (package < packages)
+				package_weight = list[2 * package].weight + list[2 * package + 1].weight;
+
+			if (package >= packages || (leaf < symbols && leaves[leaf].weight <= package_weight))
 			{
-				table[root->data].code += 1*(arr[i]<<(top-1-i));
-			}		
+				merged[count++] = leaves[leaf++];
+			}
+			else
+			{
+				merged[count].weight = package_weight;
+				merged[count].symbol = -1;
+				merged[count].left = &list[2 * package];
+				merged[count].right = &list[2 * package + 1];
+				count++;
+				package++;
+			}
 		}
+
+		list = merged;
+		list_length = count;
 	}
+
+	for (int i = 0; i < 2 * symbols - 2; i++)
+		count_item_bits(&list[i]);
 }
 
 /*********************************************************************************
- * @brief   :  	Creates the lookup table with characters and their frequencies
- * 				in the string
+ * @brief   :  	Returns the number of characters a symbol stands for
  *
- * @param   :   none
+ * @param   :   symbol - symbol
  *
- * @return  : 	int - number of characters with frequency greater than 0 
+ * @return  : 	int - number of characters
 **********************************************************************************/
-int create_lookup_table(void)
+static int symbol_length(int symbol)
 {
-	int count = 0;
-	for (int i = 0; i<NUMBER_OF_CHARACTERS; i++)
+	return (symbol >= FIRST_TOKEN) ? token_length[symbol - FIRST_TOKEN] : 1;
+}
+
+/*********************************************************************************
+ * @brief   :  	Reads a training file with every line ended by "\n\r"
+ *
+ * 				The KL25Z ends every line with "\n\r". The file is read
+ * 				that way so the tables don't depend on the line endings of
+ * 				the log file
+ *
+ * @param   :   file_name	- training file
+ * 				length		- set to the number of characters read
+ *
+ * @return  : 	unsigned char * - the characters, to be freed, NULL if the
+ * 								  file can't be read
+**********************************************************************************/
+unsigned char *read_training_file(const char *file_name, long *length)
+{
+	FILE *fileptr = fopen(file_name, "r");
+	long capacity = 4096, size = 0;
+	unsigned char *text = malloc(capacity);
+	int ch;
+
+	if (fileptr == NULL || text == NULL)
 	{
-		table[i].character = i;
-		/* If the character has a frequency increment count */
-		if (table[i].frequency > 0)
+		if (fileptr != NULL)
+			fclose(fileptr);
+		free(text);
+		return NULL;
+	}
+
+	while ((ch = fgetc(fileptr)) != EOF)
+	{
+		if (ch == '\r')
+			continue;
+
+		/* Room for the "\r" after a new line */
+		if (size + 2 > capacity)
 		{
-			count++;
+			capacity *= 2;
+			text = realloc(text, capacity);
+			assert(text != NULL);
 		}
+
+		text[size++] = ch;
+		if (ch == '\n')
+			text[size++] = '\r';
 	}
-	return count;
+	fclose(fileptr);
+
+	*length = size;
+	return text;
 }
 
 /*********************************************************************************
- * @brief   :  	Generates the header file for KL25Z which consists of the 
- * 				lookup table
+ * @brief   :  	Finds the longest token at the start of some text
  *
- * @param   :   none
+ * 				The KL25Z matches the tokens the same way, so the counts of
+ * 				the training files are those of the messages it sends
  *
- * @return  : 	void
+ * @param   :   text	- text
+ * 				length	- number of characters in text
+ * 				matched	- set to the number of characters of the symbol
+ *
+ * @return  : 	int - symbol of the token, or of the first character if no
+ * 					  token matches
 **********************************************************************************/
-void generate_header_file(void)
+int match_token(const unsigned char *text, long length, int *matched)
 {
-	printf("#ifndef LOOKUP_TABLE_H_\n");
-	printf("#define LOOKUP_TABLE_H_\n\n");
-	printf("#include<stdint.h>\n\n");
-	printf("typedef struct {\nunsigned char character;\nuint32_t code;\nint code_bits;\n} huffman_code_t;\n\n");
+	int symbol = text[0];
 
-	printf("huffman_code_t huffman_codes[] = {\n");
-	for (int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+	*matched = 1;
+	for (int t = 0; t < token_count; t++)
 	{
-		if (i != NUMBER_OF_CHARACTERS - 1)
-			printf("{%d, 0x%02x, %d},\n", table[i].character, table[i].code, table[i].code_bits);
-		else
-			printf("{%d, 0x%02x, %d} };\n\n", table[i].character, table[i].code, table[i].code_bits);
+		if (token_length[t] > *matched && token_length[t] <= length &&
+				memcmp(token_text[t], text, token_length[t]) == 0)
+		{
+			symbol = FIRST_TOKEN + t;
+			*matched = token_length[t];
+		}
 	}
 
-	printf("#endif\n");
+	return symbol;
+}
+
+/*********************************************************************************
+ * @brief   :  	Chooses the tokens of the training files
+ *
+ * 				The files are turned into symbols, one for every character.
+ * 				Then the pair of neighbouring symbols which occurs most often
+ * 				is merged into a token, as long as it has at most
+ * 				MAX_TOKEN_LENGTH characters, until there are enough tokens.
+ * 				So frequent bigrams come first and grow into the words and
+ * 				prompts the logs repeat
+ *
+ * @param   :   texts	- characters of every training file
+ * 				lengths	- number of characters of every training file
+ * 				files	- number of training files
+ * 				count	- number of tokens to choose, at most MAX_TOKENS
+ *
+ * @return  : 	int - number of tokens chosen
+**********************************************************************************/
+int choose_tokens(unsigned char *texts[], const long lengths[], int files, int count)
+{
+	static int pair_count[NUMBER_OF_SYMBOLS][NUMBER_OF_SYMBOLS];
+	int *symbols[MAX_TABLES];
+	long sizes[MAX_TABLES];
+
+	token_count = 0;
+	for (int f = 0; f < files; f++)
+	{
+		symbols[f] = malloc((lengths[f] + 1) * sizeof(int));
+		assert(symbols[f] != NULL);
+		for (long i = 0; i < lengths[f]; i++)
+			symbols[f][i] = texts[f][i];
+		sizes[f] = lengths[f];
+	}
+
+	while (token_count < count)
+	{
+		int best_first = 0, best_second = 0, best_count = 0;
+
+		memset(pair_count, 0, sizeof(pair_count));
+		for (int f = 0; f < files; f++)
+		{
+			for (long i = 0; i + 1 < sizes[f]; i++)
+			{
+				int first = symbols[f][i], second = symbols[f][i + 1];
+
+				if (symbol_length(first) + symbol_length(second) > MAX_TOKEN_LENGTH)
+					continue;
+
+				/* A run of one symbol holds half as many pairs as it has neighbours */
+				if (first == second && i > 0 && symbols[f][i - 1] == first)
+				{
+					long run = 1;
+					while (i - run > 0 && symbols[f][i - run - 1] == first)
+						run++;
+					if (run % 2 == 1)
+						continue;
+				}
+
+				if (++pair_count[first][second] > best_count)
+				{
+					best_count = pair_count[first][second];
+					best_first = first;
+					best_second = second;
+				}
+			}
+		}
+
+		/* A token which occurs once saves nothing */
+		if (best_count < 2)
+			break;
+
+		unsigned char text[MAX_TOKEN_LENGTH];
+		int length = 0, merged;
+
+		for (int k = 0; k < 2; k++)
+		{
+			int symbol = (k == 0) ? best_first : best_second;
+
+			if (symbol >= FIRST_TOKEN)
+			{
+				memcpy(text + length, token_text[symbol - FIRST_TOKEN], token_length[symbol - FIRST_TOKEN]);
+				length += token_length[symbol - FIRST_TOKEN];
+			}
+			else
+				text[length++] = symbol;
+		}
+
+		/* Different pairs may spell the same token */
+		for (merged = 0; merged < token_count; merged++)
+		{
+			if (token_length[merged] == length && memcmp(token_text[merged], text, length) == 0)
+				break;
+		}
+		if (merged == token_count)
+		{
+			memcpy(token_text[token_count], text, length);
+			token_length[token_count++] = length;
+		}
+
+		for (int f = 0; f < files; f++)
+		{
+			long size = 0;
+
+			for (long i = 0; i < sizes[f]; i++)
+			{
+				if (i + 1 < sizes[f] && symbols[f][i] == best_first && symbols[f][i + 1] == best_second)
+				{
+					symbols[f][size++] = FIRST_TOKEN + merged;
+					i++;
+				}
+				else
+					symbols[f][size++] = symbols[f][i];
+			}
+			sizes[f] = size;
+		}
+	}
+
+	for (int f = 0; f < files; f++)
+		free(symbols[f]);
+
+	return token_count;
 }
 
+/*********************************************************************************
+ * @brief   :  	Computes the average code length over the training data
+ *
+ * @param   :   none
+ *
+ * @return  : 	double - average number of bits per character
+**********************************************************************************/
+double average_code_bits(void)
+{
+	unsigned long bits = 0, characters = 0;
+
+	for (int i = 0; i < NUMBER_OF_SYMBOLS; i++)
+	{
+		bits += (unsigned long)table[i].frequency * table[i].code_bits;
+		characters += (unsigned long)table[i].frequency * symbol_length(i);
+	}
+
+	return (characters > 0) ? (double)bits / characters : 0;
+}
 
 /*********************************************************************************
- * @brief   :  	Generates the huffman tree
- * 				Parent of all functions
- * 				Tree generation begins here
+ * @brief   :  	Assigns canonical huffman codes from the code lengths
+ *
+ * 				Codes of the same length are consecutive numbers in the order
+ * 				of the characters, and every length starts where the previous
+ * 				one ended. The decoder can rebuild all the codes from the
+ * 				lengths alone.
  *
  * @param   :   none
  *
  * @return  : 	void
 **********************************************************************************/
-void generate_huffman_tree(void)
+void assign_canonical_codes(void)
 {
-	/* Open the file to take the input from */
-	FILE *fileptr;
-	char ch;
-	fileptr = fopen("hello.txt", "r");
-	/* Increment the frequency for every character */
-	while((ch = fgetc(fileptr)) != EOF)
+	uint32_t length_count[MAX_TREE_HT] = {0};
+	uint32_t next_code[MAX_TREE_HT] = {0};
+	uint32_t code = 0;
+
+	for (int i = 0; i < NUMBER_OF_SYMBOLS; i++)
 	{
-		table[ch].frequency++;
+		if (table[i].code_bits > 0)
+			length_count[table[i].code_bits]++;
 	}
-	fclose(fileptr);
-	fileptr = NULL;
+
+	/* First code of every length */
+	for (int bits = 1; bits < MAX_TREE_HT; bits++)
+	{
+		code = (code + length_count[bits - 1]) << 1;
+		next_code[bits] = code;
+	}
+
+	for (int i = 0; i < NUMBER_OF_SYMBOLS; i++)
+	{
+		if (table[i].code_bits > 0)
+			table[i].code = next_code[table[i].code_bits]++;
+	}
+}
+
+/*********************************************************************************
+ * @brief   :  	Creates the lookup table with characters and their frequencies
+ * 				in the string
+ *
+ * @param   :   none
+ *
+ * @return  : 	int - number of characters with frequency greater than 0 
+**********************************************************************************/
+int create_lookup_table(void)
+{
+	int count = 0;
+	for (int i = 0; i<NUMBER_OF_SYMBOLS; i++)
+	{
+		table[i].character = i;
+		/* If the character has a frequency increment count */
+		if (table[i].frequency > 0)
+		{
+			count++;
+		}
+	}
+	return count;
+}
+
+/*********************************************************************************
+ * @brief   :  	Builds the huffman tree of the frequencies in the table and
+ * 				sets the code length of every character to its depth
+ *
+ * 				The escape is given a frequency of 1 so it always has a code
+ *
+ * @param   :   none
+ *
+ * @return  : 	void
+**********************************************************************************/
+void build_code_lengths(void)
+{
+	/* The escape must have a code even though it never occurs in the log file */
+	table[ESCAPE_SYMBOL].frequency = 1;
+
+	for (int i = 0; i < NUMBER_OF_SYMBOLS; i++)
+		table[i].code_bits = 0;
 
 	/* Find number fof characters with frequency greater than 0 */
 	int symbols = create_lookup_table();
 
-	char non_zero_chars[symbols];
+	int non_zero_chars[symbols];
 	int non_zero_freqs[symbols];
 
 	int index = 0;
 
 	/* Fill the non zero frequency elements into two arrays */
-	for (int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+	for (int i = 0; i < NUMBER_OF_SYMBOLS; i++)
 	{
 		if (table[i].frequency > 0)
 		{
@@ -413,8 +804,6 @@ void generate_huffman_tree(void)
 		}
 	}
 
-	uint8_t buffer[1024];
-
 	/* Construct the Huffman Tree */
 	struct HuffmanTreeNode* root = make_huffman_tree(non_zero_chars, non_zero_freqs, symbols);
 
@@ -425,16 +814,872 @@ void generate_huffman_tree(void)
 }
 
 /*********************************************************************************
- * @brief   :  	Main entry point to the application
- * 
- * @param   :   none
+ * @brief   :  	Computes the bits a symbol takes with a table
  *
- * @return  : 	int
+ * 				A token without a code is sent as its characters, each
+ * 				counted with the same table
+ *
+ * @param   :   symbol		- character or token
+ * 				code_bits	- code length of every symbol of the table
+ *
+ * @return  : 	int - number of bits
+**********************************************************************************/
+int symbol_cost(int symbol, const int code_bits[])
+{
+	int bits = 0;
+
+	if (code_bits[symbol] > 0)
+		return code_bits[symbol];
+	if (symbol < NUMBER_OF_CHARACTERS)
+		return code_bits[ESCAPE_SYMBOL] + 8;
+
+	for (int k = 0; k < token_length[symbol - FIRST_TOKEN]; k++)
+		bits += symbol_cost(token_text[symbol - FIRST_TOKEN][k], code_bits);
+
+	return bits;
+}
+
+/*********************************************************************************
+ * @brief   :  	Computes the bits the symbols after one character take
+ * 				with a table, the tokens included
+ *
+ * @param   :   context		- previous character
+ * 				code_bits	- code length of every symbol of the table
+ *
+ * @return  : 	long - number of bits
+**********************************************************************************/
+long context_cost(int context, const int code_bits[])
+{
+	long bits = 0;
+
+	for (int i = 0; i < FIRST_TOKEN + token_count; i++)
+	{
+		if (context_frequency[context][i] > 0)
+			bits += (long)context_frequency[context][i] * symbol_cost(i, code_bits);
+	}
+
+	return bits;
+}
+
+/*********************************************************************************
+ * @brief   :  	Computes the length limited code lengths of some frequencies
+ *
+ * @param   :   frequency		- frequency of every symbol
+ * 				max_code_bits	- longest code allowed, 0 for no limit
+ * 				code_bits		- filled with the code length of every symbol
+ *
+ * @return  : 	void
+**********************************************************************************/
+void frequency_code_lengths(const int frequency[], int max_code_bits, int code_bits[])
+{
+	memset(table, 0, sizeof(table));
+	for (int i = 0; i < NUMBER_OF_SYMBOLS; i++)
+		table[i].frequency = frequency[i];
+
+	build_code_lengths();
+	if (max_code_bits > 0)
+		limit_code_lengths(max_code_bits);
+
+	for (int i = 0; i < NUMBER_OF_SYMBOLS; i++)
+		code_bits[i] = table[i].code_bits;
+}
+
+/*********************************************************************************
+ * @brief   :  	Maps every previous character to the table which codes the
+ * 				characters after it in the fewest bits
+ *
+ * @param   :   tables - number of tables to choose from
+ *
+ * @return  : 	int - number of characters which moved to another table
+**********************************************************************************/
+int assign_contexts(int tables)
+{
+	int changed = 0;
+
+	for (int context = 0; context < NUMBER_OF_CHARACTERS; context++)
+	{
+		long best_bits = context_cost(context, table_code_bits[0]);
+		int best = 0;
+
+		for (int t = 1; t < tables; t++)
+		{
+			long bits = context_cost(context, table_code_bits[t]);
+			if (bits < best_bits)
+			{
+				best_bits = bits;
+				best = t;
+			}
+		}
+
+		if (context_map[context] != best)
+			changed++;
+		context_map[context] = best;
+	}
+
+	return changed;
+}
+
+/*********************************************************************************
+ * @brief   :  	Generates the tables of the order-1 coder
+ *
+ * 				The coder picks the table for every character from the one
+ * 				before it. A table for each of the 256 previous characters
+ * 				would not fit on the KL25Z, so the previous characters are
+ * 				clustered. Every new table starts from the previous character
+ * 				which loses the most bits with the tables so far. Then the
+ * 				characters are mapped to their best table and the new tables
+ * 				are rebuilt from the characters mapped to them, until the
+ * 				map settles. The tables of the training files take part too.
+ *
+ * @param   :   first			- ID of the first new table, the tables before
+ * 								  it are kept as they are
+ * 				clusters		- number of new tables
+ * 				max_code_bits	- longest code allowed, 0 for no limit
+ *
+ * @return  : 	void
 **********************************************************************************/
-int main()
+void generate_context_tables(int first, int clusters, int max_code_bits)
 {
-	generate_huffman_tree();
-	generate_header_file();
+	static int own_code_bits[NUMBER_OF_CHARACTERS][NUMBER_OF_SYMBOLS];
+	long own_bits[NUMBER_OF_CHARACTERS];
+	long characters = 0, order0_bits = 0, order1_bits = 0;
+
+	/* Bits of every previous character with a table of its own, the best it can do */
+	for (int context = 0; context < NUMBER_OF_CHARACTERS; context++)
+	{
+		frequency_code_lengths(context_frequency[context], max_code_bits, own_code_bits[context]);
+		own_bits[context] = context_cost(context, own_code_bits[context]);
+	}
+
+	assign_contexts(first);
+
+	for (int k = 0; k < clusters; k++)
+	{
+		int seed = -1;
+		long most_lost = 0;
+
+		for (int context = 0; context < NUMBER_OF_CHARACTERS; context++)
+		{
+			long lost = context_cost(context, table_code_bits[context_map[context]]) - own_bits[context];
+			if (lost > most_lost)
+			{
+				most_lost = lost;
+				seed = context;
+			}
+		}
+
+		/* Nothing left to gain, the table is a copy of the first one */
+		memcpy(table_code_bits[first + k], (seed >= 0) ? own_code_bits[seed] : table_code_bits[0],
+				sizeof(table_code_bits[0]));
+
+		for (int round = 0; round < 50; round++)
+		{
+			int changed = assign_contexts(first + k + 1);
+
+			for (int t = first; t <= first + k; t++)
+			{
+				int frequency[NUMBER_OF_SYMBOLS] = {0};
+				int mapped = 0;
+
+				for (int context = 0; context < NUMBER_OF_CHARACTERS; context++)
+				{
+					if (context_map[context] != t)
+						continue;
+					mapped++;
+					for (int i = 0; i < NUMBER_OF_SYMBOLS; i++)
+						frequency[i] += context_frequency[context][i];
+				}
+
+				if (mapped > 0)
+					frequency_code_lengths(frequency, max_code_bits, table_code_bits[t]);
+			}
+
+			if (round > 0 && changed == 0)
+				break;
+		}
+	}
+
+	assign_contexts(first + clusters);
+
+	/*
+	 * Frequencies of the final tables, of the bytes for the other coders and
+	 * of the symbols for huffman. A table nothing maps to copies the first one
+	 */
+	for (int t = first; t < first + clusters; t++)
+	{
+		int mapped = 0;
+
+		memset(table_frequency[t], 0, sizeof(table_frequency[t]));
+		memset(symbol_frequency[t], 0, sizeof(symbol_frequency[t]));
+		for (int context = 0; context < NUMBER_OF_CHARACTERS; context++)
+		{
+			if (context_map[context] != t)
+				continue;
+			mapped++;
+			for (int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+				table_frequency[t][i] += context_byte_frequency[context][i];
+			for (int i = 0; i < NUMBER_OF_SYMBOLS; i++)
+				symbol_frequency[t][i] += context_frequency[context][i];
+		}
+
+		if (mapped == 0)
+		{
+			memcpy(table_frequency[t], table_frequency[0], sizeof(table_frequency[0]));
+			memcpy(symbol_frequency[t], symbol_frequency[0], sizeof(symbol_frequency[0]));
+		}
+		table_frequency[t][ESCAPE_SYMBOL] = 1;
+	}
+
+	/* The report goes to stderr as stdout is redirected to the header file */
+	for (int t = 0; t < first; t++)
+	{
+		long bits = 0;
+		for (int context = 0; context < NUMBER_OF_CHARACTERS; context++)
+			bits += context_cost(context, table_code_bits[t]);
+		if (t == 0 || bits < order0_bits)
+			order0_bits = bits;
+	}
+
+	for (int context = 0; context < NUMBER_OF_CHARACTERS; context++)
+	{
+		order1_bits += context_cost(context, table_code_bits[context_map[context]]);
+		for (int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+			characters += context_byte_frequency[context][i];
+	}
+
+	/*
+	 * Both figures code the files split into symbols, the tokens included.
+	 * The map, then a byte of code length and two bytes of code for every symbol of the tables
+	 */
+	if (characters > 0)
+		fprintf(stderr, "Order-1 with %d context tables: %.4f bits per character, %.4f with the "
+				"best single table, both with the tokens. Flash cost %d bytes\n", clusters, (double)order1_bits / characters,
+				(double)order0_bits / characters, NUMBER_OF_CHARACTERS + 3 * clusters * (FIRST_TOKEN + token_count));
+}
+
+/*********************************************************************************
+ * @brief   :  	Scales the frequencies of a table so they add up to a total
+ *
+ * 				Every symbol which occurs keeps at least 1. The rounding is
+ * 				fixed up one step at a time where it costs the fewest bits
+ *
+ * @param   :   frequency	- frequency of every symbol
+ * 				total		- sum of the scaled frequencies
+ * 				norm		- filled with the scaled frequency of every symbol
+ *
+ * @return  : 	void
+**********************************************************************************/
+void normalize_frequencies(const int frequency[], int total, int norm[])
+{
+	long count = 0;
+	int sum = 0;
+
+	for (int i = 0; i < NUMBER_OF_SYMBOLS; i++)
+		count += frequency[i];
+
+	for (int i = 0; i < NUMBER_OF_SYMBOLS; i++)
+	{
+		norm[i] = 0;
+		if (frequency[i] > 0)
+		{
+			norm[i] = (int)(((long)frequency[i] * total) / count);
+			if (norm[i] == 0)
+				norm[i] = 1;
+		}
+		sum += norm[i];
+	}
+
+	while (sum != total)
+	{
+		int best = -1;
+		double best_cost = 0;
+
+		for (int i = 0; i < NUMBER_OF_SYMBOLS; i++)
+		{
+			double cost;
+
+			/* Bits gained by one more state, or lost by one less */
+			if (sum < total && norm[i] > 0)
+				cost = -frequency[i] * log2((double)(norm[i] + 1) / norm[i]);
+			else if (sum > total && norm[i] > 1)
+				cost = frequency[i] * log2((double)norm[i] / (norm[i] - 1));
+			else
+				continue;
+
+			if (best < 0 || cost < best_cost)
+			{
+				best = i;
+				best_cost = cost;
+			}
+		}
+
+		norm[best] += (sum < total) ? 1 : -1;
+		sum += (sum < total) ? 1 : -1;
+	}
+}
+
+/*********************************************************************************
+ * @brief   :  	Builds the tANS tables of every table from its frequencies
+ *
+ * 				The symbols are spread over the states with a step which is
+ * 				prime to ANS_STATES so every symbol is spread evenly. Decoding
+ * 				state u gives its symbol, the number of bits to read and the
+ * 				state to add them to. Encoding state x with a symbol of
+ * 				frequency n sends the low bits of x until it is in [n, 2n),
+ * 				then looks up the next state. The bits to send come out of
+ * 				one add and shift with ans_symbol_bits
+ *
+ * @param   :   tables - number of tables
+ *
+ * @return  : 	void
+**********************************************************************************/
+void generate_ans_tables(int tables)
+{
+	const int step = (ANS_STATES >> 1) + (ANS_STATES >> 3) + 3;
+
+	for (int t = 0; t < tables; t++)
+	{
+		int norm[NUMBER_OF_SYMBOLS], next[NUMBER_OF_SYMBOLS], cumulative[NUMBER_OF_SYMBOLS];
+		int spread[ANS_STATES];
+		int position = 0, start = 0;
+
+		normalize_frequencies(table_frequency[t], ANS_STATES, norm);
+
+		for (int i = 0; i < NUMBER_OF_SYMBOLS; i++)
+		{
+			for (int k = 0; k < norm[i]; k++)
+			{
+				spread[position] = i;
+				position = (position + step) & (ANS_STATES - 1);
+			}
+			cumulative[i] = start;
+			next[i] = norm[i];
+			start += norm[i];
+		}
+
+		for (int u = 0; u < ANS_STATES; u++)
+		{
+			int symbol = spread[u];
+			int x = next[symbol]++;
+			int bits = ANS_TABLE_LOG;
+
+			while ((x << (ANS_TABLE_LOG - bits)) < ANS_STATES)
+				bits--;
+			bits = ANS_TABLE_LOG - bits;
+
+			ans_decode_table[t][u] = ((x << bits) - ANS_STATES) | (bits << 12) | ((uint32_t)symbol << 16);
+			ans_state_table[t][cumulative[symbol] + x - norm[symbol]] = ANS_STATES + u;
+		}
+
+		for (int i = 0; i < NUMBER_OF_SYMBOLS; i++)
+		{
+			ans_symbol_bits[t][i] = 0;
+			ans_symbol_state[t][i] = 0;
+			if (norm[i] == 0)
+				continue;
+
+			/* Most bits sent for the symbol, one less for states below norm << most */
+			int most = 0;
+			while ((norm[i] << most) <= ANS_STATES)
+				most++;
+
+			ans_symbol_bits[t][i] = ((uint32_t)most << 16) - ((uint32_t)norm[i] << most);
+			ans_symbol_state[t][i] = cumulative[i] - norm[i];
+		}
+
+	}
+}
+
+/*********************************************************************************
+ * @brief   :  	Builds the cumulative frequencies of the range coder of every
+ * 				table and reports how close each coder gets to the entropy
+ *
+ * 				The bits per character are those of the training characters
+ * 				of each table, without the few bits every message adds
+ *
+ * @param   :   tables - number of tables
+ *
+ * @return  : 	void
+**********************************************************************************/
+void generate_range_tables(int tables)
+{
+	for (int t = 0; t < tables; t++)
+	{
+		int range_norm[NUMBER_OF_SYMBOLS], ans_norm[NUMBER_OF_SYMBOLS];
+		long characters = 0;
+		double entropy = 0, range_bits = 0, ans_bits = 0, huffman_bits = 0;
+
+		normalize_frequencies(table_frequency[t], 1 << RANGE_TOTAL_BITS, range_norm);
+		normalize_frequencies(table_frequency[t], ANS_STATES, ans_norm);
+
+		range_cumulative[t][0] = 0;
+		for (int i = 0; i < NUMBER_OF_SYMBOLS; i++)
+			range_cumulative[t][i + 1] = range_cumulative[t][i] + range_norm[i];
+
+		/* The report goes to stderr as stdout is redirected to the header file */
+		for (int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+			characters += table_frequency[t][i];
+		if (characters == 0)
+			continue;
+
+		for (int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+		{
+			if (table_frequency[t][i] == 0)
+				continue;
+			entropy += table_frequency[t][i] * log2((double)characters / table_frequency[t][i]);
+			range_bits += table_frequency[t][i] * log2((double)(1 << RANGE_TOTAL_BITS) / range_norm[i]);
+			ans_bits += table_frequency[t][i] * log2((double)ANS_STATES / ans_norm[i]);
+		}
+
+		/* Huffman codes the tokens too */
+		for (int i = 0; i < FIRST_TOKEN + token_count; i++)
+		{
+			if (i != ESCAPE_SYMBOL)
+				huffman_bits += (double)symbol_frequency[t][i] * table_code_bits[t][i];
+		}
+
+		fprintf(stderr, "Table %d: entropy %.4f bits per character, range coder %.4f, tANS %.4f, huffman %.4f\n",
+				t, entropy / characters, range_bits / characters, ans_bits / characters, huffman_bits / characters);
+	}
+}
+
+/*********************************************************************************
+ * @brief   :  	Generates the header file for KL25Z which consists of the 
+ * 				lookup tables
+ *
+ * @param   :   file_names	- training file of every table
+ * 				files		- number of training files
+ * 				clusters	- number of order-1 tables after the ones of the files
+ *
+ * @return  : 	void
+**********************************************************************************/
+void generate_header_file(char *file_names[], int files, int clusters)
+{
+	int tables = files + clusters;
+	int symbols = FIRST_TOKEN + token_count;
+
+	printf("#ifndef LOOKUP_TABLE_H_\n");
+	printf("#define LOOKUP_TABLE_H_\n\n");
+	printf("#include <stdint.h>\n\n");
+
+	int max_code_bits = 0;
+	for (int t = 0; t < tables; t++)
+	{
+		for (int i = 0; i < symbols; i++)
+		{
+			if (table_code_bits[t][i] > max_code_bits)
+				max_code_bits = table_code_bits[t][i];
+		}
+	}
+
+	printf("/* Number of symbols in the huffman table, every byte, the escape and the tokens */\n");
+	printf("#define HUFFMAN_NUM_SYMBOLS (%d)\n\n", symbols);
+
+	printf("/* Symbol sent before the 8 bits of a byte which has no code */\n");
+	printf("#define HUFFMAN_ESCAPE_SYMBOL (%d)\n\n", ESCAPE_SYMBOL);
+
+	printf("/* Length of the longest code in the tables */\n");
+	printf("#define HUFFMAN_MAX_CODE_LENGTH (%d)\n\n", max_code_bits);
+
+	printf("/* Number of tables, one for every training file, then the ones of the order-1 coder */\n");
+	printf("#define HUFFMAN_NUM_TABLES (%d)\n", tables);
+	printf("#define HUFFMAN_NUM_CONTEXT_TABLES (%d)\n\n", clusters);
+
+	printf("/* Previous character the order-1 coder starts every message with */\n");
+	printf("#define HUFFMAN_CONTEXT_START (%d)\n\n", CONTEXT_START);
+
+	/* FNV-1a of the code lengths, data encoded at build time records the tables it needs */
+	uint32_t hash = 2166136261UL;
+	for (int t = 0; t < tables; t++)
+	{
+		for (int i = 0; i < symbols; i++)
+			hash = (hash ^ table_code_bits[t][i]) * 16777619UL;
+	}
+	for (int t = 0; t < token_count; t++)
+	{
+		for (int k = 0; k < token_length[t]; k++)
+			hash = (hash ^ token_text[t][k]) * 16777619UL;
+	}
+	printf("/* Hash of the code lengths of the tables */\n");
+	printf("#define HUFFMAN_TABLES_HASH (0x%08lXUL)\n\n", (unsigned long)hash);
+
+	/* The ID of every table is named after its training file */
+	printf("/* ID of every table */\n");
+	for (int t = 0; t < files; t++)
+	{
+		const char *name = strrchr(file_names[t], '/');
+		name = (name != NULL) ? name + 1 : file_names[t];
+
+		printf("#define HUFFMAN_TABLE_");
+		for (; *name != '\0' && *name != '.'; name++)
+			putchar(isalnum((unsigned char)*name) ? toupper((unsigned char)*name) : '_');
+		printf(" (%d)\n", t);
+	}
+	for (int t = files; t < tables; t++)
+		printf("#define HUFFMAN_TABLE_CONTEXT_%d (%d)\n", t - files, t);
+	printf("\n");
+
+	printf("/* Canonical code length of every symbol, 0 for bytes which are sent escaped */\n");
+	printf("static const uint8_t huffman_code_lengths[HUFFMAN_NUM_TABLES][HUFFMAN_NUM_SYMBOLS] = {\n");
+	for (int t = 0; t < tables; t++)
+	{
+		if (t < files)
+			printf("/* %s */\n{\n", file_names[t]);
+		else
+			printf("/* Order-1 table %d */\n{\n", t - files);
+		for (int i = 0; i < symbols; i++)
+		{
+			printf("%2d,%s", table_code_bits[t][i],
+					((i % 16) == 15 || i == symbols - 1) ? "\n" : " ");
+		}
+		printf("},\n");
+	}
+	printf("};\n\n");
+
+	/* The codes are kept in flash so the encoders need no RAM for them */
+	printf("/* Canonical code of every symbol, rebuilt from the code lengths */\n");
+	printf("static const uint16_t huffman_codes[HUFFMAN_NUM_TABLES][HUFFMAN_NUM_SYMBOLS] = {\n");
+	for (int t = 0; t < tables; t++)
+	{
+		uint32_t length_count[MAX_TREE_HT] = {0};
+		uint32_t next_code[MAX_TREE_HT] = {0};
+		uint32_t code = 0;
+
+		for (int i = 0; i < symbols; i++)
+		{
+			if (table_code_bits[t][i] > 0)
+				length_count[table_code_bits[t][i]]++;
+		}
+		for (int bits = 1; bits < MAX_TREE_HT; bits++)
+		{
+			code = (code + length_count[bits - 1]) << 1;
+			next_code[bits] = code;
+		}
+
+		printf("{\n");
+		for (int i = 0; i < symbols; i++)
+		{
+			code = (table_code_bits[t][i] > 0) ? next_code[table_code_bits[t][i]]++ : 0;
+			printf("0x%03lX,%s", (unsigned long)code, ((i % 16) == 15 || i == symbols - 1) ? "\n" : " ");
+		}
+		printf("},\n");
+	}
+	printf("};\n\n");
+
+	int longest = 0;
+	for (int t = 0; t < token_count; t++)
+	{
+		if (token_length[t] > longest)
+			longest = token_length[t];
+	}
+
+	printf("/* Tokens, strings of characters coded as one symbol, the first one after the escape */\n");
+	printf("#define HUFFMAN_FIRST_TOKEN (%d)\n", FIRST_TOKEN);
+	printf("#define HUFFMAN_NUM_TOKENS (%d)\n", token_count);
+	printf("#define HUFFMAN_LONGEST_TOKEN (%d)\n\n", longest);
+
+	printf("/* Characters of every token start at its offset in huffman_token_text, then the end */\n");
+	printf("static const uint8_t huffman_token_offsets[HUFFMAN_NUM_TOKENS + 1] = {");
+	for (int t = 0, offset = 0; t <= token_count; t++)
+	{
+		printf("%s%d", (t > 0) ? ", " : " ", offset);
+		if (t < token_count)
+			offset += token_length[t];
+	}
+	printf(" };\n\n");
+
+	/* Three digit octal escapes so a digit after one is not taken into it */
+	printf("static const char huffman_token_text[] = \"");
+	for (int t = 0; t < token_count; t++)
+	{
+		for (int k = 0; k < token_length[t]; k++)
+		{
+			unsigned char ch = token_text[t][k];
+
+			if (ch == '"' || ch == '\\' || ch == '?')
+				printf("\\%c", ch);
+			else if (isprint(ch))
+				putchar(ch);
+			else
+				printf("\\%03o", ch);
+		}
+	}
+	printf("\";\n\n");
+
+	/*
+	 * The encoder finds the longest token at every character by walking a
+	 * trie. The children of a node are a list, a few at most past the first
+	 * character, which is looked up in huffman_token_start
+	 */
+	static int trie[1 + MAX_TOKENS * MAX_TOKEN_LENGTH][4];
+	int nodes = 1;
+
+	memset(trie, 0, sizeof(trie));
+	for (int t = 0; t < token_count; t++)
+	{
+		int node = 0;
+
+		for (int k = 0; k < token_length[t]; k++)
+		{
+			int child = trie[node][1];
+
+			while (child != 0 && trie[child][0] != token_text[t][k])
+				child = trie[child][2];
+			if (child == 0)
+			{
+				child = nodes++;
+				trie[child][0] = token_text[t][k];
+				trie[child][2] = trie[node][1];
+				trie[node][1] = child;
+			}
+			node = child;
+		}
+		trie[node][3] = t + 1;
+	}
+
+	printf("/* Node of the first character of the tokens which start with every character, 0 for none */\n");
+	printf("static const uint8_t huffman_token_start[%d] = {\n", NUMBER_OF_CHARACTERS);
+	for (int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+	{
+		int child = trie[0][1];
+
+		while (child != 0 && trie[child][0] != i)
+			child = trie[child][2];
+		printf("%3d,%s", child, ((i % 16) == 15) ? "\n" : " ");
+	}
+	printf("};\n\n");
+
+	printf("/* Trie of the tokens, node 0 is the root */\n");
+	printf("#define HUFFMAN_TOKEN_NODES (%d)\n\n", nodes);
+	printf("/* Every node is { character, first child, next sibling, token + 1 }, 0 for none */\n");
+	printf("static const uint8_t huffman_token_trie[HUFFMAN_TOKEN_NODES][4] = {\n");
+	for (int n = 0; n < nodes; n++)
+	{
+		printf("{ %3d, %3d, %3d, %2d },%s", trie[n][0], trie[n][1], trie[n][2], trie[n][3],
+				((n % 4) == 3 || n == nodes - 1) ? "\n" : " ");
+	}
+	printf("};\n\n");
+
+	printf("/* Table of the order-1 coder after every character */\n");
+	printf("static const uint8_t huffman_context_map[%d] = {\n", NUMBER_OF_CHARACTERS);
+	for (int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+		printf("%d,%s", context_map[i], ((i % 16) == 15) ? "\n" : " ");
+	printf("};\n\n");
+
+	printf("/* The tANS coder has 2^HUFFMAN_ANS_TABLE_LOG states for every table */\n");
+	printf("#define HUFFMAN_ANS_TABLE_LOG (%d)\n", ANS_TABLE_LOG);
+	printf("#define HUFFMAN_ANS_STATES (%d)\n\n", ANS_STATES);
+
+	printf("/* tANS decoding of every state: next state in bits 0-11, bits to add to it in bits 12-15, symbol from bit 16 */\n");
+	printf("static const uint32_t huffman_ans_decode_table[HUFFMAN_NUM_TABLES][HUFFMAN_ANS_STATES] = {\n");
+	for (int t = 0; t < tables; t++)
+	{
+		printf("{\n");
+		for (int u = 0; u < ANS_STATES; u++)
+			printf("0x%06lX,%s", (unsigned long)ans_decode_table[t][u], ((u % 8) == 7) ? "\n" : " ");
+		printf("},\n");
+	}
+	printf("};\n\n");
+
+	printf("/* tANS encoding, state of every symbol in the order of the symbols */\n");
+	printf("static const uint16_t huffman_ans_state_table[HUFFMAN_NUM_TABLES][HUFFMAN_ANS_STATES] = {\n");
+	for (int t = 0; t < tables; t++)
+	{
+		printf("{\n");
+		for (int u = 0; u < ANS_STATES; u++)
+			printf("%4d,%s", ans_state_table[t][u], ((u % 16) == 15) ? "\n" : " ");
+		printf("},\n");
+	}
+	printf("};\n\n");
+
+	printf("/* tANS encoding, bits to send are (state + this) >> 16, 0 for bytes which are sent escaped */\n");
+	printf("static const uint32_t huffman_ans_symbol_bits[HUFFMAN_NUM_TABLES][HUFFMAN_NUM_SYMBOLS] = {\n");
+	for (int t = 0; t < tables; t++)
+	{
+		printf("{\n");
+		for (int i = 0; i < symbols; i++)
+		{
+			printf("0x%05lX,%s", (unsigned long)ans_symbol_bits[t][i],
+					((i % 8) == 7 || i == symbols - 1) ? "\n" : " ");
+		}
+		printf("},\n");
+	}
+	printf("};\n\n");
+
+	printf("/* tANS encoding, added to the state shifted by the bits sent to find the next one */\n");
+	printf("static const int16_t huffman_ans_symbol_state[HUFFMAN_NUM_TABLES][HUFFMAN_NUM_SYMBOLS] = {\n");
+	for (int t = 0; t < tables; t++)
+	{
+		printf("{\n");
+		for (int i = 0; i < symbols; i++)
+		{
+			printf("%4d,%s", ans_symbol_state[t][i],
+					((i % 16) == 15 || i == symbols - 1) ? "\n" : " ");
+		}
+		printf("},\n");
+	}
+	printf("};\n\n");
+
+	printf("/* The frequencies of the range coder of every table add up to 2^HUFFMAN_RANGE_TOTAL_BITS */\n");
+	printf("#define HUFFMAN_RANGE_TOTAL_BITS (%d)\n\n", RANGE_TOTAL_BITS);
+
+	printf("/* Range coder, sum of the frequencies of the symbols before every symbol, then the total */\n");
+	printf("static const uint16_t huffman_range_cumulative[HUFFMAN_NUM_TABLES][HUFFMAN_NUM_SYMBOLS + 1] = {\n");
+	for (int t = 0; t < tables; t++)
+	{
+		printf("{\n");
+		for (int i = 0; i <= symbols; i++)
+			printf("%4d,%s", range_cumulative[t][i], ((i % 16) == 15 || i == symbols) ? "\n" : " ");
+		printf("},\n");
+	}
+	printf("};\n\n");
+
+	printf("#endif\n");
+}
+
+
+/*********************************************************************************
+ * @brief   :  	Generates the huffman tree of one training file
+ * 				Parent of all functions
+ * 				Tree generation begins here
+ *
+ * 				The code lengths come from the symbols of the file, a token
+ * 				counted instead of its characters. The other coders code the
+ * 				characters one by one, they get the frequency of every byte
+ *
+ * @param   :   file_name		- training file, for the report
+ * 				text			- characters of the training file
+ * 				length			- number of characters in text
+ * 				max_code_bits	- longest code allowed, 0 for no limit
+ * 				byte_frequency	- filled with the frequency of every byte
+ *
+ * @return  : 	void
+**********************************************************************************/
+void generate_huffman_tree(const char *file_name, const unsigned char *text, long length,
+							int max_code_bits, int byte_frequency[])
+{
+	/* Every file starts from an empty table */
+	memset(table, 0, sizeof(table));
+	memset(byte_frequency, 0, NUMBER_OF_SYMBOLS * sizeof(int));
+
+	/* Increment the frequency for every character, and for it after the previous one */
+	int previous = CONTEXT_START;
+	for (long i = 0; i < length; i++)
+	{
+		byte_frequency[text[i]]++;
+		context_byte_frequency[previous][text[i]]++;
+		previous = text[i];
+	}
+
+	/* Split the file into symbols as the KL25Z does, the order-1 coder takes the tokens too */
+	previous = CONTEXT_START;
+	for (long i = 0; i < length; )
+	{
+		int matched;
+		int symbol = match_token(text + i, length - i, &matched);
+
+		table[symbol].frequency++;
+		context_frequency[previous][symbol]++;
+		i += matched;
+		previous = text[i - 1];
+	}
+
+	build_code_lengths();
+
+	/*
+	 * Replace the tree depths by the best code within the length limit
+	 * The report goes to stderr as stdout is redirected to the header file
+	 */
+	if (max_code_bits > 0)
+	{
+		double unlimited = average_code_bits();
+
+		limit_code_lengths(max_code_bits);
+
+		double limited = average_code_bits();
+		fprintf(stderr, "%s: codes limited to %d bits: %.4f bits per character, "
+				"%.4f without the limit (%.2f%% larger output)\n",
+				file_name, max_code_bits, limited, unlimited, (limited - unlimited) * 100 / unlimited);
+	}
+
+	assign_canonical_codes();
+}
+
+/*********************************************************************************
+ * @brief   :  	Main entry point to the application
+ * 
+ * @param   :   argc - number of arguments
+ * 				argv - optional maximum code length in bits, optionally -cN for
+ * 					   N order-1 tables (DEFAULT_CONTEXT_TABLES if left out)
+ * 					   and -tN for N tokens (DEFAULT_TOKENS if left out),
+ * 					   followed by the training files, one for every table
+ * 					   (hello.txt if none)
+ *
+ * @return  : 	int
+**********************************************************************************/
+int main(int argc, char *argv[])
+{
+	static char *default_files[] = { "hello.txt" };
+	int max_code_bits = (argc > 1) ? atoi(argv[1]) : 0;
+	int clusters = DEFAULT_CONTEXT_TABLES;
+	int tokens = DEFAULT_TOKENS;
+	int first_file = 2;
+
+	for (; argc > first_file && argv[first_file][0] == '-'; first_file++)
+	{
+		if (argv[first_file][1] == 'c')
+			clusters = atoi(argv[first_file] + 2);
+		else if (argv[first_file][1] == 't')
+			tokens = atoi(argv[first_file] + 2);
+	}
+
+	char **file_names = (argc > first_file) ? &argv[first_file] : default_files;
+	int tables = (argc > first_file) ? argc - first_file : 1;
+
+	if (tables + clusters > MAX_TABLES || clusters < 0)
+	{
+		fprintf(stderr, "At most %d tables can be generated\n", MAX_TABLES);
+		return 1;
+	}
+
+	if (tokens < 0 || tokens > MAX_TOKENS)
+	{
+		fprintf(stderr, "At most %d tokens can be chosen\n", MAX_TOKENS);
+		return 1;
+	}
+
+	unsigned char *texts[MAX_TABLES];
+	long lengths[MAX_TABLES];
+
+	for (int t = 0; t < tables; t++)
+	{
+		texts[t] = read_training_file(file_names[t], &lengths[t]);
+		if (texts[t] == NULL)
+		{
+			fprintf(stderr, "Cannot read %s\n", file_names[t]);
+			return 1;
+		}
+	}
+
+	choose_tokens(texts, lengths, tables, tokens);
+
+	for (int t = 0; t < tables; t++)
+	{
+		generate_huffman_tree(file_names[t], texts[t], lengths[t], max_code_bits, table_frequency[t]);
+		table_frequency[t][ESCAPE_SYMBOL] = 1;
+
+		for (int i = 0; i < NUMBER_OF_SYMBOLS; i++)
+		{
+			table_code_bits[t][i] = table[i].code_bits;
+			symbol_frequency[t][i] = table[i].frequency;
+		}
+		free(texts[t]);
+	}
+
+	generate_context_tables(tables, clusters, max_code_bits);
+	generate_ans_tables(tables + clusters);
+	generate_range_tables(tables + clusters);
+	generate_header_file(file_names, tables, clusters);
 
 	return 0;
 }
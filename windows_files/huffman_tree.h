@@ -27,17 +27,53 @@
 
 #define MAX_TREE_HT 100
 
-#define NUMBER_OF_CHARACTERS 128
+#define NUMBER_OF_CHARACTERS 256
+
+/* Symbol sent before the 8 bits of a character which has no code */
+#define ESCAPE_SYMBOL NUMBER_OF_CHARACTERS
+
+/*
+ * Strings of characters of the training files coded as one symbol, after the
+ * escape. The KL25Z takes at most HUFFMAN_MAX_TOKENS of HUFFMAN_MAX_TOKEN_LENGTH
+ * characters (huffman.h)
+ */
+#define FIRST_TOKEN (NUMBER_OF_CHARACTERS + 1)
+#define MAX_TOKENS 16
+#define MAX_TOKEN_LENGTH 8
+
+/* Tokens chosen when the number is not given */
+#define DEFAULT_TOKENS 16
+
+#define NUMBER_OF_SYMBOLS (FIRST_TOKEN + MAX_TOKENS)
+
+/*
+ * Most tables generated at once, one for every training file. The KL25Z
+ * sends the table ID in 3 bits and keeps one ID for the table it rebuilds
+ */
+#define MAX_TABLES 7
+
+/* Order-1 tables generated when the number is not given */
+#define DEFAULT_CONTEXT_TABLES 2
+
+/* Previous character the order-1 coder starts with, the end of a line */
+#define CONTEXT_START '\r'
+
+/* The tANS coder has 2^ANS_TABLE_LOG states, its frequencies add up to that */
+#define ANS_TABLE_LOG 9
+#define ANS_STATES (1 << ANS_TABLE_LOG)
+
+/* The frequencies of the range coder add up to 2^RANGE_TOTAL_BITS */
+#define RANGE_TOTAL_BITS 12
 /*
  * 	HuffmanTreeNode is a node of the huffman tree
- * 	data	- one of the input characters
+ * 	data	- one of the input symbols, -1 for an internal node
  * 	freq	- frequency of the character
  *	left	- left child of this node
  *	right	- right child of this node
 */
 struct HuffmanTreeNode
 {
-	char data;
+	int data;
 	unsigned freq; 
 	struct HuffmanTreeNode *left, *right; 
 };
@@ -55,6 +91,20 @@ struct HuffmanTree
 	struct HuffmanTreeNode** array; 
 };
 
+/*
+ * 	PackageMergeItem is an item of the package-merge algorithm
+ * 	weight	- total frequency of the item
+ * 	symbol	- character of a leaf item, -1 for a package
+ *	left	- first item merged into this package
+ *	right	- second item merged into this package
+*/
+struct PackageMergeItem
+{
+	unsigned long weight;
+	int symbol;
+	struct PackageMergeItem *left, *right;
+};
+
 /*********************************************************************************
  * @brief   :   Creates a mew node of the huffman tree
  *
@@ -63,7 +113,7 @@ struct HuffmanTree
  *
  * @return  : 	HuffmanTreeNode	- pointer to the new node
 **********************************************************************************/
-struct HuffmanTreeNode* new_node(char data, unsigned freq);
+struct HuffmanTreeNode* new_node(int data, unsigned freq);
 
 /*********************************************************************************
  * @brief   :   Creates a the huffman tree
@@ -157,25 +207,25 @@ int is_leaf(struct HuffmanTreeNode* root);
  * 				Parent function to the create_huffman_tree 
  * 				and create_huffman_tree functions
  *
- * @param   :   data 	- array of characters
+ * @param   :   data 	- array of symbols
  * 				freq	- array of the frequency of characters	
  * 				size	- number of elements	
  *
  * @return  : 	HuffmanTree - pointer to the Huffman tree
 **********************************************************************************/
-struct HuffmanTree* create_build_huffman_tree(char data[], int freq[], int size);
+struct HuffmanTree* create_build_huffman_tree(int data[], int freq[], int size);
 
 /*********************************************************************************
  * @brief   :   Makes the huffman tree
  * 				Parent function to the create_build_huffman_tree function
  *
- * @param   :   data 	- array of characters
+ * @param   :   data 	- array of symbols
  * 				freq	- array of the frequency of characters	
  * 				size	- number of elements	
  *
  * @return  : 	HuffmanTreeNode - root of the Huffman tree
 **********************************************************************************/
-struct HuffmanTreeNode* make_huffman_tree(char data[], int freq[], int size);
+struct HuffmanTreeNode* make_huffman_tree(int data[], int freq[], int size);
 
 /*********************************************************************************
  * @brief   :   Traverses through the entire huffman tree
@@ -188,6 +238,33 @@ struct HuffmanTreeNode* make_huffman_tree(char data[], int freq[], int size);
 **********************************************************************************/
 void traverse_huffman_tree(struct HuffmanTreeNode* root, int arr[], int top);
 
+/*********************************************************************************
+ * @brief   :  	Limits the code lengths to a maximum using package-merge
+ *
+ * @param   :   max_code_bits - longest code allowed
+ *
+ * @return  : 	void
+**********************************************************************************/
+void limit_code_lengths(int max_code_bits);
+
+/*********************************************************************************
+ * @brief   :  	Computes the average code length over the training data
+ *
+ * @param   :   none
+ *
+ * @return  : 	double - average number of bits per character
+**********************************************************************************/
+double average_code_bits(void);
+
+/*********************************************************************************
+ * @brief   :  	Assigns canonical huffman codes from the code lengths
+ *
+ * @param   :   none
+ *
+ * @return  : 	void
+**********************************************************************************/
+void assign_canonical_codes(void);
+
 /*********************************************************************************
  * @brief   :  	Creates the lookup table with characters and their frequencies
  * 				in the string
@@ -199,24 +276,159 @@ void traverse_huffman_tree(struct HuffmanTreeNode* root, int arr[], int top);
 int create_lookup_table(void);
 
 /*********************************************************************************
- * @brief   :  	Generates the header file for KL25Z which consists of the 
- * 				lookup table
+ * @brief   :  	Builds the huffman tree of the frequencies in the table and
+ * 				sets the code length of every character to its depth
  *
  * @param   :   none
  *
  * @return  : 	void
 **********************************************************************************/
-void generate_header_file(void);
+void build_code_lengths(void);
+
+/*********************************************************************************
+ * @brief   :  	Computes the bits a symbol takes with a table
+ *
+ * @param   :   symbol		- character or token
+ * 				code_bits	- code length of every symbol of the table
+ *
+ * @return  : 	int - number of bits
+**********************************************************************************/
+int symbol_cost(int symbol, const int code_bits[]);
+
+/*********************************************************************************
+ * @brief   :  	Computes the bits the symbols after one character take
+ * 				with a table, the tokens included
+ *
+ * @param   :   context		- previous character
+ * 				code_bits	- code length of every symbol of the table
+ *
+ * @return  : 	long - number of bits
+**********************************************************************************/
+long context_cost(int context, const int code_bits[]);
+
+/*********************************************************************************
+ * @brief   :  	Computes the length limited code lengths of some frequencies
+ *
+ * @param   :   frequency		- frequency of every symbol
+ * 				max_code_bits	- longest code allowed, 0 for no limit
+ * 				code_bits		- filled with the code length of every symbol
+ *
+ * @return  : 	void
+**********************************************************************************/
+void frequency_code_lengths(const int frequency[], int max_code_bits, int code_bits[]);
 
 /*********************************************************************************
- * @brief   :  	Generates the huffman tree
+ * @brief   :  	Maps every previous character to the table which codes the
+ * 				characters after it in the fewest bits
+ *
+ * @param   :   tables - number of tables to choose from
+ *
+ * @return  : 	int - number of characters which moved to another table
+**********************************************************************************/
+int assign_contexts(int tables);
+
+/*********************************************************************************
+ * @brief   :  	Generates the tables of the order-1 coder
+ *
+ * @param   :   first			- ID of the first new table
+ * 				clusters		- number of new tables
+ * 				max_code_bits	- longest code allowed, 0 for no limit
+ *
+ * @return  : 	void
+**********************************************************************************/
+void generate_context_tables(int first, int clusters, int max_code_bits);
+
+/*********************************************************************************
+ * @brief   :  	Scales the frequencies of a table so they add up to a total
+ *
+ * @param   :   frequency	- frequency of every symbol
+ * 				total		- sum of the scaled frequencies
+ * 				norm		- filled with the scaled frequency of every symbol
+ *
+ * @return  : 	void
+**********************************************************************************/
+void normalize_frequencies(const int frequency[], int total, int norm[]);
+
+/*********************************************************************************
+ * @brief   :  	Builds the tANS tables of every table from its frequencies
+ *
+ * @param   :   tables - number of tables
+ *
+ * @return  : 	void
+**********************************************************************************/
+void generate_ans_tables(int tables);
+
+/*********************************************************************************
+ * @brief   :  	Builds the cumulative frequencies of the range coder of every
+ * 				table and reports how close each coder gets to the entropy
+ *
+ * @param   :   tables - number of tables
+ *
+ * @return  : 	void
+**********************************************************************************/
+void generate_range_tables(int tables);
+
+/*********************************************************************************
+ * @brief   :  	Reads a training file with every line ended by "\n\r"
+ *
+ * @param   :   file_name	- training file
+ * 				length		- set to the number of characters read
+ *
+ * @return  : 	unsigned char * - the characters, to be freed, NULL if the
+ * 								  file can't be read
+**********************************************************************************/
+unsigned char *read_training_file(const char *file_name, long *length);
+
+/*********************************************************************************
+ * @brief   :  	Finds the longest token at the start of some text
+ *
+ * @param   :   text	- text
+ * 				length	- number of characters in text
+ * 				matched	- set to the number of characters of the symbol
+ *
+ * @return  : 	int - symbol of the token, or of the first character if no
+ * 					  token matches
+**********************************************************************************/
+int match_token(const unsigned char *text, long length, int *matched);
+
+/*********************************************************************************
+ * @brief   :  	Chooses the tokens of the training files
+ *
+ * @param   :   texts	- characters of every training file
+ * 				lengths	- number of characters of every training file
+ * 				files	- number of training files
+ * 				count	- number of tokens to choose, at most MAX_TOKENS
+ *
+ * @return  : 	int - number of tokens chosen
+**********************************************************************************/
+int choose_tokens(unsigned char *texts[], const long lengths[], int files, int count);
+
+/*********************************************************************************
+ * @brief   :  	Generates the header file for KL25Z which consists of the 
+ * 				lookup tables
+ *
+ * @param   :   file_names	- training file of every table
+ * 				files		- number of training files
+ * 				clusters	- number of order-1 tables after the ones of the files
+ *
+ * @return  : 	void
+**********************************************************************************/
+void generate_header_file(char *file_names[], int files, int clusters);
+
+/*********************************************************************************
+ * @brief   :  	Generates the huffman tree of one training file
  * 				Parent of all functions
  * 				Tree generation begins here
  *
- * @param   :   none
+ * @param   :   file_name		- training file, for the report
+ * 				text			- characters of the training file
+ * 				length			- number of characters in text
+ * 				max_code_bits	- longest code allowed, 0 for no limit
+ * 				byte_frequency	- filled with the frequency of every byte
  *
  * @return  : 	void
 **********************************************************************************/
-void generate_huffman_tree(void);
+void generate_huffman_tree(const char *file_name, const unsigned char *text, long length,
+							int max_code_bits, int byte_frequency[]);
 
 
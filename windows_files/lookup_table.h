@@ -3,141 +3,1001 @@
 
 #include <stdint.h>
 
-typedef struct {
-unsigned char character;
-uint32_t code;
-int code_bits;
-int frequency;
-} huffman_code_t;
-
-huffman_code_t huffman_codes[] = {
-{0, 0x00, 0},
-{1, 0x00, 0},
-{2, 0x00, 0},
-{3, 0x00, 0},
-{4, 0x00, 0},
-{5, 0x00, 0},
-{6, 0x00, 0},
-{7, 0x00, 0},
-{8, 0x00, 0},
-{9, 0x10, 5},
-{10, 0x79, 7},
-{11, 0x00, 0},
-{12, 0x00, 0},
-{13, 0x78, 7},
-{14, 0x00, 0},
-{15, 0x00, 0},
-{16, 0x00, 0},
-{17, 0x00, 0},
-{18, 0x00, 0},
-{19, 0x00, 0},
-{20, 0x00, 0},
-{21, 0x00, 0},
-{22, 0x00, 0},
-{23, 0x00, 0},
-{24, 0x00, 0},
-{25, 0x00, 0},
-{26, 0x00, 0},
-{27, 0x00, 0},
-{28, 0x00, 0},
-{29, 0x00, 0},
-{30, 0x00, 0},
-{31, 0x00, 0},
-{32, 0x07, 4},
-{33, 0x00, 0},
-{34, 0x00, 0},
-{35, 0x00, 0},
-{36, 0x00, 0},
-{37, 0x00, 0},
-{38, 0x00, 0},
-{39, 0x00, 0},
-{40, 0x0d, 12},
-{41, 0x0e, 12},
-{42, 0x00, 0},
-{43, 0x0f, 12},
-{44, 0x00, 0},
-{45, 0x3f, 6},
-{46, 0x37, 6},
-{47, 0xc5, 8},
-{48, 0x0a, 4},
-{49, 0x07, 5},
-{50, 0x02, 5},
-{51, 0x3e, 6},
-{52, 0x181, 10},
-{53, 0x01, 6},
-{54, 0x00, 9},
-{55, 0x05, 11},
-{56, 0x0b, 6},
-{57, 0x32e, 10},
-{58, 0x01, 5},
-{59, 0x92, 9},
-{60, 0x00, 0},
-{61, 0x23, 6},
-{62, 0x00, 0},
-{63, 0x00, 0},
-{64, 0x3a2, 10},
-{65, 0x25, 7},
-{66, 0x0a, 6},
-{67, 0xc7, 8},
-{68, 0x39, 6},
-{69, 0x30, 6},
-{70, 0x319, 10},
-{71, 0x13, 6},
-{72, 0x3a3, 10},
-{73, 0x48, 8},
-{74, 0x603, 12},
-{75, 0x04, 11},
-{76, 0x1d0, 9},
-{77, 0x01, 7},
-{78, 0x93, 9},
-{79, 0x18d, 9},
-{80, 0xea, 8},
-{81, 0x300, 11},
-{82, 0xe1, 8},
-{83, 0x62, 8},
-{84, 0xe0, 8},
-{85, 0x36, 6},
-{86, 0xc1, 9},
-{87, 0x32f, 10},
-{88, 0x196, 9},
-{89, 0x00, 0},
-{90, 0x00, 0},
-{91, 0x77, 7},
-{92, 0x00, 0},
-{93, 0x76, 7},
-{94, 0x00, 0},
-{95, 0x63, 8},
-{96, 0x00, 0},
-{97, 0x0a, 5},
-{98, 0xeb, 8},
-{99, 0x04, 5},
-{100, 0x19, 6},
-{101, 0x09, 4},
-{102, 0xca, 8},
-{103, 0xc4, 8},
-{104, 0x71, 7},
-{105, 0x0b, 4},
-{106, 0x602, 12},
-{107, 0x01, 8},
-{108, 0x0b, 5},
-{109, 0x33, 6},
-{110, 0x08, 5},
-{111, 0x1a, 5},
-{112, 0x3d, 6},
-{113, 0x00, 0},
-{114, 0x06, 5},
-{115, 0x0d, 5},
-{116, 0x03, 5},
-{117, 0x64, 7},
-{118, 0x22, 6},
-{119, 0x318, 10},
-{120, 0x61, 8},
-{121, 0xe9, 8},
-{122, 0x00, 0},
-{123, 0x00, 0},
-{124, 0x0c, 12},
-{125, 0x00, 0},
-{126, 0x00, 0},
-{127, 0x00, 0} };
+/* Number of symbols in the huffman table, every byte, the escape and the tokens */
+#define HUFFMAN_NUM_SYMBOLS (273)
+
+/* Symbol sent before the 8 bits of a byte which has no code */
+#define HUFFMAN_ESCAPE_SYMBOL (256)
+
+/* Length of the longest code in the tables */
+#define HUFFMAN_MAX_CODE_LENGTH (9)
+
+/* Number of tables, one for every training file, then the ones of the order-1 coder */
+#define HUFFMAN_NUM_TABLES (4)
+#define HUFFMAN_NUM_CONTEXT_TABLES (2)
+
+/* Previous character the order-1 coder starts every message with */
+#define HUFFMAN_CONTEXT_START (13)
+
+/* Hash of the code lengths of the tables */
+#define HUFFMAN_TABLES_HASH (0xF841BF93UL)
+
+/* ID of every table */
+#define HUFFMAN_TABLE_HELLO (0)
+#define HUFFMAN_TABLE_COMMANDS (1)
+#define HUFFMAN_TABLE_CONTEXT_0 (2)
+#define HUFFMAN_TABLE_CONTEXT_1 (3)
+
+/* Canonical code length of every symbol, 0 for bytes which are sent escaped */
+static const uint8_t huffman_code_lengths[HUFFMAN_NUM_TABLES][HUFFMAN_NUM_SYMBOLS] = {
+/* hello.txt */
+{
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  6,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 4,  0,  0,  0,  0,  0,  0,  0,  9,  9,  0,  9,  0,  5,  5,  8,
+ 6,  7,  9,  9,  9,  9,  9,  9,  8,  9,  9,  9,  0,  6,  0,  0,
+ 9,  7,  6,  8,  8,  6,  9,  6,  9,  8,  9,  9,  8,  7,  9,  9,
+ 7,  9,  7,  8,  8,  6,  9,  9,  9,  0,  0,  6,  0,  6,  0,  8,
+ 0,  5,  7,  6,  6,  4,  8,  8,  6,  5,  9,  8,  5,  7,  6,  5,
+ 5,  0,  6,  5,  6,  7,  9,  9,  8,  7,  0,  0,  9,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 9,  6,  9,  5,  6,  6,  6,  6,  6,  7,  9,  6,  0,  6,  6,  6,
+ 6,
+},
+/* commands.txt */
+{
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  6,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  9,  0,  9,  9,
+ 9,  0,  8,  8,  7,  7,  8,  8,  7,  8,  9,  0,  9,  6,  9,  0,
+ 0,  9,  8,  0,  0,  8,  9,  0,  0,  9,  0,  9,  0,  9,  0,  8,
+ 7,  0,  7,  7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  4,  6,  5,  5,  4,  6,  6,  5,  5,  9,  0,  6,  5,  5,  5,
+ 6,  0,  5,  4,  4,  6,  8,  0,  9,  6,  0,  0,  9,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 9,  4,  0,  9,  6,  8,  0,  6,  0,  7,  9,  0,  9,  0,  0,  9,
+ 0,
+},
+/* Order-1 table 0 */
+{
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  8,  4,  8,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  6,  9,  5,  3,  0,  0,  5,  0,  0,  0,  9,  3,  5,  4,  9,
+ 0,  0,  0,  3,  5,  4,  7,  0,  8,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 8,  7,  0,  0,  0,  3,  0,  0,  0,  3,  0,  0,  0,  0,  0,  0,
+ 0,
+},
+/* Order-1 table 1 */
+{
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  9,
+ 0,  0,  6,  8,  6,  7,  7,  8,  8,  9,  0,  8,  8,  3,  0,  0,
+ 0,  7,  6,  7,  0,  8,  7,  7,  0,  8,  0,  7,  8,  7,  9,  0,
+ 6,  8,  5,  8,  8,  0,  8,  0,  7,  0,  0,  0,  0,  3,  0,  0,
+ 0,  4,  5,  4,  7,  6,  5,  0,  6,  5,  9,  0,  0,  5,  9,  6,
+ 4,  0,  5,  5,  4,  9,  0,  8,  0,  0,  0,  0,  9,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+ 9,  0,  9,  0,  0,  8,  0,  8,  0,  0,  0,  7,  0,  9,  0,  0,
+ 0,
+},
+};
+
+/* Canonical code of every symbol, rebuilt from the code lengths */
+static const uint16_t huffman_codes[HUFFMAN_NUM_TABLES][HUFFMAN_NUM_SYMBOLS] = {
+{
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x01A, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x1E2, 0x1E3, 0x000, 0x1E4, 0x000, 0x004, 0x005, 0x0E4,
+0x01B, 0x068, 0x1E5, 0x1E6, 0x1E7, 0x1E8, 0x1E9, 0x1EA, 0x0E5, 0x1EB, 0x1EC, 0x1ED, 0x000, 0x01C, 0x000, 0x000,
+0x1EE, 0x069, 0x01D, 0x0E6, 0x0E7, 0x01E, 0x1EF, 0x01F, 0x1F0, 0x0E8, 0x1F1, 0x1F2, 0x0E9, 0x06A, 0x1F3, 0x1F4,
+0x06B, 0x1F5, 0x06C, 0x0EA, 0x0EB, 0x020, 0x1F6, 0x1F7, 0x1F8, 0x000, 0x000, 0x021, 0x000, 0x022, 0x000, 0x0EC,
+0x000, 0x006, 0x06D, 0x023, 0x024, 0x001, 0x0ED, 0x0EE, 0x025, 0x007, 0x1F9, 0x0EF, 0x008, 0x06E, 0x026, 0x009,
+0x00A, 0x000, 0x027, 0x00B, 0x028, 0x06F, 0x1FA, 0x1FB, 0x0F0, 0x070, 0x000, 0x000, 0x1FC, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x1FD, 0x029, 0x1FE, 0x00C, 0x02A, 0x02B, 0x02C, 0x02D, 0x02E, 0x071, 0x1FF, 0x02F, 0x000, 0x030, 0x031, 0x032,
+0x033,
+},
+{
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x02C, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x1EC, 0x000, 0x1ED, 0x1EE,
+0x1EF, 0x000, 0x0EC, 0x0ED, 0x06E, 0x06F, 0x0EE, 0x0EF, 0x070, 0x0F0, 0x1F0, 0x000, 0x1F1, 0x02D, 0x1F2, 0x000,
+0x000, 0x1F3, 0x0F1, 0x000, 0x000, 0x0F2, 0x1F4, 0x000, 0x000, 0x1F5, 0x000, 0x1F6, 0x000, 0x1F7, 0x000, 0x0F3,
+0x071, 0x000, 0x072, 0x073, 0x074, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x002, 0x02E, 0x00E, 0x00F, 0x003, 0x02F, 0x030, 0x010, 0x011, 0x1F8, 0x000, 0x031, 0x012, 0x013, 0x014,
+0x032, 0x000, 0x015, 0x004, 0x005, 0x033, 0x0F4, 0x000, 0x1F9, 0x034, 0x000, 0x000, 0x1FA, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x1FB, 0x006, 0x000, 0x1FC, 0x035, 0x0F5, 0x000, 0x036, 0x000, 0x075, 0x1FD, 0x000, 0x1FE, 0x000, 0x000, 0x1FF,
+0x000,
+},
+{
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x0F8, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x0F9, 0x00A, 0x0FA,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x1FC, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x0FB, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x03C, 0x1FD, 0x01A, 0x000, 0x000, 0x000, 0x01B, 0x000, 0x000, 0x000, 0x1FE, 0x001, 0x01C, 0x00B, 0x1FF,
+0x000, 0x000, 0x000, 0x002, 0x01D, 0x00C, 0x07A, 0x000, 0x0FC, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x0FD, 0x07B, 0x000, 0x000, 0x000, 0x003, 0x000, 0x000, 0x000, 0x004, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000,
+},
+{
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x06A, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x1F6,
+0x000, 0x000, 0x02E, 0x0EC, 0x02F, 0x06B, 0x06C, 0x0ED, 0x0EE, 0x1F7, 0x000, 0x0EF, 0x0F0, 0x000, 0x000, 0x000,
+0x000, 0x06D, 0x030, 0x06E, 0x000, 0x0F1, 0x06F, 0x070, 0x000, 0x0F2, 0x000, 0x071, 0x0F3, 0x072, 0x1F8, 0x000,
+0x031, 0x0F4, 0x010, 0x0F5, 0x0F6, 0x000, 0x0F7, 0x000, 0x073, 0x000, 0x000, 0x000, 0x000, 0x001, 0x000, 0x000,
+0x000, 0x004, 0x011, 0x005, 0x074, 0x032, 0x012, 0x000, 0x033, 0x013, 0x1F9, 0x000, 0x000, 0x014, 0x1FA, 0x034,
+0x006, 0x000, 0x015, 0x016, 0x007, 0x1FB, 0x000, 0x0F8, 0x000, 0x000, 0x000, 0x000, 0x1FC, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+0x1FD, 0x000, 0x1FE, 0x000, 0x000, 0x0F9, 0x000, 0x0FA, 0x000, 0x000, 0x000, 0x075, 0x000, 0x1FF, 0x000, 0x000,
+0x000,
+},
+};
+
+/* Tokens, strings of characters coded as one symbol, the first one after the escape */
+#define HUFFMAN_FIRST_TOKEN (257)
+#define HUFFMAN_NUM_TOKENS (16)
+#define HUFFMAN_LONGEST_TOKEN (4)
+
+/* Characters of every token start at its offset in huffman_token_text, then the end */
+static const uint8_t huffman_token_offsets[HUFFMAN_NUM_TOKENS + 1] = { 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 25, 29, 33, 35, 37 };
+
+static const char huffman_token_text[] = "\012\0152003eron\011Dtivice 1mi 102020 10:18:5";
+
+/* Node of the first character of the tokens which start with every character, 0 for none */
+static const uint8_t huffman_token_start[256] = {
+  0,   0,   0,   0,   0,   0,   0,   0,   0,  11,   1,   0,   0,   0,   0,   0,
+  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+ 19,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+  5,  27,   3,   0,   0,   0,   0,   0,   0,   0,  29,   0,   0,   0,   0,   0,
+  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+  0,   0,   0,  17,   0,   7,   0,   0,   0,   0,   0,   0,   0,  21,   0,   9,
+  0,   0,   0,   0,  13,   0,  15,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+};
+
+/* Trie of the tokens, node 0 is the root */
+#define HUFFMAN_TOKEN_NODES (31)
+
+/* Every node is { character, first child, next sibling, token + 1 }, 0 for none */
+static const uint8_t huffman_token_trie[HUFFMAN_TOKEN_NODES][4] = {
+{   0,  29,   0,  0 }, {  10,   2,   0,  0 }, {  13,   0,   0,  1 }, {  50,   4,   1,  0 },
+{  48,  24,   0,  2 }, {  48,   6,   3,  0 }, {  51,   0,   0,  3 }, { 101,   8,   5,  0 },
+{ 114,   0,   0,  4 }, { 111,  10,   7,  0 }, { 110,   0,   0,  5 }, {   9,  12,   9,  0 },
+{  68,   0,   0,  6 }, { 116,  14,  11,  0 }, { 105,   0,   0,  7 }, { 118,  16,  13,  0 },
+{ 105,   0,   0,  8 }, {  99,  18,  15,  0 }, { 101,   0,   0,  9 }, {  32,  20,  17,  0 },
+{  49,  23,   0, 10 }, { 109,  22,  19,  0 }, { 105,   0,   0, 11 }, {  48,  26,   0, 12 },
+{  50,  25,   0,  0 }, {  48,   0,   0, 13 }, {  58,   0,   0, 14 }, {  49,  28,  21,  0 },
+{  56,   0,   0, 15 }, {  58,  30,  27,  0 }, {  53,   0,   0, 16 },
+};
+
+/* Table of the order-1 coder after every character */
+static const uint8_t huffman_context_map[256] = {
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+3, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0, 0,
+0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 1, 1, 0,
+2, 0, 0, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 0, 3,
+0, 3, 0, 0, 0, 0, 0, 3, 1, 0, 0, 1, 0, 1, 0, 0,
+0, 1, 0, 1, 1, 0, 1, 1, 0, 2, 1, 0, 1, 0, 0, 1,
+0, 0, 0, 1, 1, 1, 0, 1, 1, 1, 0, 0, 1, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+/* The tANS coder has 2^HUFFMAN_ANS_TABLE_LOG states for every table */
+#define HUFFMAN_ANS_TABLE_LOG (9)
+#define HUFFMAN_ANS_STATES (512)
+
+/* tANS decoding of every state: next state in bits 0-11, bits to add to it in bits 12-15, symbol from bit 16 */
+static const uint32_t huffman_ans_decode_table[HUFFMAN_NUM_TABLES][HUFFMAN_ANS_STATES] = {
+{
+0x095000, 0x694010, 0x456000, 0x2D60C0, 0x6F5040, 0x616180, 0x326100, 0x757000,
+0x678000, 0x427100, 0x2051E0, 0x6D6040, 0x589000, 0x304000, 0x7361C0, 0x654000,
+0x3A60C0, 0x204000, 0x6C61C0, 0x528100, 0x304010, 0x726140, 0x646000, 0x357100,
+0x095020, 0x694020, 0x477180, 0x2E6080, 0x6F5060, 0x628100, 0x326140, 0x766000,
+0x694030, 0x446080, 0x204010, 0x6E6140, 0x5D7080, 0x316140, 0x746100, 0x654010,
+0x3D6000, 0x204020, 0x6C5000, 0x556080, 0x304020, 0x726180, 0x654020, 0x387100,
+0x0A7080, 0x694040, 0x4B9000, 0x2F8000, 0x7060C0, 0x636100, 0x3360C0, 0x798100,
+0x694050, 0x456040, 0x2D6100, 0x6F5080, 0x6161C0, 0x316180, 0x746140, 0x654030,
+0x427180, 0x204030, 0x6D6080, 0x5560C0, 0x304030, 0x735000, 0x654040, 0x3A6100,
+0x0D7080, 0x6C5020, 0x508100, 0x304040, 0x7261C0, 0x646040, 0x357180, 0x095040,
+0x694060, 0x476000, 0x2D6140, 0x6F50A0, 0x615000, 0x326180, 0x766040, 0x687080,
+0x4460C0, 0x204040, 0x6E6180, 0x5B7080, 0x3161C0, 0x735020, 0x654050, 0x3D6040,
+0x204050, 0x6C5040, 0x548000, 0x304050, 0x725000, 0x654060, 0x387180, 0x095060,
+0x694070, 0x498000, 0x2E60C0, 0x706100, 0x636140, 0x336100, 0x788000, 0x694080,
+0x446100, 0x2B9000, 0x6E61C0, 0x615020, 0x315000, 0x746180, 0x654070, 0x417000,
+0x204060, 0x6D60C0, 0x556100, 0x304060, 0x735040, 0x654080, 0x3A6140, 0x0D7100,
+0x6A9000, 0x4E9000, 0x304070, 0x706140, 0x636180, 0x349000, 0x095080, 0x694090,
+0x456080, 0x2D6180, 0x6F50C0, 0x615040, 0x3261C0, 0x757080, 0x687100, 0x426000,
+0x204070, 0x6E5000, 0x5B7100, 0x304080, 0x735060, 0x654090, 0x3B9000, 0x204080,
+0x6C5060, 0x527000, 0x304090, 0x725020, 0x646080, 0x379000, 0x0950A0, 0x6940A0,
+0x476040, 0x2E6100, 0x6F50E0, 0x627000, 0x336140, 0x766080, 0x6940B0, 0x446140,
+0x204090, 0x6E5020, 0x5D7100, 0x315020, 0x7461C0, 0x6540A0, 0x3D6080, 0x2040A0,
+0x6C5080, 0x556140, 0x3040A0, 0x735080, 0x6540B0, 0x3A6180, 0x0A7100, 0x6940C0,
+0x4D8100, 0x3040B0, 0x706180, 0x6361C0, 0x336180, 0x1009000, 0x6940D0, 0x4560C0,
+0x2D61C0, 0x6F5100, 0x615060, 0x325000, 0x757100, 0x668000, 0x426040, 0x2040B0,
+0x6D6100, 0x579000, 0x3040C0, 0x7350A0, 0x6540C0, 0x3A61C0, 0x2040C0, 0x6C50A0,
+0x519000, 0x3040D0, 0x725040, 0x6460C0, 0x356000, 0x0950C0, 0x6940E0, 0x476080,
+0x2E6140, 0x6F5120, 0x615080, 0x325020, 0x7660C0, 0x6940F0, 0x446180, 0x2040D0,
+0x6E5040, 0x5D7180, 0x315040, 0x745000, 0x6540D0, 0x3D60C0, 0x2040E0, 0x6C50C0,
+0x556180, 0x3040E0, 0x725060, 0x6540E0, 0x386000, 0x0950E0, 0x694100, 0x4A9000,
+0x2E6180, 0x7061C0, 0x635000, 0x3361C0, 0x797000, 0x694110, 0x456100, 0x2D5000,
+0x6F5140, 0x6150A0, 0x315060, 0x745020, 0x6540F0, 0x417080, 0x2040F0, 0x6D6140,
+0x5561C0, 0x3040F0, 0x7350C0, 0x654100, 0x3A5000, 0x0D7180, 0x6C50E0, 0x507000,
+0x304100, 0x705000, 0x646100, 0x356040, 0x095100, 0x694120, 0x469000, 0x2D5020,
+0x6F5160, 0x6150C0, 0x325040, 0x766100, 0x687180, 0x438000, 0x204100, 0x6E5060,
+0x5B7180, 0x315080, 0x7350E0, 0x654110, 0x3D6100, 0x204110, 0x6C5100, 0x538000,
+0x304110, 0x725080, 0x654120, 0x386040, 0x095120, 0x694130, 0x489000, 0x2E61C0,
+0x6F5180, 0x635020, 0x335000, 0x788100, 0x694140, 0x4461C0, 0x299000, 0x6E5080,
+0x5F8000, 0x3150A0, 0x745040, 0x654130, 0x417100, 0x204120, 0x6D6180, 0x555000,
+0x304120, 0x735100, 0x654140, 0x3A5020, 0x0A7180, 0x694150, 0x4D7000, 0x304130,
+0x705020, 0x635040, 0x335020, 0x095140, 0x694160, 0x456140, 0x2D5040, 0x6F51A0,
+0x6150E0, 0x325060, 0x757180, 0x678100, 0x426080, 0x204130, 0x6E50A0, 0x5B6000,
+0x304140, 0x735120, 0x654150, 0x3A5040, 0x204140, 0x6C5120, 0x527080, 0x304150,
+0x7250A0, 0x646140, 0x369000, 0x095160, 0x694170, 0x4760C0, 0x2E5000, 0x6F51C0,
+0x627080, 0x325080, 0x766140, 0x694180, 0x445000, 0x204150, 0x6E50C0, 0x5D6000,
+0x3150C0, 0x745060, 0x654160, 0x3D6140, 0x204160, 0x6C5140, 0x555020, 0x304160,
+0x7250C0, 0x654170, 0x399000, 0x0A6000, 0x694190, 0x4C9000, 0x2F8100, 0x705040,
+0x635060, 0x335040, 0x7C9000, 0x6941A0, 0x456180, 0x2D5060, 0x6F51E0, 0x615100,
+0x3250A0, 0x745080, 0x668100, 0x4260C0, 0x204170, 0x6D61C0, 0x569000, 0x304170,
+0x735140, 0x654180, 0x3A5060, 0x0D6000, 0x6C5160, 0x507080, 0x304180, 0x7250E0,
+0x646180, 0x356080, 0x095180, 0x6941B0, 0x476100, 0x2E5020, 0x6F4000, 0x615120,
+0x3250C0, 0x766180, 0x686000, 0x445020, 0x204180, 0x6E50E0, 0x5D6040, 0x3150E0,
+0x7450A0, 0x654190, 0x3D6180, 0x204190, 0x6C5180, 0x548100, 0x304190, 0x725100,
+0x6541A0, 0x386080, 0x0951A0, 0x6941C0, 0x498100, 0x2E5040, 0x705060, 0x635080,
+0x335060, 0x797080, 0x6941D0, 0x445040, 0x2D5080, 0x6F4010, 0x615140, 0x315100,
+0x7450C0, 0x6541B0, 0x417180, 0x2041A0, 0x6D5000, 0x555040, 0x3041A0, 0x735160,
+0x6541C0, 0x3A5080, 0x0D6040, 0x6B9000, 0x4F9000, 0x3041B0, 0x705080, 0x6350A0,
+0x3560C0, 0x0951C0, 0x6941E0, 0x4561C0, 0x2D50A0, 0x6F4020, 0x615160, 0x3250E0,
+0x7661C0, 0x686040, 0x438100, 0x2041B0, 0x6E5100, 0x5B6040, 0x3041C0, 0x735180,
+0x6541D0, 0x3D61C0, 0x2041C0, 0x6C51A0, 0x538100, 0x3041D0, 0x725120, 0x6461C0,
+0x3860C0, 0x0951E0, 0x6941F0, 0x476140, 0x2E5060, 0x6F4030, 0x6350C0, 0x335080,
+0x779000, 0x693000, 0x445060, 0x289000, 0x6E5120, 0x5F8100, 0x315120, 0x7450E0,
+0x6541E0, 0x409000, 0x2041D0, 0x6D5020, 0x555060, 0x3041E0, 0x7351A0, 0x6541F0,
+0x3A50A0, 0x0A6040, 0x693008, 0x4D7080, 0x3041F0, 0x7050A0, 0x6350E0, 0x3350A0,
+},
+{
+0x096000, 0x6E50C0, 0x635040, 0x2041D0, 0x7350E0, 0x654130, 0x338000, 0x756000,
+0x6C6040, 0x6150E0, 0x0D5140, 0x7250A0, 0x654140, 0x2041E0, 0x744070, 0x695080,
+0x527080, 0x0A5140, 0x6F5000, 0x645000, 0x2041F0, 0x744080, 0x677080, 0x428000,
+0x0A5160, 0x6E50E0, 0x635060, 0x203000, 0x735100, 0x654150, 0x368100, 0x796040,
+0x6D60C0, 0x615100, 0x0D5160, 0x7250C0, 0x654160, 0x203008, 0x744090, 0x6950A0,
+0x615120, 0x0D5180, 0x6F5020, 0x654170, 0x203010, 0x7440A0, 0x6861C0, 0x4F8000,
+0x0A5180, 0x6E5100, 0x645020, 0x203018, 0x735120, 0x654180, 0x3A9000, 0x796080,
+0x6D6100, 0x627100, 0x203020, 0x7250E0, 0x654190, 0x318000, 0x756040, 0x6950C0,
+0x615140, 0x0D51A0, 0x707100, 0x6541A0, 0x203028, 0x7440B0, 0x6950E0, 0x527100,
+0x0A51A0, 0x6F5040, 0x645040, 0x203030, 0x7440C0, 0x677100, 0x3D7180, 0x096040,
+0x6E5120, 0x635080, 0x203038, 0x735140, 0x6541B0, 0x358100, 0x768000, 0x6C6080,
+0x615160, 0x0D51C0, 0x725100, 0x6541C0, 0x203040, 0x7440D0, 0x695100, 0x548100,
+0x0A51C0, 0x6F5060, 0x6541D0, 0x203048, 0x7440E0, 0x685000, 0x499000, 0x0A51E0,
+0x6E5140, 0x6350A0, 0x203050, 0x735160, 0x6541E0, 0x388100, 0x7960C0, 0x6D6140,
+0x627180, 0x0D51E0, 0x725120, 0x6541F0, 0x308000, 0x7440F0, 0x695120, 0x615180,
+0x0D4000, 0x707180, 0x653000, 0x203058, 0x744100, 0x685020, 0x507080, 0x0A4000,
+0x6E5160, 0x645060, 0x203060, 0x735180, 0x667080, 0x3D6000, 0x096080, 0x6E5180,
+0x6350C0, 0x203068, 0x7351A0, 0x653008, 0x348100, 0x756080, 0x6C60C0, 0x6151A0,
+0x0D4010, 0x725140, 0x653010, 0x203070, 0x744110, 0x695140, 0x538100, 0x0A4010,
+0x6F5080, 0x645080, 0x203078, 0x744120, 0x685040, 0x458000, 0x0A4020, 0x6E51A0,
+0x6350E0, 0x203080, 0x7351C0, 0x653018, 0x378000, 0x796100, 0x6D6180, 0x6151C0,
+0x0D4020, 0x725160, 0x653020, 0x2C9000, 0x744130, 0x695160, 0x6151E0, 0x0D4030,
+0x6F50A0, 0x653028, 0x203088, 0x744140, 0x685060, 0x507100, 0x0A4030, 0x6E51C0,
+0x6450A0, 0x203090, 0x7351E0, 0x667100, 0x3D6040, 0x1009000, 0x6D61C0, 0x635100,
+0x203098, 0x725180, 0x653030, 0x338100, 0x7560C0, 0x6C6100, 0x614000, 0x0D4040,
+0x7251A0, 0x653038, 0x2030A0, 0x744150, 0x695180, 0x527180, 0x0A4040, 0x6F50C0,
+0x6450C0, 0x2030A8, 0x744160, 0x677180, 0x419000, 0x0960C0, 0x6E51E0, 0x635120,
+0x2030B0, 0x734000, 0x653040, 0x367000, 0x789000, 0x6C6140, 0x614010, 0x0D4050,
+0x7251C0, 0x653048, 0x2030B8, 0x744170, 0x6951A0, 0x614020, 0x0D4060, 0x6F50E0,
+0x653050, 0x2030C0, 0x744180, 0x685080, 0x4D9000, 0x0A4050, 0x6E4000, 0x635140,
+0x2030C8, 0x734010, 0x653058, 0x399000, 0x796140, 0x6D5000, 0x626000, 0x2030D0,
+0x7251E0, 0x653060, 0x318100, 0x744190, 0x6951C0, 0x614030, 0x0D4070, 0x706000,
+0x653068, 0x2030D8, 0x7441A0, 0x6850A0, 0x526000, 0x0A4060, 0x6F5100, 0x6450E0,
+0x2030E0, 0x7441B0, 0x676000, 0x3D6080, 0x096100, 0x6E4010, 0x635160, 0x2030E8,
+0x734020, 0x653070, 0x357000, 0x756100, 0x6C6180, 0x614040, 0x0D4080, 0x724000,
+0x653078, 0x2030F0, 0x7441C0, 0x6951E0, 0x547000, 0x0A4070, 0x6F5120, 0x645100,
+0x2030F8, 0x7441D0, 0x6850C0, 0x469000, 0x0A4080, 0x6E4020, 0x635180, 0x203100,
+0x734030, 0x653080, 0x387000, 0x796180, 0x6D5020, 0x626040, 0x0D4090, 0x724010,
+0x653088, 0x2F9000, 0x7441E0, 0x694000, 0x614050, 0x0D40A0, 0x706040, 0x653090,
+0x203108, 0x7441F0, 0x6850E0, 0x507180, 0x0A4090, 0x6E4030, 0x645120, 0x203110,
+0x734040, 0x667180, 0x3D60C0, 0x096140, 0x6E4040, 0x6351A0, 0x203118, 0x734050,
+0x653098, 0x347000, 0x756140, 0x6C61C0, 0x614060, 0x0D40B0, 0x724020, 0x6530A0,
+0x203120, 0x743000, 0x694010, 0x537000, 0x0A40A0, 0x6F5140, 0x645140, 0x203128,
+0x743008, 0x685100, 0x428100, 0x0A40B0, 0x6E4050, 0x6351C0, 0x203130, 0x734060,
+0x6530A8, 0x367080, 0x7961C0, 0x6D5040, 0x614070, 0x0D40C0, 0x724030, 0x6530B0,
+0x203138, 0x743010, 0x694020, 0x614080, 0x0D40D0, 0x6F5160, 0x6530B8, 0x203140,
+0x743018, 0x685120, 0x4F8100, 0x0A40C0, 0x6E4060, 0x645160, 0x203148, 0x734070,
+0x6530C0, 0x3C9000, 0x7C9000, 0x6D5060, 0x6351E0, 0x203150, 0x724040, 0x6530C8,
+0x329000, 0x756180, 0x6A9000, 0x614090, 0x0D40E0, 0x724050, 0x6530D0, 0x203158,
+0x743020, 0x694030, 0x526040, 0x0A40D0, 0x6F5180, 0x645180, 0x203160, 0x743028,
+0x676040, 0x3E9000, 0x096180, 0x6E4070, 0x634000, 0x203168, 0x734080, 0x6530D8,
+0x357080, 0x768100, 0x6C5000, 0x6140A0, 0x0D40F0, 0x724060, 0x6530E0, 0x203170,
+0x743030, 0x694040, 0x547080, 0x0A40E0, 0x6F51A0, 0x6530E8, 0x203178, 0x743038,
+0x685140, 0x4B9000, 0x0A40F0, 0x6E4080, 0x634010, 0x203180, 0x734090, 0x6530F0,
+0x387080, 0x795000, 0x6D5080, 0x626080, 0x203188, 0x724070, 0x6530F8, 0x308100,
+0x743040, 0x694050, 0x6140B0, 0x0D4100, 0x706080, 0x653100, 0x203190, 0x743048,
+0x685160, 0x506000, 0x0A4100, 0x6F51C0, 0x6451A0, 0x203198, 0x7340A0, 0x666000,
+0x3D6100, 0x0961C0, 0x6E4090, 0x634020, 0x2031A0, 0x7340B0, 0x653108, 0x347080,
+0x7561C0, 0x6C5020, 0x6140C0, 0x0D4110, 0x724080, 0x653110, 0x2031A8, 0x743050,
+0x694060, 0x537080, 0x0A4110, 0x6F51E0, 0x6451C0, 0x2031B0, 0x743058, 0x685180,
+0x458100, 0x0A4120, 0x6E40A0, 0x634030, 0x2031B8, 0x7340C0, 0x653118, 0x378100,
+0x795020, 0x6D50A0, 0x6260C0, 0x0D4120, 0x724090, 0x653120, 0x2E9000, 0x743060,
+0x694070, 0x6140D0, 0x0D4130, 0x7060C0, 0x653128, 0x2031C0, 0x743068, 0x6851A0,
+0x506040, 0x0A4130, 0x6E40B0, 0x6451E0, 0x2031C8, 0x7340D0, 0x666040, 0x3D6140,
+},
+{
+0x0A7000, 0x6F41E0, 0x6C4170, 0x633080, 0x7341D0, 0x6D5020, 0x633088, 0x7551E0,
+0x6F41F0, 0x675040, 0x616100, 0x7341E0, 0x6C4180, 0x633090, 0x754000, 0x6E4130,
+0x644160, 0x2E51E0, 0x6F3000, 0x6C4190, 0x633098, 0x7341F0, 0x6E4140, 0x644170,
+0x2E4000, 0x6F3008, 0x6C41A0, 0x6330A0, 0x733000, 0x6E4150, 0x644180, 0x754010,
+0x6F3010, 0x675060, 0x616140, 0x733008, 0x6D5040, 0x6330A8, 0x754020, 0x6E4160,
+0x644190, 0x2E4010, 0x733010, 0x6C41B0, 0x6330B0, 0x745000, 0x6E4170, 0x6441A0,
+0x2E4020, 0x6F3018, 0x6C41C0, 0x6330B8, 0x733018, 0x6E4180, 0x6441B0, 0x788000,
+0x6F3020, 0x6C41D0, 0x6330C0, 0x733020, 0x6D5060, 0x6330C8, 0x754030, 0x6F3028,
+0x675080, 0x568000, 0x733028, 0x6C41E0, 0x6330D0, 0x745020, 0x6E4190, 0x6441C0,
+0x2E4030, 0x6F3030, 0x6C41F0, 0x6330D8, 0x733030, 0x6E41A0, 0x6441D0, 0x208000,
+0x6F3038, 0x6C3000, 0x6330E0, 0x733038, 0x6E41B0, 0x6330E8, 0x754040, 0x6F3040,
+0x6750A0, 0x616180, 0x733040, 0x6C3008, 0x6330F0, 0x754050, 0x6E41C0, 0x6441E0,
+0x2E4040, 0x6F3048, 0x6C3010, 0x6330F8, 0x745040, 0x6E41D0, 0x6441F0, 0x2E4050,
+0x6F3050, 0x6C3018, 0x633100, 0x733048, 0x6E41E0, 0x643000, 0x767080, 0x6F3058,
+0x6750C0, 0x633108, 0x733050, 0x6D5080, 0x633110, 0x754060, 0x6F3060, 0x643008,
+0x2F8100, 0x733058, 0x6C3020, 0x633118, 0x745060, 0x6E41F0, 0x643010, 0x2E4060,
+0x6F3068, 0x6C3028, 0x633120, 0x733060, 0x6E3000, 0x643018, 0x0A7080, 0x6F3070,
+0x6C3030, 0x633128, 0x733068, 0x6D50A0, 0x633130, 0x754070, 0x6F3078, 0x6750E0,
+0x6161C0, 0x733070, 0x6C3038, 0x633138, 0x754080, 0x6E3008, 0x643020, 0x2E4070,
+0x6F3080, 0x6C3040, 0x633140, 0x745080, 0x6E3010, 0x643028, 0x2E4080, 0x6F3088,
+0x6C3048, 0x633148, 0x733078, 0x6E3018, 0x643030, 0x754090, 0x6F3090, 0x675100,
+0x615000, 0x733080, 0x6D50C0, 0x633150, 0x7540A0, 0x6F3098, 0x643038, 0x2E4090,
+0x733088, 0x6C3050, 0x633158, 0x7450A0, 0x6E3020, 0x643040, 0x2E40A0, 0x6F30A0,
+0x6C3058, 0x633160, 0x733090, 0x6E3028, 0x643048, 0x1009000, 0x6F30A8, 0x6C3060,
+0x633168, 0x733098, 0x6D50E0, 0x633170, 0x7540B0, 0x6F30B0, 0x675120, 0x615020,
+0x7330A0, 0x6C3068, 0x633178, 0x7540C0, 0x6E3030, 0x643050, 0x2E40B0, 0x6F30B8,
+0x6C3070, 0x633180, 0x7330A8, 0x6E3038, 0x643058, 0x2D8000, 0x6F30C0, 0x6C3078,
+0x633188, 0x7330B0, 0x6E3040, 0x633190, 0x7540D0, 0x6F30C8, 0x675140, 0x615040,
+0x7330B8, 0x6D5100, 0x633198, 0x7540E0, 0x6E3048, 0x643060, 0x2E40C0, 0x7330C0,
+0x6C3080, 0x6331A0, 0x7450C0, 0x6E3050, 0x643068, 0x2E40D0, 0x6F30D0, 0x6C3088,
+0x6331A8, 0x7330C8, 0x6E3058, 0x643070, 0x767100, 0x6F30D8, 0x6B9000, 0x6331B0,
+0x7330D0, 0x6D5120, 0x6331B8, 0x7540F0, 0x6F30E0, 0x643078, 0x449000, 0x7330D8,
+0x6C3090, 0x6331C0, 0x7450E0, 0x6E3060, 0x643080, 0x2E40E0, 0x6F30E8, 0x6C3098,
+0x6331C8, 0x7330E0, 0x6E3068, 0x643088, 0x208100, 0x6F30F0, 0x6C30A0, 0x6331D0,
+0x7330E8, 0x6E3070, 0x6331D8, 0x754100, 0x6F30F8, 0x675160, 0x615060, 0x7330F0,
+0x6C30A8, 0x6331E0, 0x754110, 0x6E3078, 0x643090, 0x2E40F0, 0x6F3100, 0x6C30B0,
+0x6331E8, 0x745100, 0x6E3080, 0x643098, 0x2E4100, 0x6F3108, 0x6C30B8, 0x6331F0,
+0x7330F8, 0x6E3088, 0x6430A0, 0x767180, 0x6F3110, 0x675180, 0x6331F8, 0x733100,
+0x6D5140, 0x632000, 0x754120, 0x6F3118, 0x6430A8, 0x2F7000, 0x733108, 0x6C30C0,
+0x632004, 0x745120, 0x6E3090, 0x6430B0, 0x2E4110, 0x6F3120, 0x6C30C8, 0x632008,
+0x733110, 0x6E3098, 0x6430B8, 0x0A7100, 0x6F3128, 0x6C30D0, 0x63200C, 0x733118,
+0x6D5160, 0x632010, 0x754130, 0x6F3130, 0x6751A0, 0x615080, 0x733120, 0x6C30D8,
+0x632014, 0x754140, 0x6E30A0, 0x6430C0, 0x2E4120, 0x6F3138, 0x6C30E0, 0x632018,
+0x733128, 0x6E30A8, 0x6430C8, 0x2E4130, 0x6F3140, 0x6C30E8, 0x63201C, 0x733130,
+0x6E30B0, 0x6430D0, 0x754150, 0x6F3148, 0x6751C0, 0x6150A0, 0x733138, 0x6D5180,
+0x632020, 0x754160, 0x6F3150, 0x6430D8, 0x2E4140, 0x733140, 0x6C30F0, 0x632024,
+0x745140, 0x6E30B8, 0x6430E0, 0x2E4150, 0x6F3158, 0x6C30F8, 0x632028, 0x733148,
+0x6E30C0, 0x6430E8, 0x788100, 0x6F3160, 0x6C3100, 0x63202C, 0x733150, 0x6D51A0,
+0x632030, 0x754170, 0x6F3168, 0x6751E0, 0x568100, 0x733158, 0x6C3108, 0x632034,
+0x745160, 0x6E30C8, 0x6430F0, 0x2E4160, 0x6F3170, 0x6C3110, 0x632038, 0x733160,
+0x6E30D0, 0x6430F8, 0x2D8100, 0x6F3178, 0x6C3118, 0x63203C, 0x733168, 0x6E30D8,
+0x632040, 0x754180, 0x6F3180, 0x674000, 0x6150C0, 0x733170, 0x6D51C0, 0x632044,
+0x754190, 0x6E30E0, 0x643100, 0x2E4170, 0x733178, 0x6C3120, 0x632048, 0x745180,
+0x6E30E8, 0x643108, 0x2E4180, 0x6F3188, 0x6C3128, 0x63204C, 0x733180, 0x6E30F0,
+0x643110, 0x766000, 0x6F3190, 0x674010, 0x632050, 0x733188, 0x6D51E0, 0x632054,
+0x7541A0, 0x6F3198, 0x643118, 0x2F7080, 0x733190, 0x6C3130, 0x632058, 0x7451A0,
+0x6E30F8, 0x643120, 0x2E4190, 0x6F31A0, 0x6C3138, 0x63205C, 0x733198, 0x6E3100,
+0x643128, 0x0A7180, 0x6F31A8, 0x6C3140, 0x632060, 0x7331A0, 0x6D4000, 0x632064,
+0x7541B0, 0x6F31B0, 0x674020, 0x6150E0, 0x7331A8, 0x6C3148, 0x632068, 0x7541C0,
+0x6E3108, 0x643130, 0x2E41A0, 0x6F31B8, 0x6C3150, 0x63206C, 0x7451C0, 0x6E3110,
+0x643138, 0x2E41B0, 0x6F31C0, 0x6C3158, 0x632070, 0x7331B0, 0x6E3118, 0x643140,
+0x766040, 0x6F31C8, 0x674030, 0x629000, 0x7331B8, 0x6D4010, 0x632074, 0x7541D0,
+0x6F31D0, 0x643148, 0x2E41C0, 0x7331C0, 0x6C3160, 0x632078, 0x7451E0, 0x6E3120,
+0x643150, 0x2E41D0, 0x6F31D8, 0x6C3168, 0x63207C, 0x7331C8, 0x6E3128, 0x643158,
+},
+{
+0x207000, 0x686040, 0x587080, 0x327180, 0x704040, 0x615140, 0x3D4090, 0x745160,
+0x648100, 0x5250A0, 0x314160, 0x6F6080, 0x5D40F0, 0x3D40A0, 0x735020, 0x634030,
+0x506040, 0x314170, 0x6D61C0, 0x5D4100, 0x3B8000, 0x726140, 0x625020, 0x467080,
+0x314180, 0x695020, 0x5D4110, 0x346040, 0x704050, 0x615160, 0x418100, 0x745180,
+0x666080, 0x5250C0, 0x314190, 0x704060, 0x615180, 0x3D40B0, 0x7451A0, 0x634040,
+0x518000, 0x3141A0, 0x6D5000, 0x5D4120, 0x3D40C0, 0x735040, 0x634050, 0x4B8100,
+0x3141B0, 0x695040, 0x5D4130, 0x357080, 0x704070, 0x625040, 0x426000, 0x778000,
+0x6660C0, 0x568000, 0x326000, 0x704080, 0x6151A0, 0x3D40D0, 0x7451C0, 0x634060,
+0x5250E0, 0x3141C0, 0x6F60C0, 0x5D4140, 0x3D40E0, 0x735060, 0x634070, 0x4E9000,
+0x3141D0, 0x6A9000, 0x5D4150, 0x388000, 0x726180, 0x625060, 0x467100, 0x2F8000,
+0x686080, 0x5D4160, 0x346080, 0x704090, 0x6151C0, 0x3D40F0, 0x7451E0, 0x657100,
+0x525100, 0x3141E0, 0x7040A0, 0x6151E0, 0x3D4100, 0x735080, 0x634080, 0x506080,
+0x3141F0, 0x6D5020, 0x5D4170, 0x3D4110, 0x7261C0, 0x634090, 0x498000, 0x313000,
+0x695060, 0x5D4180, 0x357100, 0x7040B0, 0x625080, 0x426040, 0x744000, 0x666100,
+0x548000, 0x313008, 0x7040C0, 0x614000, 0x3D4120, 0x744010, 0x6340A0, 0x525120,
+0x313010, 0x6E9000, 0x5D4190, 0x3D4130, 0x7350A0, 0x6340B0, 0x4D7000, 0x313018,
+0x695080, 0x5D41A0, 0x378000, 0x7040D0, 0x6250A0, 0x437080, 0x207080, 0x6860C0,
+0x587100, 0x338000, 0x7040E0, 0x614010, 0x3D4140, 0x744020, 0x657180, 0x525140,
+0x313020, 0x6F6100, 0x5D41B0, 0x3D4150, 0x7350C0, 0x6340C0, 0x5060C0, 0x313028,
+0x6D5040, 0x5D41C0, 0x3C8000, 0x725000, 0x6340D0, 0x478100, 0x313030, 0x6950A0,
+0x5D41D0, 0x3460C0, 0x7040F0, 0x614020, 0x426080, 0x744030, 0x666140, 0x525160,
+0x313038, 0x704100, 0x614030, 0x3D4160, 0x744040, 0x6340E0, 0x525180, 0x313040,
+0x6D5060, 0x5D41E0, 0x3D4170, 0x7350E0, 0x6340F0, 0x4C8000, 0x313048, 0x6950C0,
+0x5D41F0, 0x368100, 0x704110, 0x6250C0, 0x437100, 0x1009000, 0x686100, 0x587180,
+0x326040, 0x704120, 0x614040, 0x3D4180, 0x744050, 0x647000, 0x5251A0, 0x313050,
+0x6F6140, 0x5D3000, 0x3D4190, 0x735100, 0x634100, 0x506100, 0x313058, 0x6D5080,
+0x5D3008, 0x3B8100, 0x725020, 0x6250E0, 0x467180, 0x313060, 0x6950E0, 0x5D3010,
+0x346100, 0x704130, 0x614050, 0x417000, 0x744060, 0x666180, 0x5251C0, 0x313068,
+0x704140, 0x614060, 0x3D41A0, 0x744070, 0x634110, 0x518100, 0x313070, 0x6D50A0,
+0x5D3018, 0x3D41B0, 0x725040, 0x634120, 0x4B7000, 0x313078, 0x695100, 0x5D3020,
+0x357180, 0x704150, 0x625100, 0x4260C0, 0x778100, 0x6661C0, 0x568100, 0x326080,
+0x704160, 0x614070, 0x3D41C0, 0x744080, 0x634130, 0x5251E0, 0x313080, 0x6F6180,
+0x5D3028, 0x3D41D0, 0x735120, 0x634140, 0x4D7080, 0x313088, 0x695120, 0x5D3030,
+0x388100, 0x725060, 0x625120, 0x458000, 0x2F8100, 0x686140, 0x5D3038, 0x346140,
+0x704170, 0x614080, 0x3D41E0, 0x744090, 0x656000, 0x524000, 0x313090, 0x6F61C0,
+0x614090, 0x3D41F0, 0x735140, 0x634150, 0x506140, 0x313098, 0x6D50C0, 0x5D3040,
+0x3D3000, 0x725080, 0x634160, 0x477000, 0x3130A0, 0x695140, 0x5D3048, 0x346180,
+0x704180, 0x625140, 0x426100, 0x7440A0, 0x665000, 0x538000, 0x3130A8, 0x704190,
+0x6140A0, 0x3D3008, 0x7440B0, 0x634170, 0x524010, 0x3130B0, 0x6D50E0, 0x5D3050,
+0x3D3010, 0x735160, 0x634180, 0x4D7100, 0x3130B8, 0x695160, 0x5D3058, 0x367000,
+0x7041A0, 0x625160, 0x437180, 0x207100, 0x686180, 0x586000, 0x3260C0, 0x7041B0,
+0x6140B0, 0x3D3018, 0x7440C0, 0x656040, 0x524020, 0x3130C0, 0x6F5000, 0x5D3060,
+0x3D3020, 0x735180, 0x634190, 0x506180, 0x3130C8, 0x6D5100, 0x5D3068, 0x3C8100,
+0x7250A0, 0x6341A0, 0x466000, 0x3130D0, 0x695180, 0x5D3070, 0x3461C0, 0x7041C0,
+0x6140C0, 0x426140, 0x7440D0, 0x665020, 0x524030, 0x3130D8, 0x7041D0, 0x6140D0,
+0x3D3028, 0x7440E0, 0x6341B0, 0x524040, 0x3130E0, 0x6D5120, 0x5D3078, 0x3D3030,
+0x7351A0, 0x6341C0, 0x4B7080, 0x3130E8, 0x6951A0, 0x5D3080, 0x356000, 0x7041E0,
+0x625180, 0x436000, 0x7C9000, 0x6861C0, 0x586040, 0x326100, 0x7041F0, 0x6140E0,
+0x3D3038, 0x7440F0, 0x647080, 0x524050, 0x3130F0, 0x6F5020, 0x5D3088, 0x3D3040,
+0x7351C0, 0x6341D0, 0x5061C0, 0x3130F8, 0x6D5140, 0x5D3090, 0x399000, 0x7250C0,
+0x6251A0, 0x466040, 0x313100, 0x685000, 0x5D3098, 0x345000, 0x703000, 0x6140F0,
+0x417080, 0x744100, 0x656080, 0x524060, 0x313108, 0x703008, 0x614100, 0x3D3048,
+0x744110, 0x6341E0, 0x505000, 0x313110, 0x6D5160, 0x5D30A0, 0x3D3050, 0x7250E0,
+0x6341F0, 0x498100, 0x313118, 0x6951C0, 0x5D30A8, 0x356040, 0x703010, 0x6251C0,
+0x426180, 0x759000, 0x665040, 0x548100, 0x326140, 0x703018, 0x614110, 0x3D3058,
+0x744120, 0x633000, 0x524070, 0x313120, 0x6F5040, 0x5D30B0, 0x3D3060, 0x7351E0,
+0x633008, 0x4D7180, 0x313128, 0x6951E0, 0x5D30B8, 0x378100, 0x725100, 0x6251E0,
+0x458100, 0x207180, 0x685020, 0x5D30C0, 0x338100, 0x703020, 0x614120, 0x3D3068,
+0x744130, 0x6560C0, 0x524080, 0x313130, 0x6F5060, 0x5D30C8, 0x3D3070, 0x734000,
+0x633010, 0x505020, 0x313138, 0x6D5180, 0x5D30D0, 0x3D3078, 0x725120, 0x633018,
+0x477080, 0x313140, 0x694000, 0x5D30D8, 0x345020, 0x703028, 0x624000, 0x4261C0,
+0x744140, 0x665060, 0x538100, 0x313148, 0x703030, 0x614130, 0x3D3080, 0x744150,
+0x633020, 0x524090, 0x313150, 0x6D51A0, 0x5D30E0, 0x3D3088, 0x734010, 0x633028,
+0x4C8100, 0x313158, 0x694010, 0x5D30E8, 0x367080, 0x703038, 0x624010, 0x436040,
+},
+};
+
+/* tANS encoding, state of every symbol in the order of the symbols */
+static const uint16_t huffman_ans_state_table[HUFFMAN_NUM_TABLES][HUFFMAN_ANS_STATES] = {
+{
+ 512,  536,  591,  615,  646,  670,  725,  749,  780,  804,  835,  859,  914,  938,  969,  993,
+ 560,  694,  828,  883, 1017,  584,  639,  773,  907,  962,  522,  529,  546,  553,  577,  601,
+ 608,  632,  656,  663,  680,  687,  711,  718,  735,  742,  766,  790,  797,  821,  845,  852,
+ 869,  876,  900,  924,  931,  955,  979,  986, 1010, 1003,  814,  625,  515,  570,  594,  649,
+ 704,  759,  783,  838,  893,  948,  972,  539,  618,  673,  728,  752,  807,  862,  917,  941,
+ 996,  563,  886,  525,  532,  556,  580,  587,  611,  635,  642,  659,  666,  690,  697,  714,
+ 721,  745,  769,  776,  800,  824,  831,  848,  855,  879,  903,  910,  934,  958,  965,  982,
+ 989, 1013, 1020,  549,  573,  604,  628,  683,  738,  762,  793,  817,  872,  927,  951, 1006,
+ 518,  542,  597,  652,  707,  731,  786,  841,  865,  896,  920,  975,  566,  621,  676,  700,
+ 755,  810,  834,  889,  944,  999, 1023,  645,  535,  590,  724,  779,  913,  968,  858,  669,
+ 559,  614,  748,  803,  937,  992,  882,  528,  583,  638,  693,  717,  772,  827,  851,  906,
+ 961, 1016,  662,  552,  607,  686,  741,  796,  875,  930,  985, 1009,  631,  765,  820,  954,
+ 521,  576,  655,  710,  844,  899,  789,  978,  545,  600,  624,  679,  734,  813,  868,  923,
+ 947, 1002,  514,  569,  648,  703,  758,  837,  892,  971,  782,  538,  593,  672,  727,  861,
+ 916,  995,  806,  617,  940,  751,  562,  885,  696,  830, 1019,  641,  964,  586,  775,  909,
+ 720,  531,  665,  854,  799,  988,  610,  933,  555,  579,  634,  689,  744,  768,  823,  878,
+ 957, 1012,  902,  713,  524,  603,  658,  792,  847,  981,  548,  682,  737,  871,  926,  816,
+1005,  517,  572,  596,  627,  651,  706,  730,  761,  785,  840,  895,  919,  950,  974,  541,
+ 675,  864,  565,  620,  644,  699,  754,  809,  833,  888,  943,  967,  998, 1022,  534,  589,
+ 668,  723,  778,  857,  912,  991,  527,  551,  558,  575,  582,  606,  613,  630,  637,  661,
+ 685,  692,  716,  740,  747,  764,  771,  795,  802,  819,  826,  850,  874,  881,  905,  929,
+ 936,  953,  960,  984, 1008, 1015,  709,  898,  520,  843,  599,  654,  788,  922,  977,  513,
+ 537,  544,  561,  568,  592,  616,  623,  647,  671,  678,  695,  702,  726,  733,  750,  757,
+ 781,  805,  812,  829,  836,  860,  867,  884,  891,  915,  939,  946,  970,  994, 1001, 1018,
+ 640,  963,  530,  554,  585,  609,  664,  688,  719,  743,  774,  798,  853,  877,  908,  932,
+ 987,  523,  578,  633,  712,  767,  822,  901,  956, 1011,  547,  602,  626,  657,  681,  736,
+ 791,  815,  846,  870,  925,  980, 1004,  516,  540,  571,  595,  650,  674,  705,  729,  760,
+ 784,  808,  839,  863,  894,  918,  949,  973,  997,  564,  619,  643,  698,  753,  777,  832,
+ 887,  942,  966, 1021,  533,  557,  588,  612,  667,  722,  746,  801,  856,  880,  911,  935,
+ 990,  526,  581,  605,  636,  660,  691,  715,  770,  794,  825,  849,  904,  959,  983, 1014,
+ 550,  574,  629,  684,  739,  763,  818,  873,  897,  928,  952, 1007,  519,  653,  708,  842,
+ 543,  598,  677,  732,  787,  866,  921,  976, 1000,  622,  811,  567,  756,  945,  890,  701,
+},
+{
+ 512,  591,  646,  725,  780,  835,  914,  969,  529,  536,  560,  584,  608,  615,  639,  663,
+ 670,  694,  718,  749,  773,  797,  804,  828,  852,  859,  883,  907,  931,  938,  962,  986,
+ 993, 1017,  522,  546,  553,  577,  601,  625,  632,  656,  680,  687,  711,  735,  742,  766,
+ 790,  814,  821,  845,  869,  876,  900,  924,  955,  979, 1003, 1010,  515,  525,  532,  539,
+ 549,  556,  563,  570,  580,  587,  594,  604,  611,  618,  635,  642,  649,  659,  666,  673,
+ 690,  697,  704,  714,  721,  728,  738,  745,  752,  759,  769,  776,  783,  793,  800,  807,
+ 824,  831,  838,  848,  855,  862,  872,  879,  886,  893,  903,  910,  917,  927,  934,  941,
+ 948,  958,  965,  972,  982,  989,  996, 1013, 1020,  683, 1006,  817,  628,  951,  573,  762,
+ 896,  518,  707,  652,  841,  975,  597,  786,  920,  542,  731,  865,  676,  999,  621,  810,
+ 944,  755,  566,  889,  590,  645,  700,  779,  834,  968, 1023,  913,  724,  535,  858,  669,
+ 992,  803,  614,  937,  748,  559,  882,  638,  693,  827,  961, 1016,  528,  583,  717,  772,
+ 906,  662,  851,  985,  607,  796,  930,  521,  545,  552,  576,  600,  631,  655,  679,  686,
+ 710,  734,  741,  765,  789,  820,  844,  868,  875,  899,  923,  954,  978, 1009,  569,  624,
+ 758,  813,  947, 1002,  514,  538,  593,  617,  648,  672,  703,  727,  751,  782,  806,  837,
+ 861,  892,  916,  940,  971,  995,  531,  562,  586,  641,  665,  696,  720,  775,  799,  830,
+ 854,  885,  909,  964,  988, 1019,  517,  524,  541,  548,  555,  565,  572,  579,  596,  603,
+ 610,  620,  627,  634,  651,  658,  675,  682,  689,  706,  713,  730,  737,  744,  754,  761,
+ 768,  785,  792,  809,  816,  823,  840,  847,  864,  871,  878,  888,  895,  902,  919,  926,
+ 933,  943,  950,  957,  974,  981,  998, 1005, 1012,  644,  699,  833,  967, 1022,  534,  589,
+ 723,  778,  912,  558,  613,  637,  668,  692,  747,  771,  802,  826,  857,  881,  936,  960,
+ 991, 1015,  527,  551,  575,  582,  606,  630,  661,  685,  716,  740,  764,  795,  819,  850,
+ 874,  905,  929,  953,  984, 1008,  898,  520,  599,  654,  709,  733,  788,  843,  922,  977,
+ 544,  568,  623,  678,  702,  757,  812,  867,  891,  946, 1001,  513,  537,  561,  592,  616,
+ 640,  647,  671,  695,  726,  750,  781,  805,  829,  836,  860,  884,  915,  939,  970,  994,
+1018,  530,  554,  585,  609,  664,  688,  719,  743,  774,  798,  853,  877,  908,  932,  963,
+ 987,  578,  633,  767,  822,  956, 1011,  523,  547,  571,  602,  626,  657,  681,  705,  712,
+ 736,  760,  791,  815,  846,  870,  894,  901,  925,  949,  980, 1004,  516,  540,  564,  595,
+ 619,  643,  650,  674,  698,  729,  753,  784,  808,  832,  839,  863,  887,  918,  942,  966,
+ 973,  997, 1021,  526,  533,  550,  557,  581,  588,  605,  612,  629,  636,  660,  667,  684,
+ 691,  715,  722,  739,  746,  763,  770,  777,  794,  801,  818,  825,  849,  856,  873,  880,
+ 904,  911,  928,  935,  952,  959,  983,  990, 1007, 1014,  519,  574,  653,  708,  787,  842,
+ 897,  976,  598,  921,  732,  543,  567,  622,  677,  756,  811,  866,  945, 1000,  890,  701,
+},
+{
+ 512,  646,  835,  969,  591,  780,  725,  914,  529,  536,  553,  560,  584,  608,  615,  639,
+ 663,  670,  687,  694,  718,  742,  749,  773,  797,  804,  828,  852,  859,  876,  883,  907,
+ 931,  938,  962,  986,  993, 1010, 1017,  632,  821,  955,  766,  577,  900,  522,  546,  601,
+ 656,  680,  711,  735,  790,  845,  869,  924,  979, 1003,  515,  518,  525,  532,  539,  549,
+ 556,  563,  570,  573,  580,  587,  594,  597,  604,  611,  618,  625,  628,  635,  642,  649,
+ 652,  659,  666,  673,  683,  690,  697,  704,  707,  714,  721,  728,  731,  738,  745,  752,
+ 759,  762,  769,  776,  783,  786,  793,  800,  807,  814,  817,  824,  831,  838,  841,  848,
+ 855,  862,  872,  879,  886,  893,  896,  903,  910,  917,  920,  927,  934,  941,  948,  951,
+ 958,  965,  972,  975,  982,  989,  996, 1006, 1013, 1020,  528,  535,  542,  552,  559,  566,
+ 583,  590,  607,  614,  621,  631,  638,  645,  662,  669,  676,  686,  693,  700,  717,  724,
+ 741,  748,  755,  765,  772,  779,  796,  803,  810,  820,  827,  834,  851,  858,  865,  875,
+ 882,  889,  906,  913,  930,  937,  944,  954,  961,  968,  985,  992,  999, 1009, 1016, 1023,
+ 521,  545,  576,  600,  624,  655,  679,  710,  734,  789,  813,  844,  868,  899,  923,  947,
+ 978, 1002,  758,  514,  524,  531,  538,  555,  562,  569,  579,  586,  593,  603,  610,  617,
+ 634,  641,  648,  658,  665,  672,  689,  696,  703,  713,  720,  727,  744,  751,  768,  775,
+ 782,  792,  799,  806,  823,  830,  837,  847,  854,  861,  878,  885,  892,  902,  909,  916,
+ 933,  940,  957,  964,  971,  981,  988,  995, 1012, 1019,  517,  548,  572,  627,  651,  682,
+ 706,  737,  761,  816,  840,  871,  895,  926,  950,  974, 1005,  527,  534,  541,  551,  558,
+ 565,  582,  589,  596,  606,  613,  620,  637,  644,  661,  668,  675,  692,  699,  716,  723,
+ 730,  740,  747,  754,  771,  778,  785,  795,  802,  809,  826,  833,  850,  857,  864,  881,
+ 888,  905,  912,  919,  929,  936,  943,  960,  967,  984,  991,  998, 1015, 1022,  513,  520,
+ 530,  537,  544,  561,  568,  575,  585,  592,  599,  609,  616,  623,  630,  640,  647,  654,
+ 664,  671,  678,  685,  695,  702,  709,  719,  726,  733,  750,  757,  764,  774,  781,  788,
+ 798,  805,  812,  819,  829,  836,  843,  853,  860,  867,  874,  884,  891,  898,  908,  915,
+ 922,  939,  946,  953,  963,  970,  977,  987,  994, 1001, 1008, 1018,  516,  523,  533,  540,
+ 547,  554,  564,  571,  578,  588,  595,  602,  619,  626,  633,  643,  650,  657,  674,  681,
+ 688,  698,  705,  712,  722,  729,  736,  743,  753,  760,  767,  777,  784,  791,  808,  815,
+ 822,  832,  839,  846,  856,  863,  870,  877,  887,  894,  901,  911,  918,  925,  932,  942,
+ 949,  956,  966,  973,  980,  997, 1004, 1011, 1021,  557,  581,  612,  636,  667,  691,  746,
+ 770,  801,  825,  880,  904,  935,  959,  990, 1014,  519,  526,  543,  550,  574,  598,  605,
+ 629,  653,  660,  677,  684,  708,  715,  732,  739,  763,  787,  794,  818,  842,  849,  866,
+ 873,  897,  921,  928,  952,  976,  983, 1007,  622,  756,  811,  945, 1000,  567,  890,  701,
+},
+{
+ 512,  646,  835,  969,  591,  780,  522,  529,  536,  546,  553,  560,  577,  584,  601,  608,
+ 615,  625,  632,  639,  656,  663,  670,  680,  687,  694,  711,  718,  725,  735,  742,  749,
+ 766,  773,  790,  797,  804,  814,  821,  828,  845,  852,  859,  869,  876,  883,  900,  907,
+ 914,  924,  931,  938,  955,  962,  979,  986,  993, 1003, 1010, 1017,  515,  570,  704,  759,
+ 838,  893,  948,  649,  972,  539,  594,  673,  728,  783,  807,  862,  917,  996,  563,  618,
+ 752,  886,  941,  697,  831, 1020,  642,  965,  587,  776,  910,  532,  721,  666,  855,  518,
+ 525,  549,  556,  573,  580,  597,  604,  611,  628,  635,  652,  659,  683,  690,  707,  714,
+ 738,  745,  762,  769,  786,  793,  800,  817,  824,  841,  848,  872,  879,  896,  903,  927,
+ 934,  951,  958,  975,  982,  989, 1006, 1013,  542,  731,  920,  566,  621,  676,  755,  810,
+ 865,  944,  999,  645,  700,  834,  889, 1023,  779,  968,  535,  590,  724,  858,  913,  669,
+ 803,  992,  614,  937,  559,  748,  882,  693, 1016,  638,  772,  827,  961,  583,  528,  607,
+ 662,  717,  796,  851,  906,  930,  985,  552,  741,  521,  545,  576,  600,  631,  655,  679,
+ 686,  710,  734,  765,  789,  820,  844,  868,  875,  899,  923,  954,  978, 1009,  813, 1002,
+ 624,  947,  569,  758,  514,  648,  703,  837,  892,  524,  531,  538,  555,  562,  579,  586,
+ 593,  610,  617,  634,  641,  658,  665,  672,  689,  696,  713,  720,  727,  744,  751,  768,
+ 775,  782,  799,  806,  823,  830,  847,  854,  861,  878,  885,  902,  909,  916,  933,  940,
+ 957,  964,  971,  981,  988,  995, 1012, 1019,  517,  541,  548,  572,  596,  603,  627,  651,
+ 675,  682,  706,  730,  737,  761,  785,  792,  816,  840,  864,  871,  895,  919,  926,  950,
+ 974, 1005,  534,  565,  589,  620,  644,  699,  723,  754,  778,  809,  833,  888,  912,  943,
+ 967,  998, 1022,  527,  551,  558,  575,  582,  606,  613,  630,  637,  661,  668,  685,  692,
+ 716,  740,  747,  764,  771,  795,  802,  819,  826,  850,  857,  874,  881,  905,  929,  936,
+ 953,  960,  984,  991, 1008, 1015,  520,  709,  898,  599,  654,  788,  843,  922,  977,  544,
+ 568,  623,  678,  733,  757,  812,  867,  946, 1001,  513,  592,  647,  702,  781,  836,  891,
+ 915,  970,  537,  561,  616,  640,  671,  695,  726,  750,  774,  805,  829,  860,  884,  939,
+ 963,  994, 1018,  585,  530,  554,  609,  664,  688,  719,  743,  798,  822,  853,  877,  908,
+ 932,  987, 1011,  633,  523,  578,  657,  712,  767,  791,  846,  901,  956,  980,  516,  540,
+ 547,  564,  571,  595,  602,  619,  626,  643,  650,  674,  681,  698,  705,  729,  736,  753,
+ 760,  784,  808,  815,  832,  839,  863,  870,  887,  894,  918,  925,  942,  949,  973,  997,
+1004, 1021,  533,  588,  612,  667,  722,  746,  777,  801,  856,  911,  935,  966,  990,  526,
+ 557,  581,  605,  636,  660,  691,  715,  770,  794,  825,  849,  880,  904,  959,  983, 1014,
+ 519,  543,  550,  574,  598,  622,  629,  653,  677,  684,  708,  732,  739,  763,  787,  811,
+ 818,  842,  866,  873,  897,  921,  928,  952,  976, 1000, 1007,  945,  567,  756,  890,  701,
+},
+};
+
+/* tANS encoding, bits to send are (state + this) >> 16, 0 for bytes which are sent escaped */
+static const uint32_t huffman_ans_symbol_bits[HUFFMAN_NUM_TABLES][HUFFMAN_NUM_SYMBOLS] = {
+{
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x5FC00, 0x6FD80, 0x00000, 0x00000, 0x6FD80, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x4FC20, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x9FC00, 0x9FC00, 0x00000, 0x9FC00, 0x00000, 0x5FD40, 0x5FD80, 0x8FC00,
+0x4FC00, 0x5FCC0, 0x5FD00, 0x5FD40, 0x9FC00, 0x6FD00, 0x9FC00, 0x9FC00,
+0x6FD00, 0x9FC00, 0x5FD40, 0x9FC00, 0x00000, 0x6FC00, 0x00000, 0x00000,
+0x9FC00, 0x7FC00, 0x6FD00, 0x8FC00, 0x5FD80, 0x6FC00, 0x9FC00, 0x6FC80,
+0x9FC00, 0x8FC00, 0x9FC00, 0x9FC00, 0x9FC00, 0x7FD00, 0x9FC00, 0x9FC00,
+0x7FD00, 0x9FC00, 0x7FD00, 0x8FC00, 0x8FC00, 0x5FD80, 0x9FC00, 0x9FC00,
+0x9FC00, 0x00000, 0x00000, 0x6FD80, 0x00000, 0x6FD80, 0x00000, 0x8FC00,
+0x00000, 0x5FC80, 0x7FD00, 0x5FD00, 0x6FC00, 0x4FC00, 0x8FC00, 0x8FC00,
+0x6FD80, 0x3FDF0, 0x9FC00, 0x9FC00, 0x5FC40, 0x5FDC0, 0x5FCC0, 0x4FDC0,
+0x5FD40, 0x00000, 0x5FCC0, 0x5FC40, 0x5FD00, 0x7FC00, 0x6FC00, 0x9FC00,
+0x8FC00, 0x7FD00, 0x00000, 0x00000, 0x9FC00, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x9FC00, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000,
+},
+{
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x6FC00, 0x4FCC0, 0x00000, 0x00000, 0x4FCC0, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x3FC30, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x9FC00, 0x00000, 0x9FC00, 0x9FC00,
+0x8FC00, 0x8FC00, 0x9FC00, 0x8FC00, 0x7FD00, 0x7FD00, 0x7FD00, 0x8FC00,
+0x7FD00, 0x9FC00, 0x9FC00, 0x00000, 0x9FC00, 0x6FC80, 0x9FC00, 0x00000,
+0x00000, 0x9FC00, 0x8FC00, 0x00000, 0x00000, 0x8FC00, 0x9FC00, 0x00000,
+0x00000, 0x9FC00, 0x00000, 0x9FC00, 0x00000, 0x9FC00, 0x00000, 0x8FC00,
+0x6FD80, 0x00000, 0x6FD80, 0x7FD00, 0x7FD00, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x4FD20, 0x6FD00, 0x4FDC0, 0x5FC00, 0x3FCD0, 0x6FD80, 0x6FD80,
+0x5FC40, 0x4FD80, 0x9FC00, 0x00000, 0x5FDC0, 0x5FD40, 0x4FD40, 0x5FC00,
+0x6FD00, 0x00000, 0x4FD60, 0x4FD20, 0x3FD90, 0x6FC00, 0x8FC00, 0x00000,
+0x9FC00, 0x5FDC0, 0x00000, 0x00000, 0x9FC00, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x9FC00, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000,
+},
+{
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x7FC00, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x8FC00, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x8FC00, 0x4FC20, 0x7FD00,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x9FC00, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x8FC00, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x5FD00, 0x9FC00, 0x2FD80, 0x3FCA0, 0x00000, 0x00000, 0x4FDC0,
+0x00000, 0x00000, 0x00000, 0x9FC00, 0x3FC90, 0x4FDE0, 0x3FCD0, 0x3FC20,
+0x00000, 0x00000, 0x00000, 0x3FC30, 0x5FC00, 0x4FC20, 0x6FD80, 0x00000,
+0x8FC00, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x9FC00, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000,
+},
+{
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x7FC00, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x8FC00,
+0x00000, 0x3FCA0, 0x6FC80, 0x8FC00, 0x5FDC0, 0x6FD80, 0x7FD00, 0x8FC00,
+0x8FC00, 0x9FC00, 0x00000, 0x8FC00, 0x8FC00, 0x3FD70, 0x00000, 0x00000,
+0x00000, 0x7FD00, 0x6FC00, 0x6FD80, 0x00000, 0x8FC00, 0x6FD80, 0x7FD00,
+0x00000, 0x8FC00, 0x00000, 0x7FD00, 0x8FC00, 0x7FC00, 0x9FC00, 0x00000,
+0x5FDC0, 0x8FC00, 0x4FD60, 0x8FC00, 0x8FC00, 0x00000, 0x8FC00, 0x00000,
+0x6FD80, 0x00000, 0x00000, 0x00000, 0x00000, 0x3FD10, 0x00000, 0x00000,
+0x00000, 0x4FCC0, 0x4FDE0, 0x3FDD0, 0x7FD00, 0x6FD00, 0x5FD80, 0x00000,
+0x5FDC0, 0x4FDE0, 0x9FC00, 0x00000, 0x00000, 0x5FC40, 0x9FC00, 0x5FD80,
+0x3FDC0, 0x00000, 0x5FCC0, 0x4FDE0, 0x4FCA0, 0x9FC00, 0x00000, 0x8FC00,
+0x00000, 0x00000, 0x00000, 0x00000, 0x9FC00, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x9FC00, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000, 0x00000,
+0x00000,
+},
+};
+
+/* tANS encoding, added to the state shifted by the bits sent to find the next one */
+static const int16_t huffman_ans_symbol_state[HUFFMAN_NUM_TABLES][HUFFMAN_NUM_SYMBOLS] = {
+{
+   0,    0,    0,    0,    0,    0,    0,    0,    0,  -16,   11,    0,    0,   16,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+  -5,    0,    0,    0,    0,    0,    0,    0,   56,   57,    0,   58,    0,   49,   61,   79,
+  51,  102,  116,  129,  150,  146,  157,  158,  154,  165,  156,  177,    0,  171,    0,    0,
+ 186,  184,  186,  196,  190,  202,  217,  212,  225,  225,  228,  229,  230,  229,  234,  235,
+ 234,  239,  238,  242,  244,  238,  257,  258,  259,    0,    0,  256,    0,  261,    0,  269,
+   0,  259,  284,  278,  294,  278,  340,  342,  341,  318,  383,  384,  371,  392,  397,  405,
+ 430,    0,  439,  450,  468,  488,  488,  503,  503,  504,    0,    0,  509,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+ 510,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,
+},
+{
+   0,    0,    0,    0,    0,    0,    0,    0,    0,   -8,  -18,    0,    0,    8,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+  -1,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,  120,    0,  121,  122,
+ 122,  124,  127,  127,  128,  131,  134,  138,  139,  144,  145,    0,  146,  141,  154,    0,
+   0,  155,  155,    0,    0,  157,  160,    0,    0,  161,    0,  162,    0,  163,    0,  163,
+ 162,    0,  167,  174,  177,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,  160,  200,  194,  214,  195,  292,  297,  292,  302,  341,    0,  334,  341,  341,  369,
+ 395,    0,  386,  405,  412,  482,  496,    0,  499,  492,    0,    0,  509,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+ 510,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,
+},
+{
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,   -4,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   2,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    4,  -23,   36,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,   41,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,   41,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,   33,   56,  -22,   84,    0,    0,  174,    0,    0,    0,  209,  156,  249,  232,  272,
+   0,    0,    0,  335,  441,  442,  499,    0,  507,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+ 510,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,
+},
+{
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+  -4,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    2,
+   0,  -48,   53,   65,   60,   73,   80,   84,   86,   89,    0,   89,   91,   54,    0,    0,
+   0,  133,  131,  142,    0,  150,  149,  156,    0,  160,    0,  161,  165,  165,  172,    0,
+ 165,  181,  164,  204,  206,    0,  208,    0,  207,    0,    0,    0,    0,  170,    0,    0,
+   0,  238,  273,  272,  339,  339,  341,    0,  352,  353,  386,    0,    0,  373,  402,  394,
+ 378,    0,  437,  446,  453,  506,    0,  506,    0,    0,    0,    0,  509,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+ 510,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,
+},
+};
+
+/* The frequencies of the range coder of every table add up to 2^HUFFMAN_RANGE_TOTAL_BITS */
+#define HUFFMAN_RANGE_TOTAL_BITS (12)
+
+/* Range coder, sum of the frequencies of the symbols before every symbol, then the total */
+static const uint16_t huffman_range_cumulative[HUFFMAN_NUM_TABLES][HUFFMAN_NUM_SYMBOLS + 1] = {
+{
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,  128,  171,  171,  171,  214,  214,
+ 214,  214,  214,  214,  214,  214,  214,  214,  214,  214,  214,  214,  214,  214,  214,  214,
+ 214,  469,  469,  469,  469,  469,  469,  469,  469,  470,  471,  471,  472,  472,  565,  644,
+ 661,  925, 1033, 1131, 1221, 1225, 1272, 1278, 1279, 1332, 1337, 1431, 1437, 1437, 1504, 1504,
+1504, 1509, 1539, 1591, 1609, 1691, 1758, 1762, 1820, 1826, 1838, 1839, 1840, 1850, 1873, 1879,
+1888, 1909, 1910, 1931, 1947, 1967, 2046, 2054, 2059, 2068, 2068, 2068, 2111, 2111, 2154, 2154,
+2170, 2170, 2284, 2305, 2405, 2467, 2729, 2747, 2763, 2803, 3067, 3068, 3079, 3201, 3278, 3389,
+3540, 3626, 3626, 3733, 3857, 3956, 3991, 4054, 4058, 4073, 4094, 4094, 4094, 4095, 4095, 4095,
+4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095,
+4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095,
+4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095,
+4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095,
+4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095,
+4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095,
+4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095,
+4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095,
+4095, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096,
+4096, 4096,
+},
+{
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,   68,  283,  283,  283,  498,  498,
+ 498,  498,  498,  498,  498,  498,  498,  498,  498,  498,  498,  498,  498,  498,  498,  498,
+ 498,  987,  987,  987,  987,  987,  987,  987,  987,  987,  987,  987,  987,  991,  991,  995,
+1003, 1016, 1029, 1040, 1057, 1082, 1105, 1126, 1145, 1168, 1177, 1181, 1181, 1187, 1240, 1246,
+1246, 1246, 1248, 1267, 1267, 1267, 1282, 1288, 1288, 1288, 1290, 1290, 1298, 1298, 1304, 1304,
+1317, 1359, 1359, 1397, 1420, 1443, 1443, 1443, 1443, 1443, 1443, 1443, 1443, 1443, 1443, 1443,
+1443, 1443, 1626, 1673, 1822, 1952, 2360, 2403, 2445, 2566, 2728, 2734, 2734, 2810, 2899, 3078,
+3210, 3257, 3257, 3431, 3622, 3937, 3999, 4014, 4014, 4018, 4088, 4088, 4088, 4094, 4094, 4094,
+4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094,
+4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094,
+4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094,
+4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094,
+4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094,
+4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094,
+4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094,
+4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094, 4094,
+4094, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096,
+4096, 4096,
+},
+{
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,   35,   35,   35,   35,   35,
+  35,   35,   35,   35,   35,   35,   35,   35,   35,   35,   35,   35,   35,   35,   35,   35,
+  35,   52,   52,   52,   52,   52,   52,   52,   52,   52,   52,   52,   52,   52,   69,  313,
+ 339,  339,  339,  339,  339,  339,  339,  339,  339,  339,  339,  339,  339,  339,  339,  339,
+ 339,  339,  339,  339,  339,  348,  348,  348,  348,  348,  348,  348,  348,  348,  348,  348,
+ 348,  348,  348,  348,  348,  348,  348,  365,  365,  365,  365,  365,  365,  365,  365,  365,
+ 365,  365,  461,  470, 1106, 1533, 1533, 1533, 1672, 1672, 1672, 1672, 1681, 2117, 2256, 2666,
+3163, 3163, 3163, 3163, 3651, 3782, 4026, 4070, 4070, 4087, 4087, 4087, 4087, 4087, 4087, 4087,
+4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087,
+4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087,
+4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087,
+4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087,
+4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087,
+4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087,
+4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087,
+4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087, 4087,
+4087, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096,
+4096, 4096,
+},
+{
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   0,   32,   32,   32,   32,   32,   32,   32,   32,   32,   32,   32,   32,   32,   32,   32,
+  45,   45,  482,  539,  558,  634,  672,  697,  710,  729,  735,  735,  748,  767, 1096, 1096,
+1096, 1096, 1121, 1184, 1222, 1222, 1235, 1273, 1298, 1298, 1311, 1311, 1336, 1349, 1381, 1387,
+1387, 1463, 1476, 1641, 1654, 1667, 1667, 1680, 1680, 1718, 1718, 1718, 1718, 1718, 2098, 2098,
+2098, 2098, 2307, 2440, 2725, 2750, 2801, 2883, 2883, 2959, 3092, 3098, 3098, 3098, 3218, 3224,
+3306, 3597, 3597, 3705, 3844, 4059, 4065, 4065, 4084, 4084, 4084, 4084, 4084, 4090, 4090, 4090,
+4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090,
+4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090,
+4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090,
+4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090,
+4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090,
+4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090,
+4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090,
+4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090, 4090,
+4090, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096,
+4096, 4096,
+},
+};
 
 #endif
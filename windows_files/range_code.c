@@ -0,0 +1,277 @@
+/**
+ * @file    :   range_code.c
+ * @brief   :   An abstraction for range encoding and decoding functions
+ *
+ *              This source file provides functions which code messages
+ * 				with the range coder tables of lookup_table.h
+ *
+ * @author  :   Sanish Kharade
+ * @date    :   December 10, 2021
+ * @version :   1.0
+ *
+ * @tools   :   gcc, cygwin, Visual Studio Code
+ *
+ * @link    :   Carryless range coder of Dmitry Subbotin (1999)
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "range_code.h"
+#include "lookup_table.h"
+
+#if HUFFMAN_RANGE_TOTAL_BITS != RANGE_TOTAL_BITS
+#error "RANGE_TOTAL_BITS must match the range coder tables in lookup_table.h"
+#endif
+
+/* A byte is sent once the top byte of the range is settled */
+#define RANGE_TOP			(1UL << 24)
+
+/* Smallest range, below it the range is cut to the next byte boundary */
+#define RANGE_BOTTOM		(1UL << 16)
+
+/* The raw bits of an escaped byte are coded as 256 equal frequencies */
+#define RANGE_RAW_BITS		(8)
+
+/*
+ * 	range_coder_t is the state of the encoder or the decoder
+ * 	low		- bottom of the range
+ * 	range	- size of the range
+ * 	code	- bytes read so far, decoder only
+ * 	buffer	- bytes written, encoder only
+ * 	input	- bytes read, decoder only
+ * 	nbytes	- size of buffer or input
+ * 	idx		- index of the next byte of buffer or input
+ * 	overflow	- set if the encoded bytes did not fit
+*/
+typedef struct
+{
+	uint32_t low;
+	uint32_t range;
+	uint32_t code;
+	uint8_t *buffer;
+	const uint8_t *input;
+	size_t nbytes;
+	size_t idx;
+	bool overflow;
+} range_coder_t;
+
+/*********************************************************************************
+ * @brief   :  	Sends the settled top bytes of the range
+ *
+ * @param   :   coder	- encoder state
+ *
+ * @return  : 	void
+**********************************************************************************/
+static inline void range_shift_out(range_coder_t *coder)
+{
+	while ((coder->low ^ (coder->low + coder->range)) < RANGE_TOP ||
+			(coder->range < RANGE_BOTTOM && ((coder->range = -coder->low & (RANGE_BOTTOM - 1)), true)))
+	{
+		if (coder->idx < coder->nbytes)
+			coder->buffer[coder->idx++] = coder->low >> 24;
+		else
+			coder->overflow = true;
+		coder->low <<= 8;
+		coder->range <<= 8;
+	}
+}
+
+/*********************************************************************************
+ * @brief   :  	Narrows the range to a symbol
+ *
+ * @param   :   coder		- encoder state
+ * 				start		- sum of the frequencies of the symbols before it
+ * 				size		- frequency of the symbol
+ * 				total_bits	- the frequencies add up to 2^total_bits
+ *
+ * @return  : 	void
+**********************************************************************************/
+static inline void range_encode(range_coder_t *coder, uint32_t start, uint32_t size, uint8_t total_bits)
+{
+	coder->range >>= total_bits;
+	coder->low += start * coder->range;
+	coder->range *= size;
+	range_shift_out(coder);
+}
+
+/*********************************************************************************
+ * @brief   :  	Encodes characters with the range coder of a static table
+ *
+ * 				At most HUFFMAN_ENCODED_SIZE(length) bytes are written
+ *
+ * @param   :   table	- ID of the table, below HUFFMAN_STATIC_TABLES
+ * 				data	- characters to encode
+ * 				length	- number of characters in data
+ * 				buffer	- buffer to fill with the encoded characters
+ * 				nbytes	- size of the buffer
+ * 				bits	- set to the number of encoded bits, 8 for every byte
+ *
+ * @return  : 	size_t	- number of bytes written to buffer, 0 if they do not fit
+**********************************************************************************/
+size_t range_encode_table(uint8_t table, const uint8_t *data, size_t length,
+							uint8_t *buffer, size_t nbytes, uint32_t *bits)
+{
+	range_coder_t coder = { 0, UINT32_MAX, 0, buffer, NULL, nbytes, 0, false };
+
+	*bits = 0;
+	if (length == 0 || table >= HUFFMAN_STATIC_TABLES)
+		return 0;
+
+	const uint16_t *cumulative = huffman_range_cumulative[table];
+
+	for (const uint8_t *p = data; p < data + length; p++)
+	{
+		uint16_t start = cumulative[*p];
+		uint16_t size = cumulative[*p + 1] - start;
+
+		if (size == 0)
+		{
+			start = cumulative[HUFFMAN_ESCAPE_SYMBOL];
+			range_encode(&coder, start, cumulative[HUFFMAN_ESCAPE_SYMBOL + 1] - start, RANGE_TOTAL_BITS);
+			range_encode(&coder, *p, 1, RANGE_RAW_BITS);
+		}
+		else
+		{
+			range_encode(&coder, start, size, RANGE_TOTAL_BITS);
+		}
+	}
+
+	/*
+	 * End with the fewest top bytes of a number in the range, the decoder
+	 * fills in the rest with 0. The end of the range may be 2^32
+	 */
+	for (uint8_t count = 0; count <= 4; count++)
+	{
+		uint32_t mask = (count < 4) ? (UINT32_MAX >> (8 * count)) : 0;
+		uint32_t value = (coder.low + mask) & ~mask;
+
+		if (value >= coder.low && value - coder.low < coder.range)
+		{
+			for (uint8_t i = 0; i < count; i++)
+			{
+				if (coder.idx < coder.nbytes)
+					coder.buffer[coder.idx++] = value >> (24 - 8 * i);
+				else
+					coder.overflow = true;
+			}
+			break;
+		}
+	}
+
+	if (coder.overflow)
+		return 0;
+
+	*bits = 8 * coder.idx;
+	return coder.idx;
+}
+
+/*********************************************************************************
+ * @brief   :  	Reads the next byte, 0 past the end of the input
+ *
+ * @param   :   coder	- decoder state
+ *
+ * @return  : 	uint8_t	- the byte
+**********************************************************************************/
+static inline uint8_t range_next_byte(range_coder_t *coder)
+{
+	return (coder->idx < coder->nbytes) ? coder->input[coder->idx++] : 0;
+}
+
+/*********************************************************************************
+ * @brief   :  	Finds the scaled frequency the encoded number falls on
+ *
+ * @param   :   coder		- decoder state
+ * 				total_bits	- the frequencies add up to 2^total_bits
+ *
+ * @return  : 	uint32_t	- the frequency, 2^total_bits or more if the input
+ * 							  is corrupt
+**********************************************************************************/
+static inline uint32_t range_decode_frequency(range_coder_t *coder, uint8_t total_bits)
+{
+	coder->range >>= total_bits;
+	return (coder->code - coder->low) / coder->range;
+}
+
+/*********************************************************************************
+ * @brief   :  	Narrows the range to the decoded symbol and reads the bytes
+ * 				the encoder sent for it
+ *
+ * @param   :   coder		- decoder state
+ * 				start		- sum of the frequencies of the symbols before it
+ * 				size		- frequency of the symbol
+ *
+ * @return  : 	void
+**********************************************************************************/
+static inline void range_decode_update(range_coder_t *coder, uint32_t start, uint32_t size)
+{
+	coder->low += start * coder->range;
+	coder->range *= size;
+
+	while ((coder->low ^ (coder->low + coder->range)) < RANGE_TOP ||
+			(coder->range < RANGE_BOTTOM && ((coder->range = -coder->low & (RANGE_BOTTOM - 1)), true)))
+	{
+		coder->code = (coder->code << 8) | range_next_byte(coder);
+		coder->low <<= 8;
+		coder->range <<= 8;
+	}
+}
+
+/*********************************************************************************
+ * @brief   :  	Decodes characters encoded by range_encode_table
+ *
+ * @param   :   table			- ID of the table the characters were encoded with
+ * 				encoded_buffer	- encoded characters
+ * 				encoded_bytes	- number of bytes in encoded_buffer
+ * 				decoded_bytes	- number of characters to decode
+ * 				decoded_buffer	- buffer to be filled with the decoded characters
+ *
+ * @return  : 	uint16_t		- number of characters decoded, less than
+ * 								  decoded_bytes if the input is corrupt
+**********************************************************************************/
+uint16_t range_decode_table(uint8_t table, const uint8_t encoded_buffer[], size_t encoded_bytes,
+								uint16_t decoded_bytes, uint8_t decoded_buffer[])
+{
+	range_coder_t coder = { 0, UINT32_MAX, 0, NULL, encoded_buffer, encoded_bytes, 0, false };
+	uint16_t dbuf_id = 0;
+
+	if (table >= HUFFMAN_STATIC_TABLES)
+		return 0;
+
+	const uint16_t *cumulative = huffman_range_cumulative[table];
+
+	for (int i = 0; i < 4; i++)
+		coder.code = (coder.code << 8) | range_next_byte(&coder);
+
+	while (dbuf_id < decoded_bytes)
+	{
+		uint32_t frequency = range_decode_frequency(&coder, RANGE_TOTAL_BITS);
+		uint16_t low = 0, high = HUFFMAN_NUM_SYMBOLS;
+
+		if (frequency >= (1UL << RANGE_TOTAL_BITS))
+			break;
+
+		/* Symbol whose frequencies hold the number, a symbol with none is never found */
+		while (high - low > 1)
+		{
+			uint16_t mid = (low + high) / 2;
+			if (cumulative[mid] <= frequency)
+				low = mid;
+			else
+				high = mid;
+		}
+		range_decode_update(&coder, cumulative[low], cumulative[low + 1] - cumulative[low]);
+
+		if (low == HUFFMAN_ESCAPE_SYMBOL)
+		{
+			frequency = range_decode_frequency(&coder, RANGE_RAW_BITS);
+			if (frequency >= (1UL << RANGE_RAW_BITS))
+				break;
+			range_decode_update(&coder, frequency, 1);
+			low = frequency;
+		}
+
+		decoded_buffer[dbuf_id++] = low;
+	}
+
+	return dbuf_id;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file    :   range_code.h
+ * @brief   :   An abstraction for range encoding and decoding functions
+ *
+ *              This header file provides functions which code messages with
+ * 				a 32 bit range coder and the static tables. The range coder
+ * 				spends the exact information of every character, so it gets
+ * 				closest to the entropy of the tables, for a few more cycles
+ * 				per character than huffman. At 9600 baud the link is slower
+ * 				than the coder, so the saved bytes are worth the cycles.
+ *
+ * 				The trainer scales the frequencies of every table so they add
+ * 				up to 2^RANGE_TOTAL_BITS and generates their cumulative sums
+ * 				into lookup_table.h. Encoding a character narrows the range
+ * 				with one shift and two multiplies, which the single cycle
+ * 				multiplier of the KL25Z does cheaply. Decoding needs a divide,
+ * 				which only the PC does. The coder is carryless, a range which
+ * 				gets too small around a byte boundary is cut to the boundary.
+ *
+ * 				A byte with no code in the table is sent as the escape
+ * 				followed by its 8 bits, coded as 256 equal frequencies. A
+ * 				message ends with the fewest bytes which keep the decoder in
+ * 				the final range, the decoder reads 0 past the end.
+ *
+ * @author  :   Sanish Kharade
+ * @date    :   December 10, 2021
+ * @version :   1.0
+ *
+ * @tools   :   gcc, cygwin, Visual Studio Code
+ *
+ * @link    :   Carryless range coder of Dmitry Subbotin (1999)
+*/
+
+#ifndef RANGE_CODE_H_
+#define RANGE_CODE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "huffman_code.h"
+
+/* The frequencies of every table add up to 2^RANGE_TOTAL_BITS, must match lookup_table.h */
+#define RANGE_TOTAL_BITS	(12)
+
+/*********************************************************************************
+ * @brief   :  	Encodes characters with the range coder of a static table
+ *
+ * 				At most HUFFMAN_ENCODED_SIZE(length) bytes are written
+ *
+ * @param   :   table	- ID of the table, below HUFFMAN_STATIC_TABLES
+ * 				data	- characters to encode
+ * 				length	- number of characters in data
+ * 				buffer	- buffer to fill with the encoded characters
+ * 				nbytes	- size of the buffer
+ * 				bits	- set to the number of encoded bits, 8 for every byte
+ *
+ * @return  : 	size_t	- number of bytes written to buffer, 0 if they do not fit
+**********************************************************************************/
+size_t range_encode_table(uint8_t table, const uint8_t *data, size_t length,
+							uint8_t *buffer, size_t nbytes, uint32_t *bits);
+
+/*********************************************************************************
+ * @brief   :  	Decodes characters encoded by range_encode_table
+ *
+ * @param   :   table			- ID of the table the characters were encoded with
+ * 				encoded_buffer	- encoded characters
+ * 				encoded_bytes	- number of bytes in encoded_buffer
+ * 				decoded_bytes	- number of characters to decode
+ * 				decoded_buffer	- buffer to be filled with the decoded characters
+ *
+ * @return  : 	uint16_t		- number of characters decoded, less than
+ * 								  decoded_bytes if the input is corrupt
+**********************************************************************************/
+uint16_t range_decode_table(uint8_t table, const uint8_t encoded_buffer[], size_t encoded_bytes,
+								uint16_t decoded_bytes, uint8_t decoded_buffer[]);
+
+#endif /* RANGE_CODE_H_ */
@@ -18,6 +18,7 @@
 */
 #include<windows.h>
 #include<stdio.h>
+#include<stdlib.h>
 #include<stdint.h>
 #include<stdbool.h>
 #include<string.h>
@@ -25,25 +26,42 @@
 #include<assert.h>
 
 #include "huffman_code.h"
+#include "ans_code.h"
+#include "range_code.h"
+#include "tokens_code.h"
 
-#define baud_rate 9600
+/* Baud rate the KL25Z starts at, the baud command changes it */
+#define BAUD_RATE			(9600)
+
+/* Sent at a new baud rate to check the link, must match commands.h of the KL25Z */
+#define BAUD_CHECK_CHAR		('U')
+
+/* Tries at reading the answer of the KL25Z at the old rate, it waits a second for the check */
+#define BAUD_FALLBACK_TRIES	(4)
+
+/* Most bytes of a frame, with room for messages far longer than the KL25Z sends */
+#define MAX_FRAME_BYTES		(1024)
+
+/* Messages dropped while waiting for the resync frame before the NAK is sent again */
+#define RESYNC_RETRY_FRAMES	(16)
 
 /*********************************************************************************
  * @brief   :  	Sets the baud rate of the opened COM port
  *
- * @param   :   hComm - handle of the COM port
+ * @param   :   hComm	- handle of the COM port
+ * 				rate	- baud rate
  *
- * @return  : 	void
+ * @return  : 	bool - false if the port does not take the rate
 **********************************************************************************/
-void set_baud_rate(HANDLE hComm)
+bool set_baud_rate(HANDLE hComm, DWORD rate)
 {
 	DCB state = {0};
 	state.DCBlength = sizeof(DCB);
-	state.BaudRate = baud_rate;
+	state.BaudRate = rate;
 	state.ByteSize = 8;
 	state.Parity = NOPARITY;
 	state.StopBits = ONESTOPBIT;
-	bool success = SetCommState(hComm, &state);
+	return SetCommState(hComm, &state);
 }
 
 /*********************************************************************************
@@ -61,6 +79,470 @@ void delay_ms(int milliseconds)
     // looping till required time is not achieved
     while (clock() < start_time + milliseconds);
 }
+/*********************************************************************************
+ * @brief   :  	Returns the number of received bytes waiting to be read
+ *
+ * @param   :   hComm - handle of the COM port
+ *
+ * @return  : 	DWORD - number of bytes in the receive queue
+**********************************************************************************/
+DWORD bytes_waiting(HANDLE hComm)
+{
+	COMSTAT status = {0};
+	DWORD errors;
+
+	if(!ClearCommError(hComm, &errors, &status))
+		return 0;
+	return status.cbInQue;
+}
+
+/*********************************************************************************
+ * @brief   :  	Reads a number of bytes, the port may return them in pieces
+ *
+ * @param   :   hComm	- handle of the COM port
+ * 				buffer	- buffer to fill
+ * 				size	- number of bytes to read
+ *
+ * @return  : 	int - number of bytes read, less than size on a timeout
+**********************************************************************************/
+int read_bytes(HANDLE hComm, uint8_t *buffer, int size)
+{
+	int idx = 0;
+	DWORD data;
+
+	while(idx < size)
+	{
+		if(!ReadFile(hComm, buffer + idx, size - idx, &data, NULL) || data == 0)
+			break;
+		idx += data;
+	}
+
+	return idx;
+}
+
+/*********************************************************************************
+ * @brief   :  	Reads the next frame from the KL25Z whose CRC checks
+ *
+ * 				Bytes before the sync bytes are skipped. A frame whose
+ * 				header makes no sense or whose CRC fails is skipped from
+ * 				its first sync byte on, so a frame which starts inside it
+ * 				is still found. The bytes read past the frame are kept for
+ * 				the next call.
+ *
+ * @param   :   hComm		- handle of the COM port
+ * 				type		- filled with the type byte
+ * 				sequence	- filled with the sequence number
+ * 				size		- filled with the original size
+ * 				bits	- filled with the number of encoded bits
+ * 				message	- set to the bytes of the message, valid until the next call
+ *
+ * @return  : 	int - number of bytes of the message, -1 if the port timed out
+**********************************************************************************/
+int read_frame(HANDLE hComm, uint8_t *type, uint8_t *sequence, uint32_t *size, uint32_t *bits,
+				const uint8_t **message)
+{
+	static uint8_t frame[MAX_FRAME_BYTES];
+	static int length = 0;
+	static int returned = 0;
+	int needed = 2;
+	int skipped = 0;
+
+	/* The frame returned last time is not needed any more */
+	memmove(frame, frame + returned, length - returned);
+	length -= returned;
+	returned = 0;
+
+	while(true)
+	{
+		if(length < needed)
+		{
+			length += read_bytes(hComm, frame + length, needed - length);
+			if(length < needed)
+				return -1;
+		}
+
+		int header = huffman_frame_parse(frame, length, type, sequence, size, bits);
+		if(header == 0)
+		{
+			needed = length + 1;
+			continue;
+		}
+
+		if(header > 0)
+		{
+			uint32_t payload = *bits / 8 + (*bits % 8 != 0);
+
+			if(payload <= MAX_FRAME_BYTES - header - HUFFMAN_FRAME_CRC_BYTES)
+			{
+				needed = header + payload + HUFFMAN_FRAME_CRC_BYTES;
+				if(length < needed)
+					continue;
+
+				uint16_t crc = huffman_frame_crc(HUFFMAN_FRAME_CRC_INIT, frame + 2, header + payload - 2);
+				if(frame[header + payload] == (crc >> 8) && frame[header + payload + 1] == (crc & 0xFF))
+				{
+					if(skipped > 0)
+						printf("Skipped %d bytes to find the next message\n", skipped);
+					*message = frame + header;
+					returned = needed;
+					return payload;
+				}
+			}
+		}
+
+		/* Not a frame, look for the sync bytes after its first byte */
+		int next = 1;
+		while(next < length && frame[next] != HUFFMAN_FRAME_SYNC_0)
+			next++;
+		memmove(frame, frame + next, length - next);
+		length -= next;
+		skipped += next;
+		needed = 2;
+	}
+}
+
+/*********************************************************************************
+ * @brief   :  	Tells whether a message is decoded with what the frames before
+ * 				it left behind
+ *
+ * 				Those are the repeats, the stream, the adaptive and LZ
+ * 				messages and the ones coded with the runtime table, and the
+ * 				tables themselves as the resync frame forgets them
+ *
+ * @param   :   type	- type byte of the frame
+ *
+ * @return  : 	bool - true if the message can not be decoded after lost frames
+**********************************************************************************/
+bool frame_needs_state(uint8_t type)
+{
+	if(type == HUFFMAN_FRAME_REPEAT || HUFFMAN_FRAME_KIND(type) == HUFFMAN_FRAME_TABLE ||
+			HUFFMAN_FRAME_IS_STREAM(type))
+		return true;
+	if(HUFFMAN_FRAME_STORED(type))
+		return false;
+	return HUFFMAN_FRAME_KIND(type) == HUFFMAN_FRAME_ADAPTIVE || HUFFMAN_FRAME_KIND(type) == HUFFMAN_FRAME_LZ ||
+			HUFFMAN_FRAME_ID(type) >= HUFFMAN_STATIC_TABLES;
+}
+
+/*********************************************************************************
+ * @brief   :  	Reads and decodes one message from the KL25Z
+ *
+ * 				KL25Z sends every message as a frame, the message type, the
+ * 				original length of the string and the total encoded bits,
+ * 				then the encoded string and its CRC. The frame is read whole
+ * 				and checked before anything is decoded, so a corrupt one
+ * 				never reaches the adaptive tree or the history.
+ * 				A table message carries the code lengths of a table rebuilt
+ * 				by the KL25Z, or built for the block of messages after it,
+ * 				which is imported before the next message.
+ * 				A stored message is the raw bytes of a message of any kind
+ * 				which did not get smaller when it was coded.
+ * 				Every other message goes into the history the repeats of
+ * 				LZ messages point into, except the constant strings the
+ * 				KL25Z encoded at build time. A token message is rendered from
+ * 				format_strings.h once it is decoded.
+ * 				A repeat message is only a header, the message decoded last
+ * 				is printed again as many times as its original length says.
+ * 				A stream message goes on from the bits of the stream message
+ * 				before it, its first characters may end that message.
+ * 				Every frame has the sequence number after the one before.
+ * 				When frames were lost the KL25Z is sent HUFFMAN_LINK_NAK, and
+ * 				the messages which need the lost ones are dropped until the
+ * 				resync frame comes back. Both sides start the adaptive tree,
+ * 				the history, the stream and the runtime table over from it.
+ *
+ * @param   :   hComm			- handle of the COM port
+ * 				model			- adaptive tree of the received messages
+ * 				history			- text of the received messages
+ * 				decoded_buffer	- buffer to be filled with the decoded string
+ * 				nbytes			- size of decoded_buffer
+ *
+ * @return  : 	int - number of decoded characters, 0 for a table message
+**********************************************************************************/
+int read_message(HANDLE hComm, huffman_adaptive_t *model, huffman_lz_t *history,
+					uint8_t *decoded_buffer, int nbytes)
+{
+	static uint8_t last_message[MAX_FRAME_BYTES];
+	static int last_size = 0;
+	static huffman_decoder_t stream;
+	static uint8_t stream_text[MAX_FRAME_BYTES];
+	static int stream_length = 0, stream_size = 0;
+	static int expected = -1;
+	static bool resyncing = false;
+	static int dropped = 0;
+	const uint8_t *message;
+	uint8_t type, sequence;
+	uint32_t original_size, bits;
+	int decoded_size = 0;
+	huffman_decoder_t decoder;
+	DWORD datawritten;
+	uint8_t nak = HUFFMAN_LINK_NAK;
+
+	int reduced_size = read_frame(hComm, &type, &sequence, &original_size, &bits, &message);
+	if(reduced_size < 0)
+		return 0;
+
+	/* The KL25Z has started everything over, nothing before this frame is needed */
+	if(type == HUFFMAN_FRAME_RESYNC)
+	{
+		huffman_adaptive_reset(model);
+		huffman_lz_reset(history);
+		huffman_init();
+		stream.remaining = 0;
+		stream.corrupt = false;
+		stream_length = 0;
+		last_size = 0;
+		resyncing = false;
+		expected = (sequence + 1) & 0xFF;
+		return 0;
+	}
+
+	if(expected >= 0 && sequence != expected && !resyncing)
+	{
+		printf("Lost %d messages, asking the KL25Z to start over\n", (sequence - expected) & 0xFF);
+		WriteFile(hComm, &nak, 1, &datawritten, NULL);
+		resyncing = true;
+		dropped = 0;
+	}
+	expected = (sequence + 1) & 0xFF;
+
+	/* The NAK may have been lost as well, it is sent again now and then */
+	if(resyncing && frame_needs_state(type))
+	{
+		if(++dropped % RESYNC_RETRY_FRAMES == 0)
+			WriteFile(hComm, &nak, 1, &datawritten, NULL);
+		return 0;
+	}
+
+	if(HUFFMAN_FRAME_ID(type) >= HUFFMAN_MAX_TABLES && !HUFFMAN_FRAME_STORED(type))
+	{
+		printf("Unknown table %d received\n", HUFFMAN_FRAME_ID(type));
+		return 0;
+	}
+
+	/* The repeats are not decoded, so they stay out of the history and the adaptive tree */
+	if(type == HUFFMAN_FRAME_REPEAT)
+	{
+		for(uint32_t i = 0; i < original_size && decoded_size + last_size <= nbytes; i++)
+		{
+			memcpy(decoded_buffer + decoded_size, last_message, last_size);
+			decoded_size += last_size;
+		}
+		return decoded_size;
+	}
+
+	if(HUFFMAN_FRAME_KIND(type) == HUFFMAN_FRAME_TABLE)
+	{
+		if(!huffman_import_table(HUFFMAN_FRAME_ID(type), message, reduced_size))
+			printf("Invalid table %d received\n", HUFFMAN_FRAME_ID(type));
+		return 0;
+	}
+
+	/* The table the message was coded with was never received, the one before has another ID */
+	if(!HUFFMAN_FRAME_STORED(type) && !huffman_has_table(HUFFMAN_FRAME_ID(type)))
+	{
+		printf("Table %d was not received, message dropped\n", HUFFMAN_FRAME_ID(type));
+		if(HUFFMAN_FRAME_IS_STREAM(type))
+			stream.corrupt = true;
+		return 0;
+	}
+
+	/*
+	 * A stream message continues the bits of the one before it, so the
+	 * decoder of the stream lives on from frame to frame. The characters
+	 * left over from the last message are decoded first with its table,
+	 * unless the frame has not got all of their bits, then the KL25Z kept
+	 * the table. A stream whose characters were all decoded has ended, the
+	 * bits left are padding. The characters stay out of the history, and
+	 * the message repeats print is only known once the stream ends
+	 */
+	if(HUFFMAN_FRAME_IS_STREAM(type))
+	{
+		int used = 0;
+
+		if(stream.remaining == 0 || stream.corrupt)
+			huffman_decoder_init_table(&stream, 0, HUFFMAN_FRAME_ID(type));
+		else
+		{
+			decoded_size = huffman_decoder_feed(&stream, message, reduced_size, decoded_buffer, nbytes);
+			used = stream.reader.position;
+		}
+
+		if(stream.remaining == 0)
+			huffman_decoder_next_message(&stream, original_size, HUFFMAN_FRAME_ID(type));
+		else
+			stream.remaining += original_size;
+
+		decoded_size += huffman_decoder_feed(&stream, message + used, reduced_size - used,
+												decoded_buffer + decoded_size, nbytes - decoded_size);
+		if(original_size > 0)
+			stream_size = (original_size < sizeof(stream_text)) ? original_size : sizeof(stream_text);
+
+		/* Keep the last characters of the stream, the last message is among them */
+		int room = (int)sizeof(stream_text) - decoded_size;
+		int kept = (stream_length < room) ? stream_length : room;
+		memmove(stream_text, stream_text + stream_length - kept, kept);
+		memcpy(stream_text + kept, decoded_buffer, decoded_size);
+		stream_length = kept + decoded_size;
+
+		if(stream.remaining == 0 && stream_size <= stream_length)
+		{
+			last_size = stream_size;
+			memcpy(last_message, stream_text + stream_length - stream_size, last_size);
+		}
+		return decoded_size;
+	}
+
+	if(type & HUFFMAN_FRAME_RESET)
+	{
+		if(HUFFMAN_FRAME_KIND(type) == HUFFMAN_FRAME_LZ)
+			huffman_lz_reset(history);
+		else
+			huffman_adaptive_reset(model);
+	}
+
+	uint16_t size = (original_size < nbytes) ? original_size : nbytes;
+
+	/* A stored message is its raw bytes, which update the adaptive tree as decoding them would */
+	if(HUFFMAN_FRAME_STORED(type))
+	{
+		decoded_size = (reduced_size < size) ? reduced_size : size;
+		memcpy(decoded_buffer, message, decoded_size);
+		if(HUFFMAN_FRAME_KIND(type) == HUFFMAN_FRAME_ADAPTIVE)
+			huffman_adaptive_add(model, decoded_buffer, decoded_size);
+	}
+	else if(HUFFMAN_FRAME_KIND(type) == HUFFMAN_FRAME_ANS)
+	{
+		decoded_size = ans_decode_table(HUFFMAN_FRAME_ID(type), message, reduced_size, size, decoded_buffer);
+	}
+	else if(HUFFMAN_FRAME_KIND(type) == HUFFMAN_FRAME_RANGE)
+	{
+		decoded_size = range_decode_table(HUFFMAN_FRAME_ID(type), message, reduced_size, size, decoded_buffer);
+	}
+	else
+	{
+		if(HUFFMAN_FRAME_KIND(type) == HUFFMAN_FRAME_ADAPTIVE)
+			huffman_decoder_init_adaptive(&decoder, size, model);
+		else if(HUFFMAN_FRAME_KIND(type) == HUFFMAN_FRAME_LZ)
+			huffman_decoder_init_lz(&decoder, size, HUFFMAN_FRAME_ID(type), history);
+		else if(HUFFMAN_FRAME_KIND(type) == HUFFMAN_FRAME_CONTEXT)
+			huffman_decoder_init_context(&decoder, size);
+		else
+			huffman_decoder_init_table(&decoder, size, HUFFMAN_FRAME_ID(type));
+
+		decoded_size = huffman_decoder_feed(&decoder, message, reduced_size, decoded_buffer, nbytes);
+	}
+
+	/*
+	 * The LZ decoder adds its characters to the history itself, and the
+	 * strings encoded when the firmware was built are kept out of it
+	 */
+	if((HUFFMAN_FRAME_KIND(type) != HUFFMAN_FRAME_LZ || HUFFMAN_FRAME_STORED(type)) &&
+			HUFFMAN_FRAME_KIND(type) != HUFFMAN_FRAME_CONSTANT)
+		huffman_lz_append(history, decoded_buffer, decoded_size);
+
+	if((type & HUFFMAN_FRAME_TOKENS) && decoded_size > 0)
+	{
+		uint8_t tokens[MAX_FRAME_BYTES];
+
+		memcpy(tokens, decoded_buffer, decoded_size);
+		decoded_size = tokens_render(tokens, decoded_size, (char *)decoded_buffer, nbytes);
+		if(decoded_size < 0)
+		{
+			printf("Invalid format string token received\n");
+			return 0;
+		}
+	}
+
+	last_size = (decoded_size < sizeof(last_message)) ? decoded_size : sizeof(last_message);
+	memcpy(last_message, decoded_buffer, last_size);
+
+	/* Uncomment the below lines to print the received sizes */
+	// printf("\nOriginal size of string = %lu bytes\n", (unsigned long)original_size);
+	// printf("Encrypted bits = %lu\n", (unsigned long)bits);
+	// printf("Reduced size of string = %d bytes\n", reduced_size);
+
+	return decoded_size;
+}
+
+/*********************************************************************************
+ * @brief   :  	Reads the messages of a reply until the KL25Z stops sending
+ *
+ * @param   :   hComm			- handle of the COM port
+ * 				model			- adaptive tree of the received messages
+ * 				history			- text of the received messages
+ * 				decoded_buffer	- buffer to be filled with the decoded string
+ * 				nbytes			- size of decoded_buffer
+ *
+ * @return  : 	int - number of decoded characters
+**********************************************************************************/
+int read_reply(HANDLE hComm, huffman_adaptive_t *model, huffman_lz_t *history,
+				uint8_t *decoded_buffer, int nbytes)
+{
+	int decoded_size = 0;
+
+	do
+	{
+		decoded_size += read_message(hComm, model, history, decoded_buffer + decoded_size,
+										nbytes - 1 - decoded_size);
+		delay_ms(20);
+	} while(bytes_waiting(hComm) > 0);
+
+	decoded_buffer[decoded_size] = '\0';
+	return decoded_size;
+}
+
+/*********************************************************************************
+ * @brief   :  	Checks the link at the baud rate the KL25Z switched to
+ *
+ * 				The port switches and sends BAUD_CHECK_CHAR, which the KL25Z
+ * 				answers at the new rate with the rate it makes and the bytes
+ * 				a second the link carries. Without that answer the port goes
+ * 				back to the old rate, as the KL25Z does once it gives up
+ * 				waiting for the check.
+ *
+ * @param   :   hComm		- handle of the COM port
+ * 				model		- adaptive tree of the received messages
+ * 				history		- text of the received messages
+ * 				old_rate	- baud rate before the switch
+ * 				new_rate	- baud rate the KL25Z switched to
+ *
+ * @return  : 	bool - true if the link works at the new rate
+**********************************************************************************/
+bool check_link(HANDLE hComm, huffman_adaptive_t *model, huffman_lz_t *history,
+				DWORD old_rate, DWORD new_rate)
+{
+	uint8_t reply[256];
+	char check = BAUD_CHECK_CHAR;
+	DWORD datawritten;
+
+	/* The answer is only compared up to its first argument */
+	size_t known = strcspn(format_strings[FORMAT_BAUD], "%");
+
+	if(set_baud_rate(hComm, new_rate))
+	{
+		PurgeComm(hComm, PURGE_RXCLEAR);
+		WriteFile(hComm, &check, 1, &datawritten, NULL);
+
+		read_reply(hComm, model, history, reply, sizeof(reply));
+		if(strncmp((char *)reply, format_strings[FORMAT_BAUD], known) == 0)
+		{
+			printf("%s\n", reply);
+			return true;
+		}
+	}
+
+	set_baud_rate(hComm, old_rate);
+	PurgeComm(hComm, PURGE_RXCLEAR);
+	for(int tries = 0; tries < BAUD_FALLBACK_TRIES; tries++)
+	{
+		if(read_reply(hComm, model, history, reply, sizeof(reply)) > 0)
+			break;
+	}
+	printf("%s\n", reply);
+	return false;
+}
+
 /*********************************************************************************
  * @brief   :  	Main entry point to the application
  * 
@@ -93,31 +575,47 @@ int main()
 	else
 		printf("Opening serial port successful!\n\n");
 
-	set_baud_rate(hComm);
+	DWORD baud_rate = BAUD_RATE;
+	set_baud_rate(hComm, baud_rate);
 
-	DWORD data, datawritten;
+	/*
+	 * Reads give up after a while, so a frame cut short by a lost byte
+	 * does not hang the PC, the next frame is found after it
+	 */
+	COMMTIMEOUTS timeouts = {0};
+	timeouts.ReadTotalTimeoutMultiplier = 2;
+	timeouts.ReadTotalTimeoutConstant = 500;
+	SetCommTimeouts(hComm, &timeouts);
 
-	uint8_t TempChar;
+	/* Build the huffman decode tables */
+	huffman_init();
 
-	uint8_t rcvd_buffer[200]={0};
-	uint8_t rcvd_buf_idx = 0;
-	uint8_t decoded_buffer[200]={0};
-	int enc = 0;
-	int original_size = 0;
-	int reduced_size = 0;
-	float percent_reduction = 0;
+	DWORD datawritten;
+
+	uint8_t decoded_buffer[1024]={0};
+	static huffman_adaptive_t rx_model;
+	static huffman_lz_t rx_history;
+
+	huffman_adaptive_reset(&rx_model);
+	huffman_lz_reset(&rx_history);
+
+	/*
+	 * The KL25Z may still hold an adaptive tree, a history, a stream and a
+	 * runtime table from an earlier run. The NAK has it start all of them
+	 * over as after lost frames, and the resync frame it answers with sets
+	 * the sequence number the next frames are checked against
+	 */
+	uint8_t nak = HUFFMAN_LINK_NAK;
+	PurgeComm(hComm, PURGE_RXCLEAR);
+	Status = WriteFile(hComm, &nak, 1, &datawritten, NULL);
+	read_reply(hComm, &rx_model, &rx_history, decoded_buffer, sizeof(decoded_buffer));
+	memset(decoded_buffer, 0, sizeof(decoded_buffer));
 
 	while(1)
 	{
-		/* Set all variables and buffers to 0 */
-		rcvd_buf_idx = 0;
-		enc = 0;
-		original_size = 0;
-		reduced_size = 0;
-
+		/* Set all buffers to 0 */
 		memset(str, 0, sizeof(str));
 		memset(decoded_buffer, 0, sizeof(decoded_buffer));
-		memset(rcvd_buffer, 0, sizeof(rcvd_buffer));
 
 		printf("Enter command or string to encode\n");
 		gets(str);
@@ -136,58 +634,34 @@ int main()
 			delay_ms(10);
 		}
 
-		/*	
-		 * 	KL25Z first sends the original length of string
-		 *	Then it sends the total encoded bits
-		 *	Then it sends the reduced length of the encoded string
-		 *	Read all these one at a time
-		*/
-
-		/* Read the original size of the string */
-		delay_ms(10);
-		Status = ReadFile(hComm, &TempChar, sizeof(TempChar), &data, NULL);
-		original_size = TempChar;
-
-		/* Read the number of encoded bits */
-		delay_ms(10);
-		Status = ReadFile(hComm, &TempChar, sizeof(TempChar), &data, NULL);
-		enc = TempChar;
-
-		/* Read the reduced size of the string */
-		delay_ms(10);
-		Status = ReadFile(hComm, &TempChar, sizeof(TempChar), &data, NULL);
-		reduced_size = TempChar;
+		/*
+		 * Long replies come as several messages, read them until
+		 * the KL25Z stops sending
+		 */
+		printf("Decoded String - \n");
+		read_reply(hComm, &rx_model, &rx_history, decoded_buffer, sizeof(decoded_buffer));
+		printf("%s\n", decoded_buffer);
 
-		/* Read the encoded buffer */
-		for(int j=0;j<reduced_size;j++)
+		/* The KL25Z switched once it acknowledged the baud command, follow it */
+		if(strncmp(str, "baud ", 5) == 0)
 		{
-			Status = ReadFile(hComm, &TempChar, sizeof(TempChar), &data, NULL);
-			rcvd_buffer[rcvd_buf_idx++] = TempChar;
-		}
+			char acknowledgement[64];
+			unsigned long rate = strtoul(str + 5, NULL, 10);
 
-		/* Uncomment the below lines to print the received sizes */
-		// printf("\nOriginal size of string = %d bytes\n", original_size);
-		// printf("Encrypted bits = %d\n", enc);
-		// printf("Reduced size of string = %d bytes\n", reduced_size);
-
-		//  Calculate the percent reduction and print it 
-		// percent_reduction = (float)((original_size - reduced_size) * 100) / original_size;
-		// printf("Percentage reduced_size is %f\n", percent_reduction);
-
-		/* Uncomment below for loop for printing the encoded bytes for debugging */
-		// for(int p = 0; p< rcvd_buf_idx; p++)
-		// {
-		// 	printf("buffer[%d] = %02X\n", p, rcvd_buffer[p]);
-		// }
-
-		/* Decode the data and print it */
-		printf("Decoded String - \n");
-		huffman_decode(rcvd_buffer, original_size, decoded_buffer);
+			snprintf(acknowledgement, sizeof(acknowledgement), format_strings[FORMAT_BAUD_SWITCH], rate);
+			if(strcmp((char *)decoded_buffer, acknowledgement) == 0 &&
+				check_link(hComm, &rx_model, &rx_history, baud_rate, rate))
+			{
+				baud_rate = rate;
+			}
+		}
 
 		str[strlen(str) -1] = '\0';
-		if((strncmp(str, "author", 6) && strncmp(str, "help", 4) && strncmp(str, "stats", 5) && strncmp(str, "reset", 5) ))
+		if((strncmp(str, "author", 6) && strncmp(str, "help", 4) && strncmp(str, "stats", 5) && strncmp(str, "reset", 5) &&
+			strncmp(str, "mode", 4) && strncmp(str, "bench", 5) && strncmp(str, "batch", 5) &&
+			strncmp(str, "baud", 4) ))
 		{
-			assert(strncmp(str, decoded_buffer, original_size) == 0);
+			assert(strncmp(str, decoded_buffer, strlen(str)) == 0);
 			printf("Strings matched\n\n");
 		}	
 			
@@ -201,4 +675,4 @@ int main()
 		return 0;
 }
 
-//gcc serial_port.c huffman_code.c -o serial.exe
\ No newline at end of file
+//gcc serial_port.c huffman_code.c ans_code.c range_code.c tokens_code.c -o serial.exe
\ No newline at end of file
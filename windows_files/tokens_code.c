@@ -0,0 +1,316 @@
+/**
+ * @file    :   tokens_code.c
+ * @brief   :   An abstraction for printing with format string tokens
+ *
+ *              This source file provides functions which pack a format
+ * 				string ID and its arguments, and render the text from them
+ *
+ * @author  :   Sanish Kharade
+ * @date    :   December 10, 2021
+ * @version :   1.0
+ *
+ * @tools   :   gcc, cygwin, Visual Studio Code
+ *
+ * @link    :   -
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include "tokens_code.h"
+
+/* Longest conversion with its flags, width and precision */
+#define TOKENS_SPEC_SIZE		(16)
+
+/* Longest string argument which can be rendered */
+#define TOKENS_STRING_SIZE		(256)
+
+#define FORMAT_TEXT(name, format)	format,
+
+const char *const format_strings[FORMAT_COUNT] =
+{
+	FORMAT_STRINGS(FORMAT_TEXT)
+};
+
+#undef FORMAT_TEXT
+
+/*********************************************************************************
+ * @brief   :  	Skips the flags, width, precision and length of a conversion
+ *
+ * @param   :   p			- first character after the %
+ * 				is_long		- set if the conversion has the l length
+ *
+ * @return  : 	const char *	- the conversion character
+**********************************************************************************/
+static const char *skip_conversion(const char *p, bool *is_long)
+{
+	while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0')
+		p++;
+	while (*p >= '0' && *p <= '9')
+		p++;
+	if (*p == '.')
+	{
+		p++;
+		while (*p >= '0' && *p <= '9')
+			p++;
+	}
+
+	*is_long = false;
+	while (*p == 'h' || *p == 'l')
+	{
+		if (*p == 'l')
+			*is_long = true;
+		p++;
+	}
+
+	return p;
+}
+
+/*********************************************************************************
+ * @brief   :  	Writes a varint
+ *
+ * @param   :   buffer	- buffer to fill
+ * 				nbytes	- size of the buffer
+ * 				idx		- index of the next byte of buffer
+ * 				value	- number to write
+ *
+ * @return  : 	size_t	- index of the next byte of buffer, 0 if it does not fit
+**********************************************************************************/
+static size_t put_varint(uint8_t *buffer, size_t nbytes, size_t idx, uint32_t value)
+{
+	do
+	{
+		if (idx >= nbytes)
+			return 0;
+
+		buffer[idx++] = (value & 0x7F) | ((value > 0x7F) ? 0x80 : 0);
+		value >>= 7;
+	} while (value > 0);
+
+	return idx;
+}
+
+/*********************************************************************************
+ * @brief   :  	Reads a varint
+ *
+ * @param   :   data	- packed bytes
+ * 				length	- number of bytes in data
+ * 				idx		- index of the next byte of data, moved past the varint
+ * 				value	- set to the number
+ *
+ * @return  : 	bool	- false if the varint runs past the end or is too long
+**********************************************************************************/
+static bool get_varint(const uint8_t *data, size_t length, size_t *idx, uint32_t *value)
+{
+	*value = 0;
+
+	for (int i = 0; i < TOKENS_VARINT_BYTES; i++)
+	{
+		if (*idx >= length)
+			return false;
+
+		uint8_t byte = data[(*idx)++];
+
+		*value |= (uint32_t)(byte & 0x7F) << (7 * i);
+		if (!(byte & 0x80))
+			return true;
+	}
+
+	return false;
+}
+
+/*********************************************************************************
+ * @brief   :  	Packs the ID of a format string and its arguments
+ *
+ * 				The format string is only walked to find the type of each
+ * 				argument, nothing is formatted
+ *
+ * @param   :   buffer	- buffer to fill with the packed bytes
+ * 				nbytes	- size of the buffer
+ * 				format	- ID of the format string
+ * 				args	- arguments of the format string
+ *
+ * @return  : 	size_t	- number of bytes written to buffer, 0 if they do not
+ * 						  fit or the format string has a conversion which
+ * 						  cannot be packed
+**********************************************************************************/
+size_t tokens_pack(uint8_t *buffer, size_t nbytes, format_id_t format, va_list args)
+{
+	size_t idx;
+
+	if (format >= FORMAT_COUNT)
+		return 0;
+
+	idx = put_varint(buffer, nbytes, 0, format);
+
+	for (const char *p = format_strings[format]; *p != '\0' && idx > 0; p++)
+	{
+		bool is_long;
+
+		if (*p != '%')
+			continue;
+
+		p = skip_conversion(p + 1, &is_long);
+		switch (*p)
+		{
+		case 'd':
+		case 'i':
+		{
+			int32_t value = is_long ? va_arg(args, long) : va_arg(args, int);
+
+			/* Zigzag, 0, -1, 1, -2 ... become 0, 1, 2, 3 ... */
+			idx = put_varint(buffer, nbytes, idx, ((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+			break;
+		}
+
+		case 'u':
+		case 'x':
+		case 'X':
+		case 'o':
+			idx = put_varint(buffer, nbytes, idx, is_long ? va_arg(args, unsigned long) : va_arg(args, unsigned int));
+			break;
+
+		case 'c':
+			idx = put_varint(buffer, nbytes, idx, (uint8_t)va_arg(args, int));
+			break;
+
+		case 's':
+		{
+			const char *string = va_arg(args, const char *);
+			size_t length = strlen(string);
+
+			idx = put_varint(buffer, nbytes, idx, length);
+			if (idx == 0 || length > nbytes - idx)
+				return 0;
+			memcpy(buffer + idx, string, length);
+			idx += length;
+			break;
+		}
+
+		case '%':
+			break;
+
+		default:
+			return 0;
+		}
+	}
+
+	return idx;
+}
+
+/*********************************************************************************
+ * @brief   :  	Renders the text of a format string packed by tokens_pack
+ *
+ * 				Each conversion is formatted on its own with its flags, width
+ * 				and precision, numbers with the l length
+ *
+ * @param   :   data	- packed bytes
+ * 				length	- number of bytes in data
+ * 				text	- buffer to fill with the text, terminated by a '\0'
+ * 				nbytes	- size of the buffer
+ *
+ * @return  : 	int		- number of characters of the text, -1 if the packed
+ * 						  bytes are corrupt or the text does not fit
+**********************************************************************************/
+int tokens_render(const uint8_t *data, size_t length, char *text, size_t nbytes)
+{
+	size_t idx = 0, out = 0;
+	uint32_t id, value;
+
+	if (nbytes == 0 || !get_varint(data, length, &idx, &id) || id >= FORMAT_COUNT)
+		return -1;
+
+	for (const char *p = format_strings[id]; *p != '\0'; p++)
+	{
+		char spec[TOKENS_SPEC_SIZE];
+		size_t spec_len = 0;
+		bool is_long;
+		int n;
+
+		if (*p != '%')
+		{
+			if (out + 1 >= nbytes)
+				return -1;
+			text[out++] = *p;
+			continue;
+		}
+
+		/* Copy the conversion without its length */
+		const char *conversion = skip_conversion(p + 1, &is_long);
+
+		for (; p < conversion; p++)
+		{
+			if (*p != 'h' && *p != 'l' && spec_len < TOKENS_SPEC_SIZE - 3)
+				spec[spec_len++] = *p;
+		}
+
+		switch (*conversion)
+		{
+		case 'd':
+		case 'i':
+			if (!get_varint(data, length, &idx, &value))
+				return -1;
+			spec[spec_len++] = 'l';
+			spec[spec_len++] = *conversion;
+			spec[spec_len] = '\0';
+			n = snprintf(text + out, nbytes - out, spec, (long)((int32_t)(value >> 1) ^ -(int32_t)(value & 1)));
+			break;
+
+		case 'u':
+		case 'x':
+		case 'X':
+		case 'o':
+			if (!get_varint(data, length, &idx, &value))
+				return -1;
+			spec[spec_len++] = 'l';
+			spec[spec_len++] = *conversion;
+			spec[spec_len] = '\0';
+			n = snprintf(text + out, nbytes - out, spec, (unsigned long)value);
+			break;
+
+		case 'c':
+			if (!get_varint(data, length, &idx, &value))
+				return -1;
+			spec[spec_len++] = 'c';
+			spec[spec_len] = '\0';
+			n = snprintf(text + out, nbytes - out, spec, (int)value);
+			break;
+
+		case 's':
+		{
+			/* The string is not terminated in the packed bytes */
+			char string[TOKENS_STRING_SIZE];
+
+			if (!get_varint(data, length, &idx, &value) || value > length - idx || value >= sizeof(string))
+				return -1;
+			memcpy(string, data + idx, value);
+			string[value] = '\0';
+			idx += value;
+
+			spec[spec_len++] = 's';
+			spec[spec_len] = '\0';
+			n = snprintf(text + out, nbytes - out, spec, string);
+			break;
+		}
+
+		case '%':
+			n = snprintf(text + out, nbytes - out, "%%");
+			break;
+
+		default:
+			return -1;
+		}
+
+		if (n < 0 || (size_t)n >= nbytes - out)
+			return -1;
+		out += n;
+		p = conversion;
+	}
+
+	/* Every packed byte belongs to an argument */
+	if (idx != length)
+		return -1;
+
+	text[out] = '\0';
+	return out;
+}